@@ -0,0 +1,206 @@
+/*
+ * @file containers and counters shared by benchmarks of container_stream_io.hh
+ *   and of the original container_printer.h, generated once from fixed seeds
+ *   so that both are measured with the same data
+ */
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>      // size_t
+#include <cstdint>      // int64_t
+#include <map>
+#include <random>       // mt19937, uniform_int_distribution, uniform_real_distribution
+#include <string>
+#include <tuple>
+#include <utility>      // move
+#include <vector>
+
+namespace benchmark_data {
+
+constexpr std::size_t sequence_size { 100000 };
+constexpr std::size_t map_key_count { 1000 };
+constexpr std::size_t map_value_size { 100 };
+constexpr std::size_t tuple_count { 20000 };
+
+using nested_tuple = std::tuple<
+    int, std::tuple<
+        double, std::tuple<
+            std::string, std::tuple<
+                int, std::tuple<
+                    double, std::tuple<int, int>>>>>>;
+
+// leaf values per nested_tuple
+constexpr std::size_t nested_tuple_size { 7 };
+
+// leaf values of string_int_vector_map, keys included
+constexpr std::size_t map_element_count {
+    map_key_count * (1 + map_value_size) };
+
+// scratch file for fstream benchmarks, in the working directory
+const char* const file_path { "container_stream_io_benchmark.tmp" };
+
+/**
+ * @brief sets the bytes and elements (leaf values) processed per iteration,
+ *   which the benchmark library reports as rates per second
+ */
+inline void set_throughput(benchmark::State& state, const std::size_t bytes,
+                           const std::size_t element_count)
+{
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(state.iterations() * bytes));
+    state.SetItemsProcessed(
+        static_cast<std::int64_t>(state.iterations() * element_count));
+}
+
+namespace detail {
+
+/**
+ * @brief mostly printable ASCII, with roughly one char in sixteen being one
+ *   that literal encoding escapes (tab, newline, quote, backslash) and, for
+ *   wider chars, one in eight outside of ASCII
+ */
+template <typename StringType>
+StringType random_string(std::mt19937& engine)
+{
+    using CharType = typename StringType::value_type;
+    static const char escaped[] { '\t', '\n', '"', '\\' };
+    static const char32_t non_ascii[] { 0xe9, 0x3bb, 0x4e2d, 0x1f600 };
+    std::uniform_int_distribution<std::size_t> length_dist { 8, 40 };
+    std::uniform_int_distribution<int> printable_dist { 0x20, 0x7e };
+    std::uniform_int_distribution<int> choice_dist { 0, 15 };
+
+    StringType s (length_dist(engine), CharType {});
+    for (CharType& c : s)
+    {
+        const int choice { choice_dist(engine) };
+        if (choice == 0)
+            c = CharType(escaped[printable_dist(engine) % 4]);
+        else if (choice < 3 && sizeof(CharType) > 1)
+        {
+            const char32_t cp { non_ascii[printable_dist(engine) % 4] };
+            // code points past the BMP would need surrogates in UTF-16
+            c = CharType(sizeof(CharType) == 2 && cp > 0xffff ? 0x4e2d : cp);
+        }
+        else
+            c = CharType(printable_dist(engine));
+    }
+    return s;
+}
+
+template <typename StringType>
+std::vector<StringType> random_strings(const unsigned seed)
+{
+    std::mt19937 engine { seed };
+    std::vector<StringType> v;
+    v.reserve(sequence_size);
+    for (std::size_t i { 0 }; i < sequence_size; ++i)
+        v.emplace_back(random_string<StringType>(engine));
+    return v;
+}
+
+}  // namespace detail
+
+inline const std::vector<int>& ints()
+{
+    static const std::vector<int> v { []() {
+        std::mt19937 engine { 1 };
+        std::uniform_int_distribution<int> dist;
+        std::vector<int> v;
+        v.reserve(sequence_size);
+        for (std::size_t i { 0 }; i < sequence_size; ++i)
+            v.push_back(dist(engine) - dist(engine));
+        return v;
+    }() };
+    return v;
+}
+
+inline const std::vector<double>& doubles()
+{
+    static const std::vector<double> v { []() {
+        std::mt19937 engine { 2 };
+        std::uniform_real_distribution<double> dist { -1e6, 1e6 };
+        std::vector<double> v;
+        v.reserve(sequence_size);
+        for (std::size_t i { 0 }; i < sequence_size; ++i)
+            v.push_back(dist(engine));
+        return v;
+    }() };
+    return v;
+}
+
+inline const std::vector<std::string>& strings()
+{
+    static const std::vector<std::string> v {
+        detail::random_strings<std::string>(3) };
+    return v;
+}
+
+inline const std::vector<std::wstring>& wide_strings()
+{
+    static const std::vector<std::wstring> v {
+        detail::random_strings<std::wstring>(4) };
+    return v;
+}
+
+inline const std::vector<std::u32string>& utf32_strings()
+{
+    static const std::vector<std::u32string> v {
+        detail::random_strings<std::u32string>(5) };
+    return v;
+}
+
+inline const std::map<std::string, std::vector<int>>& string_int_vector_map()
+{
+    static const std::map<std::string, std::vector<int>> m { []() {
+        std::mt19937 engine { 6 };
+        std::uniform_int_distribution<int> dist { -100000, 100000 };
+        std::map<std::string, std::vector<int>> m;
+        while (m.size() < map_key_count)
+        {
+            std::vector<int> v;
+            v.reserve(map_value_size);
+            for (std::size_t i { 0 }; i < map_value_size; ++i)
+                v.push_back(dist(engine));
+            m.emplace(detail::random_string<std::string>(engine), std::move(v));
+        }
+        return m;
+    }() };
+    return m;
+}
+
+inline const std::vector<nested_tuple>& nested_tuples()
+{
+    static const std::vector<nested_tuple> v { []() {
+        std::mt19937 engine { 7 };
+        std::uniform_int_distribution<int> int_dist { -1000, 1000 };
+        std::uniform_real_distribution<double> real_dist { -1.0, 1.0 };
+        std::vector<nested_tuple> v;
+        v.reserve(tuple_count);
+        for (std::size_t i { 0 }; i < tuple_count; ++i)
+        {
+            const int a { int_dist(engine) };
+            const double b { real_dist(engine) };
+            std::string c { detail::random_string<std::string>(engine) };
+            const int d { int_dist(engine) };
+            const double e { real_dist(engine) };
+            const int f { int_dist(engine) };
+            const int g { int_dist(engine) };
+            v.emplace_back(a, std::make_tuple(b, std::make_tuple(std::move(c),
+                std::make_tuple(d, std::make_tuple(e, std::make_tuple(f, g))))));
+        }
+        return v;
+    }() };
+    return v;
+}
+
+}  // namespace benchmark_data
+
+// defined in container_stream_io_benchmarks.cpp
+void register_container_stream_io_benchmarks();
+
+// defined in container_printer_benchmarks.cpp, as container_printer.h and
+//   container_stream_io.hh both declare a global operator<< for containers,
+//   and so can't be included in the same translation unit
+void register_container_printer_benchmarks();
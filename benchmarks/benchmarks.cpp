@@ -0,0 +1,25 @@
+/*
+ * @file benchmarks of container_stream_io.hh, compared with the original
+ *   ContainerPrinter where it supports the same output, using Google Benchmark
+ *
+ * Each benchmark reports throughput as bytes of serialization (bytes_per_second)
+ * and elements, counted as leaf values, (items_per_second) processed per
+ * second. Benchmarks are named <library>/<output|input>/<stream>/<container>
+ * [/<string encoding>], so eg `--benchmark_filter=/vector<string>/` compares
+ * one container across both libraries.
+ */
+
+#include "benchmark_data.hh"
+
+int main(int argc, char** argv)
+{
+    register_container_stream_io_benchmarks();
+    register_container_printer_benchmarks();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * @file benchmarks of output with the original ContainerPrinter, vendored as
+ *   TimSevereijns_ContainerPrinter/source/container_printer.h, for comparison
+ *   with container_stream_io.hh
+ * @notes
+ *   - ContainerPrinter only prints, and its strings are printed as is, with
+ *       no delimiters or escapes
+ *   - its tuple_handler and default_formatter insert elements with the global
+ *       operator<< declared after them, which is only found at instantiation
+ *       by argument dependent lookup, and so nested containers are printed
+ *       with streams derived from the standard ones in the global namespace
+ *       (same streambufs, so costs are comparable)
+ */
+
+#include "benchmark_data.hh"
+
+#include <limits>       // numeric_limits (used but not included by container_printer.h)
+
+#include "container_printer.h"
+
+#include <cstddef>      // size_t
+#include <cstdio>       // remove
+#include <fstream>
+#include <functional>   // cref
+#include <sstream>
+#include <string>
+
+class printer_ostringstream : public std::ostringstream
+{};
+
+class printer_ofstream : public std::ofstream
+{
+public:
+    using std::ofstream::ofstream;
+};
+
+namespace
+{
+
+template <typename ContainerType>
+std::size_t serialized_size(const ContainerType& container)
+{
+    printer_ostringstream oss;
+    oss << container;
+    return oss.str().size();
+}
+
+template <typename ContainerType>
+void to_stringstream(benchmark::State& state, const ContainerType& container,
+                     const std::size_t element_count)
+{
+    const std::size_t size { serialized_size(container) };
+    printer_ostringstream oss;
+    for (auto _ : state)
+    {
+        // overwrites the previous serialization, reusing its storage
+        oss.seekp(0);
+        oss << container;
+    }
+    if (oss.fail())
+        state.SkipWithError("printing failed");
+    benchmark_data::set_throughput(state, size, element_count);
+}
+
+template <typename ContainerType>
+void to_fstream(benchmark::State& state, const ContainerType& container,
+                const std::size_t element_count)
+{
+    const std::size_t size { serialized_size(container) };
+    {
+        printer_ofstream ofs { benchmark_data::file_path };
+        for (auto _ : state)
+        {
+            ofs.seekp(0);
+            ofs << container;
+            ofs.flush();
+        }
+        if (ofs.fail())
+            state.SkipWithError("printing failed");
+    }
+    std::remove(benchmark_data::file_path);
+    benchmark_data::set_throughput(state, size, element_count);
+}
+
+/**
+ * @brief registers output of container through each stream type, named eg
+ *   "container_printer/output/stringstream/vector<string>"
+ * @notes container is referenced rather than copied by each benchmark
+ */
+template <typename ContainerType>
+void register_container(const std::string& container_name,
+                        const ContainerType& container,
+                        const std::size_t element_count)
+{
+    benchmark::RegisterBenchmark(
+        ("container_printer/output/stringstream/" + container_name).c_str(),
+        to_stringstream<ContainerType>, std::cref(container), element_count);
+    benchmark::RegisterBenchmark(
+        ("container_printer/output/fstream/" + container_name).c_str(),
+        to_fstream<ContainerType>, std::cref(container), element_count);
+}
+
+}  // namespace
+
+void register_container_printer_benchmarks()
+{
+    using namespace benchmark_data;
+
+    register_container("vector<int>", ints(), sequence_size);
+    register_container("vector<double>", doubles(), sequence_size);
+    register_container("vector<string>", strings(), sequence_size);
+    register_container("map<string,vector<int>>", string_int_vector_map(),
+                       map_element_count);
+    register_container("vector<nested_tuple>", nested_tuples(),
+                       tuple_count * nested_tuple_size);
+}
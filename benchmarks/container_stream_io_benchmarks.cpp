@@ -0,0 +1,192 @@
+/*
+ * @file benchmarks of container_stream_io.hh output and input, through
+ *   string and file streams
+ */
+
+#include "benchmark_data.hh"
+
+#include "container_stream_io.hh"
+
+#include <cstddef>      // size_t
+#include <cstdio>       // remove
+#include <fstream>
+#include <functional>   // cref
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+enum class string_repr { literal, quoted, utf8 };
+
+const char* repr_name(const string_repr repr)
+{
+    switch (repr)
+    {
+    case string_repr::quoted:
+        return "quoted";
+    case string_repr::utf8:
+        return "utf8";
+    default:
+        return "literal";
+    }
+}
+
+void set_repr(std::basic_ios<char>& ios, const string_repr repr)
+{
+    switch (repr)
+    {
+    case string_repr::quoted:
+        container_stream_io::strings::quotedrepr(ios);
+        break;
+    case string_repr::utf8:
+        container_stream_io::strings::utf8repr(ios);
+        break;
+    default:
+        container_stream_io::strings::literalrepr(ios);
+        break;
+    }
+}
+
+template <typename ContainerType>
+std::string serialize(const ContainerType& container, const string_repr repr)
+{
+    std::ostringstream oss;
+    set_repr(oss, repr);
+    oss << container;
+    return oss.str();
+}
+
+template <typename ContainerType>
+void to_stringstream(benchmark::State& state, const ContainerType& container,
+                     const std::size_t element_count, const string_repr repr)
+{
+    const std::size_t size { serialize(container, repr).size() };
+    std::ostringstream oss;
+    set_repr(oss, repr);
+    for (auto _ : state)
+    {
+        // overwrites the previous serialization, reusing its storage
+        oss.seekp(0);
+        oss << container;
+    }
+    if (oss.fail())
+        state.SkipWithError("printing failed");
+    benchmark_data::set_throughput(state, size, element_count);
+}
+
+template <typename ContainerType>
+void to_fstream(benchmark::State& state, const ContainerType& container,
+                const std::size_t element_count, const string_repr repr)
+{
+    const std::size_t size { serialize(container, repr).size() };
+    {
+        std::ofstream ofs { benchmark_data::file_path };
+        set_repr(ofs, repr);
+        for (auto _ : state)
+        {
+            ofs.seekp(0);
+            ofs << container;
+            ofs.flush();
+        }
+        if (ofs.fail())
+            state.SkipWithError("printing failed");
+    }
+    std::remove(benchmark_data::file_path);
+    benchmark_data::set_throughput(state, size, element_count);
+}
+
+template <typename ContainerType>
+void from_stringstream(benchmark::State& state, const ContainerType& container,
+                       const std::size_t element_count, const string_repr repr)
+{
+    std::istringstream iss { serialize(container, repr) };
+    const std::size_t size { iss.str().size() };
+    set_repr(iss, repr);
+    ContainerType parsed;
+    for (auto _ : state)
+    {
+        iss.clear();
+        iss.seekg(0);
+        iss >> parsed;
+        benchmark::DoNotOptimize(parsed);
+    }
+    // reprinted rather than compared, as doubles are printed with the
+    //   stream's default precision
+    if (iss.fail() || serialize(parsed, repr) != iss.str())
+        state.SkipWithError("parsing failed");
+    benchmark_data::set_throughput(state, size, element_count);
+}
+
+template <typename ContainerType>
+void from_fstream(benchmark::State& state, const ContainerType& container,
+                  const std::size_t element_count, const string_repr repr)
+{
+    const std::string serialization { serialize(container, repr) };
+    std::ofstream { benchmark_data::file_path } << serialization;
+    {
+        std::ifstream ifs { benchmark_data::file_path };
+        set_repr(ifs, repr);
+        ContainerType parsed;
+        for (auto _ : state)
+        {
+            ifs.clear();
+            ifs.seekg(0);
+            ifs >> parsed;
+            benchmark::DoNotOptimize(parsed);
+        }
+        if (ifs.fail() || serialize(parsed, repr) != serialization)
+            state.SkipWithError("parsing failed");
+    }
+    std::remove(benchmark_data::file_path);
+    benchmark_data::set_throughput(state, serialization.size(), element_count);
+}
+
+/**
+ * @brief registers output and input of container through each stream type,
+ *   named eg "container_stream_io/output/stringstream/vector<string>/quoted"
+ * @notes container is referenced rather than copied by each benchmark
+ */
+template <typename ContainerType>
+void register_container(const std::string& container_name,
+                        const ContainerType& container,
+                        const std::size_t element_count,
+                        const string_repr repr = string_repr::literal)
+{
+    const std::string suffix { container_name + '/' + repr_name(repr) };
+    benchmark::RegisterBenchmark(
+        ("container_stream_io/output/stringstream/" + suffix).c_str(),
+        to_stringstream<ContainerType>, std::cref(container), element_count, repr);
+    benchmark::RegisterBenchmark(
+        ("container_stream_io/output/fstream/" + suffix).c_str(),
+        to_fstream<ContainerType>, std::cref(container), element_count, repr);
+    benchmark::RegisterBenchmark(
+        ("container_stream_io/input/stringstream/" + suffix).c_str(),
+        from_stringstream<ContainerType>, std::cref(container), element_count, repr);
+    benchmark::RegisterBenchmark(
+        ("container_stream_io/input/fstream/" + suffix).c_str(),
+        from_fstream<ContainerType>, std::cref(container), element_count, repr);
+}
+
+}  // namespace
+
+void register_container_stream_io_benchmarks()
+{
+    using namespace benchmark_data;
+
+    register_container("vector<int>", ints(), sequence_size);
+    register_container("vector<double>", doubles(), sequence_size);
+    register_container("vector<string>", strings(), sequence_size);
+    register_container("vector<string>", strings(), sequence_size,
+                       string_repr::quoted);
+    register_container("map<string,vector<int>>", string_int_vector_map(),
+                       map_element_count);
+    register_container("vector<nested_tuple>", nested_tuples(),
+                       tuple_count * nested_tuple_size);
+    register_container("vector<wstring>", wide_strings(), sequence_size);
+    register_container("vector<wstring>", wide_strings(), sequence_size,
+                       string_repr::utf8);
+    register_container("vector<u32string>", utf32_strings(), sequence_size);
+    register_container("vector<u32string>", utf32_strings(), sequence_size,
+                       string_repr::utf8);
+}
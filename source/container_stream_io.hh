@@ -4,21 +4,119 @@
 #include <algorithm>    // copy find_if for_each (limits:numeric_limits)
 #include <cstddef>      // size_t
 #include <iostream>
+#include <fstream>      // ifstream, ofstream
+#include <limits>       // numeric_limits
+#include <locale>       // ctype, use_facet
 #include <sstream>      // basic_ostringstream
 #include <set>
-#include <map>
 #include <string>
 #include <tuple>
 #include <forward_list>
 #include <utility>
+#include <vector>
+#include <array>
+#include <cstring>      // memcpy
+#include <thread>
+#include <exception>    // exception_ptr
+#include <atomic>
+#include <deque>
+#include <stack>
+#include <queue>        // queue, priority_queue
+#include <memory>       // unique_ptr
+#include <system_error>
+#include <mutex>        // lock_guard
+#include <condition_variable>
 #include <iomanip>      // setfill, setw
 #include <iterator>     // begin, end
 #include <type_traits>  // true_type, false_type
+#include <chrono>       // steady_clock
+#include <functional>   // function
 
 #if (__cplusplus < 201103L)
 #error "container_stream_io only supports C++11 and above"
 #endif  // pre-C++11
 
+// vectorized string scanning, see strings::detail::simd
+#ifndef CONTAINER_STREAM_IO_NO_SIMD
+#  if defined(__AVX2__)
+#    include <immintrin.h>
+#    define CONTAINER_STREAM_IO_AVX2
+#  endif
+#  if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define CONTAINER_STREAM_IO_SSE2
+#  elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define CONTAINER_STREAM_IO_NEON
+#  endif
+#endif  // CONTAINER_STREAM_IO_NO_SIMD
+
+#ifdef _MSC_VER
+#  include <intrin.h>     // _BitScanForward(64)
+#endif
+
+// C locale numeric representation, see numeric
+#if (__cplusplus >= 201703L) && !defined(CONTAINER_STREAM_IO_NO_CHARCONV)
+#  include <charconv>     // to_chars, from_chars
+#  ifdef __cpp_lib_to_chars  // floating point conversions available
+#    define CONTAINER_STREAM_IO_CHARCONV
+#  endif
+#endif  // CONTAINER_STREAM_IO_NO_CHARCONV
+
+// polymorphic allocation of parsing temporaries, see input::from_stream
+#if (__cplusplus >= 201703L) && defined(__has_include)
+#  if __has_include(<memory_resource>)
+#    include <memory_resource>  // memory_resource, polymorphic_allocator
+#    ifdef __cpp_lib_memory_resource
+#      define CONTAINER_STREAM_IO_PMR
+#    endif
+#  endif
+#endif  // C++17
+
+// C++20 ranges output, see output::range
+#if (__cplusplus > 201703L) && defined(__has_include)
+#  if __has_include(<ranges>)
+#    include <ranges>
+#    ifdef __cpp_lib_ranges
+#      define CONTAINER_STREAM_IO_RANGES
+#    endif
+#  endif
+#endif  // C++20
+
+// memory mapped file input, see buffers::mapped_file; opt-in, as the
+//   system headers would otherwise be included in every translation unit
+#ifdef CONTAINER_STREAM_IO_MMAP
+#  if defined(_WIN32)
+// min/max macros would break std::min/std::max, so are suppressed while
+//   including windows.h, without leaving either macro defined
+#    ifndef NOMINMAX
+#      define NOMINMAX
+#      define CONTAINER_STREAM_IO_DEFINED_NOMINMAX
+#    endif
+#    ifndef WIN32_LEAN_AND_MEAN
+#      define WIN32_LEAN_AND_MEAN
+#      define CONTAINER_STREAM_IO_DEFINED_WIN32_LEAN_AND_MEAN
+#    endif
+#    include <windows.h>    // CreateFileA, CreateFileMappingA, MapViewOfFile
+#    ifdef CONTAINER_STREAM_IO_DEFINED_NOMINMAX
+#      undef NOMINMAX
+#      undef CONTAINER_STREAM_IO_DEFINED_NOMINMAX
+#    endif
+#    ifdef CONTAINER_STREAM_IO_DEFINED_WIN32_LEAN_AND_MEAN
+#      undef WIN32_LEAN_AND_MEAN
+#      undef CONTAINER_STREAM_IO_DEFINED_WIN32_LEAN_AND_MEAN
+#    endif
+#    define CONTAINER_STREAM_IO_WIN32_MMAP
+#  elif defined(__unix__) || defined(__APPLE__)
+#    include <fcntl.h>      // open
+#    include <sys/mman.h>   // mmap, munmap, madvise
+#    include <sys/stat.h>   // fstat
+#    include <unistd.h>     // close
+#    define CONTAINER_STREAM_IO_POSIX_MMAP
+#  endif
+#endif  // CONTAINER_STREAM_IO_MMAP
+
 /**
  * @brief manually adding to std STL elements from later standards when needed
  */
@@ -41,6 +139,30 @@ using remove_const_t = typename remove_const<T>::type;
 // Use of generic lambda in generic overload of to_stream ellided by
 //   testing for feature test macro __cpp_generic_lambdas
 
+// __cpp_lib_integer_sequence only defined from C++14
+template <std::size_t... Indices>
+struct index_sequence
+{
+    static constexpr std::size_t size() noexcept
+    {
+        return sizeof...(Indices);
+    }
+};
+
+template <std::size_t Size, std::size_t... Indices>
+struct make_index_sequence_impl :
+        public make_index_sequence_impl<Size - 1, Size - 1, Indices...>
+{};
+
+template <std::size_t... Indices>
+struct make_index_sequence_impl<0, Indices...>
+{
+    using type = index_sequence<Indices...>;
+};
+
+template <std::size_t Size>
+using make_index_sequence = typename make_index_sequence_impl<Size>::type;
+
 #endif  // pre-C++14
 
 #ifndef __cpp_lib_void_t  // from C++17
@@ -118,8 +240,8 @@ template <typename Type>
 struct is_stl_string_type : public std::false_type
 {};
 
-template <typename CharType>
-struct is_stl_string_type<std::basic_string<CharType>> :
+template <typename CharType, typename TraitsType, typename AllocType>
+struct is_stl_string_type<std::basic_string<CharType, TraitsType, AllocType>> :
     public std::integral_constant<bool, is_char_type<CharType>::value>
 {};
 
@@ -186,6 +308,32 @@ struct has_emplace_back<Type, std::void_t<decltype(std::declval<Type>().emplace_
     : public std::true_type
 {};
 
+/**
+ * @brief tests for member type key_compare, as found in ordered associative
+ *   containers, eg std::(multi)set, std::(multi)map
+ */
+template <typename Type, typename = void>
+struct has_key_compare : public std::false_type
+{};
+
+template <typename Type>
+struct has_key_compare<Type, std::void_t<typename Type::key_compare>>
+    : public std::true_type
+{};
+
+/**
+ * @brief tests for member function get_allocator(), eg as found in all STL
+ *   containers other than std::array
+ */
+template <typename Type, typename = void>
+struct has_get_allocator : public std::false_type
+{};
+
+template <typename Type>
+struct has_get_allocator<Type, std::void_t<decltype(std::declval<Type>().get_allocator())>>
+    : public std::true_type
+{};
+
 /**
  * @brief tests for member function emplace_after(const iterator, args...),
  *   eg as found in std::forward_list
@@ -212,6 +360,59 @@ struct supports_element_emplacement : public std::integral_constant<
     has_emplace_back<Type>::value || has_emplace_after<Type>::value>
 {};
 
+/**
+ * @brief tests for STL container adaptors, which are streamed as their
+ *   underlying container (see adaptor_access)
+ */
+template <typename Type>
+struct is_container_adaptor : public std::false_type
+{};
+
+template <typename Type, typename ContainerType>
+struct is_container_adaptor<std::stack<Type, ContainerType>>
+    : public std::true_type
+{};
+
+template <typename Type, typename ContainerType>
+struct is_container_adaptor<std::queue<Type, ContainerType>>
+    : public std::true_type
+{};
+
+template <typename Type, typename ContainerType, typename CompareType>
+struct is_container_adaptor<std::priority_queue<Type, ContainerType, CompareType>>
+    : public std::true_type
+{};
+
+/**
+ * @brief access to the protected members of STL container adaptors: the
+ *   underlying container c, and the comparator comp of std::priority_queue
+ * @notes member pointers to c and comp are taken through this derived class,
+ *   but applied to the adaptor itself, so no adaptor is copied or drained
+ */
+template <typename AdaptorType>
+struct adaptor_access : public AdaptorType
+{
+    using container_type = typename AdaptorType::container_type;
+
+    static container_type& container(AdaptorType& adaptor) noexcept
+    {
+        return adaptor.*(&adaptor_access::c);
+    }
+
+    static const container_type& container(const AdaptorType& adaptor) noexcept
+    {
+        return adaptor.*(&adaptor_access::c);
+    }
+
+    // templated so that value_compare is only required of priority_queue
+    template <typename QueueType = AdaptorType>
+    static const typename QueueType::value_compare& compare(
+        const QueueType& adaptor) noexcept
+    {
+        return adaptor.*(&adaptor_access::comp);
+    }
+};
+
 /**
  * @brief tests for class compatibility with container istreaming
  * @notes overloads should behave as follows:
@@ -228,6 +429,8 @@ struct supports_element_emplacement : public std::integral_constant<
  *   - std::pair: exeception to default
  *   - std::tuple: exeception to default
  *   - std::array: exeception to default
+ *   - std::stack, std::queue, std::priority_queue: exception to default, if
+ *       underlying container is compatible
  *   - C array of non-char type: exeception to default
  *   - C array of char type: explicitly excluded to differentiate from non-char arrays
  */
@@ -256,6 +459,21 @@ template <typename ArrayType, std::size_t ArraySize>
 struct is_parseable_as_container<std::array<ArrayType, ArraySize>> : public std::true_type
 {};
 
+template <typename Type, typename ContainerType>
+struct is_parseable_as_container<std::stack<Type, ContainerType>>
+    : public is_parseable_as_container<ContainerType>
+{};
+
+template <typename Type, typename ContainerType>
+struct is_parseable_as_container<std::queue<Type, ContainerType>>
+    : public is_parseable_as_container<ContainerType>
+{};
+
+template <typename Type, typename ContainerType, typename CompareType>
+struct is_parseable_as_container<std::priority_queue<Type, ContainerType, CompareType>>
+    : public is_parseable_as_container<ContainerType>
+{};
+
 template <typename ArrayType, std::size_t ArraySize>
 struct is_parseable_as_container<ArrayType[ArraySize],
                                  std::enable_if_t<!is_char_type<ArrayType>::value, void>>
@@ -289,6 +507,8 @@ constexpr bool is_parseable_as_container_v = is_parseable_as_container<Type>::va
  *         std::stack, std::queue, std::priority_queue (lacking iterator, begin(), end())
  *   - std::pair: exeception to default
  *   - std::tuple: exeception to default
+ *   - std::stack, std::queue, std::priority_queue: exception to default, if
+ *       underlying container is compatible
  *   - C array of non-char type: exeception to default
  *   - C array of char type: explicitly excluded to differentiate from non-char arrays
  *   - std::basic_string: exclusion from default
@@ -315,6 +535,21 @@ template <typename... Args>
 struct is_printable_as_container<std::tuple<Args...>> : public std::true_type
 {};
 
+template <typename Type, typename ContainerType>
+struct is_printable_as_container<std::stack<Type, ContainerType>>
+    : public is_printable_as_container<ContainerType>
+{};
+
+template <typename Type, typename ContainerType>
+struct is_printable_as_container<std::queue<Type, ContainerType>>
+    : public is_printable_as_container<ContainerType>
+{};
+
+template <typename Type, typename ContainerType, typename CompareType>
+struct is_printable_as_container<std::priority_queue<Type, ContainerType, CompareType>>
+    : public is_printable_as_container<ContainerType>
+{};
+
 template <typename ArrayType, std::size_t ArraySize>
 struct is_printable_as_container<ArrayType[ArraySize],
                                  std::enable_if_t<!is_char_type<ArrayType>::value, void>>
@@ -348,1742 +583,9593 @@ constexpr bool is_printable_as_container_v = is_printable_as_container<Type>::va
 
 #endif
 /**
- * @brief helper function to determine if a container is empty
+ * @brief tests for member function encode(SinkType&), used to insert types
+ *   with their own encoding directly into a buffers::output_buffer, eg
+ *   strings::detail::string_repr
  */
-template <typename ContainerType>
-bool is_empty(const ContainerType& container) noexcept
-{
-    return container.empty();
-}
+template <typename Type, typename SinkType, typename = void>
+struct has_buffered_encoding : public std::false_type
+{};
+
+template <typename Type, typename SinkType>
+struct has_buffered_encoding<
+    Type, SinkType, std::void_t<decltype(
+    std::declval<const Type&>().encode(std::declval<SinkType&>()))>>
+    : public std::true_type
+{};
 
 /**
- * @brief helper function to test C arrays for emptiness
+ * @brief tests for member function size()
  */
-template <typename ArrayType, std::size_t ArraySize>
-constexpr bool is_empty(const ArrayType (&)[ArraySize]) noexcept
-{
-    return ArraySize == 0;
-}
+template <typename Type, typename = void>
+struct has_size : public std::false_type
+{};
 
-}  // namespace traits
+template <typename Type>
+struct has_size<Type, std::void_t<decltype(std::declval<const Type&>().size())>>
+    : public std::true_type
+{};
 
 /**
- * @brief contains resources for string encoding/decoding
+ * @brief tests for member function reserve(size_type), eg as found in
+ *   std::vector and std::unordered_(multi)(map|set)
  */
-namespace strings {
+template <typename Type, typename = void>
+struct has_reserve : public std::false_type
+{};
+
+template <typename Type>
+struct has_reserve<
+    Type, std::void_t<decltype(std::declval<Type&>().reserve(std::size_t {}))>>
+    : public std::true_type
+{};
 
 /**
- * @brief contains implementation of macros which generate compile-time string
- *   or character literals templated by character type
- * @notes adapted from: https://stackoverflow.com/a/60770220
+ * @brief tests for optional formatter member function
+ *   print_count_hint(StreamType&, size_t)
  */
-namespace compile_time {
+template <typename FormatterType, typename StreamType, typename = void>
+struct has_print_count_hint : public std::false_type
+{};
 
-#if (__cplusplus >= 201703L)
+template <typename FormatterType, typename StreamType>
+struct has_print_count_hint<
+    FormatterType, StreamType, std::void_t<decltype(
+    std::declval<const FormatterType&>().print_count_hint(
+        std::declval<StreamType&>(), std::size_t {}))>>
+    : public std::true_type
+{};
 
 /**
- * @brief C++17 implementation of CHAR_LITERAL
+ * @brief tests for optional formatter member function
+ *   parse_count_hint(StreamType&, size_t&)
  */
-template <typename CharType>
-constexpr const CharType char_literal(
-    [[maybe_unused]] const char ac,
-    [[maybe_unused]] const wchar_t wc,
-#if (__cplusplus > 201703L)
-    [[maybe_unused]] const char8_t u8c,
-#endif
-    [[maybe_unused]] const char16_t u16c,
-    [[maybe_unused]] const char32_t u32c)
-{
-    if      constexpr( std::is_same_v<CharType, char> )      return ac;
-    else if constexpr( std::is_same_v<CharType, wchar_t> )   return wc;
-#if (__cplusplus > 201703L)
-    else if constexpr( std::is_same_v<CharType, char8_t> )   return u8c;
-#endif
-    else if constexpr( std::is_same_v<CharType, char16_t> )  return u16c;
-    else if constexpr( std::is_same_v<CharType, char32_t> )  return u32c;
-}
+template <typename FormatterType, typename StreamType, typename = void>
+struct has_parse_count_hint : public std::false_type
+{};
+
+template <typename FormatterType, typename StreamType>
+struct has_parse_count_hint<
+    FormatterType, StreamType, std::void_t<decltype(
+    std::declval<const FormatterType&>().parse_count_hint(
+        std::declval<StreamType&>(), std::declval<std::size_t&>()))>>
+    : public std::true_type
+{};
 
 /**
- * @brief C++17 implementation of STRING_LITERAL
+ * @brief tests for optional formatter member function
+ *   try_parse_suffix(StreamType&), returning true if the suffix was next and
+ *   extracted, and false otherwise without setting failbit
  */
-template <typename CharType,
-          std::size_t SizeAscii, std::size_t SizeWide,
-#if (__cplusplus > 201703L)
-         std::size_t SizeUTF8,
-#endif
-         std::size_t SizeUTF16, std::size_t SizeUTF32,
-         std::size_t Size = (
-         std::is_same_v<CharType, char>     ? SizeAscii :
-         std::is_same_v<CharType, wchar_t>  ? SizeWide  :
-#if (__cplusplus > 201703L)
-         std::is_same_v<CharType, char8_t>  ? SizeUTF8  :
-#endif
-         std::is_same_v<CharType, char16_t> ? SizeUTF16 :
-         std::is_same_v<CharType, char32_t> ? SizeUTF32 : 0 ) >
-constexpr auto string_literal(
-    [[maybe_unused]] const char (&as) [SizeAscii],
-    [[maybe_unused]] const wchar_t (&ws) [SizeWide],
-#if (__cplusplus > 201703L)
-    [[maybe_unused]] const char8_t (&u8s) [SizeUTF8],
-#endif
-    [[maybe_unused]] const char16_t (&u16s) [SizeUTF16],
-    [[maybe_unused]] const char32_t (&u32s) [SizeUTF32]
-        ) -> const CharType(&)[Size]
-{
-    if      constexpr( std::is_same_v<CharType, char> )     return as;
-    else if constexpr( std::is_same_v<CharType, wchar_t> )  return ws;
-#if (__cplusplus > 201703L)
-    else if constexpr( std::is_same_v<CharType, char8_t> )  return u8s;
-#endif
-    else if constexpr( std::is_same_v<CharType, char16_t> ) return u16s;
-    else if constexpr( std::is_same_v<CharType, char32_t> ) return u32s;
-}
+template <typename FormatterType, typename StreamType, typename = void>
+struct has_try_parse_suffix : public std::false_type
+{};
 
-#else // __cplusplus < 201703L
+template <typename FormatterType, typename StreamType>
+struct has_try_parse_suffix<
+    FormatterType, StreamType, std::void_t<decltype(
+    std::declval<const FormatterType&>().try_parse_suffix(
+        std::declval<StreamType&>()))>>
+    : public std::true_type
+{};
 
 /**
- * @brief C++11 implementation of CHAR_LITERAL
- * @notes constepxr functions implicitly inline per C++11 standard:
- *   https://stackoverflow.com/a/14391320
+ * @brief tests for containers storing elements contiguously, so that they can
+ *   be printed/parsed as one block, eg std::vector (except std::vector<bool>),
+ *   std::array, C arrays
  */
-template<typename CharType>
-constexpr CharType char_literal(
-    const char ac, const wchar_t wc, const char16_t u16c, const char32_t u32c);
+template <typename Type>
+struct is_contiguous_container : public std::false_type
+{};
 
-template<>
-constexpr char char_literal(
-    const char ac, const wchar_t /*wc*/, const char16_t /*u16c*/, const char32_t /*u32c*/)
+template <typename ElementType, typename AllocType>
+struct is_contiguous_container<std::vector<ElementType, AllocType>>
+    : public std::integral_constant<bool, !std::is_same<ElementType, bool>::value>
 {
-    return ac;
-}
+    using element_type = ElementType;
+};
 
-template<>
-constexpr wchar_t char_literal(
-    const char /*ac*/, const wchar_t wc, const char16_t /*u16c*/, const char32_t /*u32c*/)
+template <typename ElementType, std::size_t ArraySize>
+struct is_contiguous_container<std::array<ElementType, ArraySize>>
+    : public std::true_type
 {
-    return wc;
-}
+    using element_type = ElementType;
+};
 
-template<>
-constexpr char16_t char_literal(
-    const char /*ac*/, const wchar_t /*wc*/, const char16_t u16c, const char32_t /*u32c*/)
+template <typename ElementType, std::size_t ArraySize>
+struct is_contiguous_container<ElementType[ArraySize]>
+    : public std::true_type
 {
-    return u16c;
-}
+    using element_type = ElementType;
+};
 
-template<>
-constexpr char32_t char_literal(
-    const char /*ac*/, const wchar_t /*wc*/, const char16_t /*u16c*/, const char32_t u32c)
-{
-    return u32c;
-}
+/**
+ * @brief tests for member function resize(size_type), eg as found in
+ *   std::vector
+ */
+template <typename Type, typename = void>
+struct has_resize : public std::false_type
+{};
+
+template <typename Type>
+struct has_resize<
+    Type, std::void_t<decltype(std::declval<Type&>().resize(std::size_t {}))>>
+    : public std::true_type
+{};
 
 /**
- * @brief C++11 implementation of STRING_LITERAL
- * @notes partial function template specialization not allowed by standard, see:
- *   https://stackoverflow.com/a/21218271, so instead using overloads each
- *   templated by literal sizes and enabled by return char type
+ * @brief tests for optional formatter member function
+ *   print_block(StreamType&, const ElementType*, size_t), used to print all
+ *   elements of a contiguous container at once
  */
-template<typename CharType,
-         std::size_t SizeAscii, std::size_t SizeWide,
-         std::size_t SizeUTF16, std::size_t SizeUTF32>
-constexpr auto string_literal(
-    const char (&as)[SizeAscii], const wchar_t (&/*ws*/)[SizeWide],
-    const char16_t (&/*u16s*/)[SizeUTF16], const char32_t (&/*u32s*/)[SizeUTF32]
-    ) -> std::enable_if_t<
-        std::is_same<CharType, char>::value,
-        const char(&)[SizeAscii]>
-{
-    return as;
-}
+template <typename FormatterType, typename StreamType, typename ContainerType,
+          typename = void>
+struct has_print_block : public std::false_type
+{};
 
-template<typename CharType,
-         std::size_t SizeAscii, std::size_t SizeWide,
-         std::size_t SizeUTF16, std::size_t SizeUTF32>
-constexpr auto string_literal(
-    const char (&/*as*/)[SizeAscii], const wchar_t (&ws)[SizeWide],
-    const char16_t (&/*u16s*/)[SizeUTF16], const char32_t (&/*u32s*/)[SizeUTF32]
-    ) -> std::enable_if_t<
-        std::is_same<CharType, wchar_t>::value,
-        const wchar_t(&)[SizeWide]>
-{
-    return ws;
-}
+template <typename FormatterType, typename StreamType, typename ContainerType>
+struct has_print_block<
+    FormatterType, StreamType, ContainerType, std::void_t<decltype(
+    std::declval<const FormatterType&>().print_block(
+        std::declval<StreamType&>(),
+        std::declval<const typename is_contiguous_container<
+            ContainerType>::element_type*>(), std::size_t {}))>>
+    : public is_contiguous_container<ContainerType>
+{};
 
-template<typename CharType,
-         std::size_t SizeAscii, std::size_t SizeWide,
-         std::size_t SizeUTF16, std::size_t SizeUTF32>
-constexpr auto string_literal(
-    const char (&/*as*/)[SizeAscii], const wchar_t (&/*ws*/)[SizeWide],
-    const char16_t (&u16s)[SizeUTF16], const char32_t (&/*u32s*/)[SizeUTF32]
-    ) -> std::enable_if_t<
-        std::is_same<CharType, char16_t>::value,
-        const char16_t(&)[SizeUTF16]>
-{
-    return u16s;
-}
-
-template<typename CharType,
-         std::size_t SizeAscii, std::size_t SizeWide,
-         std::size_t SizeUTF16, std::size_t SizeUTF32>
-constexpr auto string_literal(
-    const char (&/*as*/)[SizeAscii], const wchar_t (&/*ws*/)[SizeWide],
-    const char16_t (&/*u16s*/)[SizeUTF16], const char32_t (&u32s)[SizeUTF32]
-    ) -> std::enable_if_t<
-        std::is_same<CharType, char32_t>::value,
-        const char32_t(&)[SizeUTF32]>
-{
-    return u32s;
-}
-
-#endif
-
-#if (__cplusplus > 201703L)
-
-#  define CHAR_LITERAL(CHAR_T, LITERAL) \
-    char_literal<CHAR_T>( LITERAL, L ## LITERAL, u8 ## LITERAL, \
-                          u ## LITERAL, U ## LITERAL )
-
-#  define STRING_LITERAL(CHAR_T, LITERAL) \
-    string_literal<CHAR_T>( LITERAL, L ## LITERAL, u8 ## LITERAL, \
-                            u ## LITERAL, U ## LITERAL )
-
-#else  // __cplusplus <= 201703L
-
-#  define CHAR_LITERAL(CHAR_T, LITERAL) \
-    char_literal<CHAR_T>( LITERAL, L ## LITERAL, u ## LITERAL, U ## LITERAL )
-
-#  define STRING_LITERAL(CHAR_T, LITERAL) \
-    string_literal<CHAR_T>( LITERAL, L ## LITERAL, u ## LITERAL, U ## LITERAL )
-
-#endif
+/**
+ * @brief tests for optional formatter member function
+ *   parse_block(StreamType&, ElementType*, size_t), used to parse all
+ *   elements of a contiguous container at once
+ */
+template <typename FormatterType, typename StreamType, typename ContainerType,
+          typename = void>
+struct has_parse_block : public std::false_type
+{};
 
-}  // namespace compile_time
+template <typename FormatterType, typename StreamType, typename ContainerType>
+struct has_parse_block<
+    FormatterType, StreamType, ContainerType, std::void_t<decltype(
+    std::declval<const FormatterType&>().parse_block(
+        std::declval<StreamType&>(),
+        std::declval<typename is_contiguous_container<
+            ContainerType>::element_type*>(), std::size_t {}))>>
+    : public is_contiguous_container<ContainerType>
+{};
 
 /**
- * @brief implementation details for quoted/literal
- * @notes quoted/literal implementation (string_repr, operator<</>>(string_repr),
- *   quoted(), literal()) is based on GNU ISO C++14 std::quoted (as seen in
- *   headers `iomanip`, `bits/quoted_string.h`) and reworked here to add features
- *   and allow use in C++11
+ * @brief tests for optional formatter member function
+ *   parse_numbers(StreamType&, ElementType*, size_t, bool), used to parse
+ *   runs of numeric elements of a contiguous container at once
  */
-namespace detail {
+template <typename FormatterType, typename StreamType, typename ContainerType,
+          typename = void>
+struct has_parse_numbers : public std::false_type
+{};
+
+template <typename FormatterType, typename StreamType, typename ContainerType>
+struct has_parse_numbers<
+    FormatterType, StreamType, ContainerType, std::void_t<decltype(
+    std::declval<const FormatterType&>().parse_numbers(
+        std::declval<StreamType&>(),
+        std::declval<typename is_contiguous_container<
+            ContainerType>::element_type*>(), std::size_t {}, bool {}))>>
+    : public is_contiguous_container<ContainerType>
+{};
 
 /**
- * @brief labels for string representation type flag values
+ * @brief SFINAE struct to detect types that can be extracted by decoding
+ *   directly from a buffers::input_buffer, eg strings::detail::string_repr
  */
-enum class repr_type { literal, quoted };
+template <typename Type, typename SourceType, typename = void>
+struct has_buffered_decoding : public std::false_type
+{};
+
+template <typename Type, typename SourceType>
+struct has_buffered_decoding<
+    Type, SourceType, std::void_t<decltype(
+    std::declval<const Type&>().decode(std::declval<SourceType&>()))>>
+    : public std::true_type
+{};
 
 /**
- * @brief stream index getter for use with iword/pword to set literalrepr/quotedrepr
+ * @brief helper function to determine if a container is empty
  */
-static inline int get_manip_i()
+template <typename ContainerType>
+bool is_empty(const ContainerType& container) noexcept
 {
-    static int i {std::ios_base::xalloc()};
-    return i;
+    return container.empty();
 }
 
 /**
- * @brief string representation, contains data necessary to istream/ostream a
- *   a quoted/literal string encoding
+ * @brief helper function to test C arrays for emptiness
  */
-template <typename StringType, typename CharType>
-struct string_repr
+template <typename ArrayType, std::size_t ArraySize>
+constexpr bool is_empty(const ArrayType (&)[ArraySize]) noexcept
 {
-private:
-    /**
-     * @brief contains standard ascii escape sequences, mapped both by value and
-     *   by escape symbol
-     * @notes
-     *   - by_value and by_symbol need to be wrapped in a struct to avoid
-     *       variable template use (for C++11 compliance)
-     *   - given Unicode code points below 0x7f map to 7-bit ASCII, escapes
-     *       treated the same for all char types
-     *   - legacy C trigraphs and "\?" -> '?' escaping ignored for now, see:
-     *       https://en.cppreference.com/w/cpp/language/escape
-     *       https://en.cppreference.com/w/c/language/operator_alternative
-     *   - non-literal (std::map has non-trivial dtor) static members must be
-     *       initialized outside class definition (per gcc)
-     */
-    struct ascii_escapes
-    {
-        static std::map<CharType, CharType> by_value;
-        static std::map<CharType, CharType> by_symbol;
-    };
+    return ArraySize == 0;
+}
 
-public:
-    // TBD change to SFINAE with enable_if
-    static_assert(std::is_pointer<StringType>::value ||
-                  std::is_reference<StringType>::value,
-                  "String type must be a pointer or reference");
+}  // namespace traits
 
-    StringType string;
-    CharType delim;
-    CharType escape;
-    repr_type type;
+}  // namespace container_stream_io
 
-    static constexpr ascii_escapes escapes {};
+/**
+ * @brief forward declarations of stream operators for compatible containers
+ *   (defined at end of file,) needed for lookup of the operators when
+ *   streaming nested containers from inside the formatters, as ADL on STL
+ *   container types only searches namespace std
+ */
+template <typename ContainerType, typename StreamType>
+auto operator>>(StreamType& istream, ContainerType& container
+    ) -> std::enable_if_t<
+    container_stream_io::traits::is_parseable_as_container<ContainerType>::value,
+    StreamType&>;
 
-    string_repr() = delete;
-    string_repr(const StringType str, const CharType dlm,
-                const CharType esc, const repr_type typ) :
-        string{str}, delim{dlm}, escape{esc}, type{typ}
-    {
-        if (type == repr_type::literal &&
-            (dlm > 0x7f || !std::isprint(dlm) ||
-             esc > 0x7f || !std::isprint(esc)))
-            throw(std::invalid_argument(
-                      "literal delim and escape must be printable 7-bit ASCII characters"));
-    }
+template <typename ContainerType, typename StreamType>
+auto operator<<(StreamType& ostream, const ContainerType& container
+    ) -> std::enable_if_t<
+    container_stream_io::traits::is_printable_as_container<ContainerType>::value,
+    StreamType&>;
 
-    string_repr& operator=(string_repr&) = delete;
-};
+namespace container_stream_io {
 
-#if (__cplusplus < 201703L)
+/**
+ * @brief contains stream buffering used to bypass formatted stream insertion
+ *   and extraction in container serializations
+ */
+namespace buffers {
 
 /**
- * linker needs declaration of static constexpr members outside class for
- *   standards below C++17, see:
- *   - https://en.cppreference.com/w/cpp/language/static
- *   - https://stackoverflow.com/a/28846608
+ * @brief accumulates serialization output in a contiguous local buffer, which
+ *   is then written to the streambuf of the wrapped ostream in large blocks
+ * @notes
+ *   - meant to be passed to output::to_stream in place of the wrapped ostream,
+ *       so mimics the subset of the basic_ostream interface used by
+ *       output::default_formatter
+ *   - rdbuf() is fetched and a sentry constructed only once for the lifetime
+ *       of the buffer, rather than once per insertion
+ *   - insertion of types without a buffered encoding flushes the buffer and
+ *       then falls back on the wrapped ostream, preserving output order
  */
-template <typename StringType, typename CharType>
-constexpr typename string_repr<StringType, CharType>::ascii_escapes string_repr<StringType, CharType>::escapes;
+template <typename CharType, typename TraitsType = std::char_traits<CharType>>
+class output_buffer
+{
+public:
+    using char_type = CharType;
+    using traits_type = TraitsType;
+    using ostream_type = std::basic_ostream<CharType, TraitsType>;
 
-#endif  // pre-C++17
+    static constexpr std::size_t capacity { 4096 / sizeof(CharType) };
 
-template <typename StringType, typename CharType>
-std::map<CharType, CharType> string_repr<StringType, CharType>::ascii_escapes::by_value
-{
+    explicit output_buffer(ostream_type& ostream) :
+        ostream_{ostream}, sentry_{ostream}, streambuf_{ostream.rdbuf()}, size_{}
     {
-        {'\a', 'a'}, {'\b', 'b'}, {'\f', 'f'}, {'\n', 'n'},
-        {'\r', 'r'}, {'\t', 't'}, {'\v', 'v'}, {'\0', '0'}
+        // container serializations are not padded, see std::ios_base::width
+        ostream_.width(0);
     }
-};
 
-template <typename StringType, typename CharType>
-std::map<CharType, CharType> string_repr<StringType, CharType>::ascii_escapes::by_symbol
-{
+    output_buffer(const output_buffer&) = delete;
+    output_buffer& operator=(const output_buffer&) = delete;
+
+    ~output_buffer()
     {
-        {'a', '\a'}, {'b', '\b'}, {'f', '\f'}, {'n', '\n'},
-        {'r', '\r'}, {'t', '\t'}, {'v', '\v'}, {'0', '\0'}
+        try {
+            flush();
+        } catch (...) {
+            // badbit may throw depending on ostream exceptions mask
+        }
     }
-};
 
-/**
- * @brief helper to operator<<(string_repr), ostreams literal prefix
- */
-template <typename StreamCharType, typename StringCharType>
-static void insert_literal_prefix(
-        std::basic_ostream<StreamCharType>& os)
-{
-    using namespace compile_time;  // char_literal, string_literal
-    if (std::is_same<StringCharType, wchar_t>::value)
-        os << CHAR_LITERAL(StreamCharType, 'L');
-#if (__cplusplus > 201703L)
-    if (std::is_same<StringCharType, char8_t>::value)
-        os << STRING_LITERAL(StreamCharType, "u8");
-#endif
-    if (std::is_same<StringCharType, char16_t>::value)
-        os << CHAR_LITERAL(StreamCharType, 'u');
-    if (std::is_same<StringCharType, char32_t>::value)
-        os << CHAR_LITERAL(StreamCharType, 'U');
-}
+    ostream_type& stream() noexcept
+    {
+        return ostream_;
+    }
 
-/**
- * @brief helper to operator<<(string_repr), ostreams one character from a
- *   string representation
- */
-template <typename StreamCharType, typename StringType, typename StringCharType>
-static void insert_escaped_char(
-    std::basic_ostream<StreamCharType>& os,
-    const string_repr<StringType, StringCharType>& repr,
-    const StringCharType c)
-{
-    static constexpr uint32_t hex_mask {
-        (sizeof(StringCharType) == 1) ? 0xff :
-        (sizeof(StringCharType) == 2) ? 0xffff :
-                                        0xffffffff };
+    bool good() const
+    {
+        return sentry_ && ostream_.good();
+    }
 
-    if (c < 0x7f && std::isprint(c))
+    long& iword(const int index)
     {
-        // literal_repr ctor enforces ASCII-printable delim and escape
-        if (c == repr.delim || c == repr.escape)
-            os << StreamCharType(repr.escape);
-        os << StreamCharType(c);
+        return ostream_.iword(index);
     }
-    else
+
+    void setstate(const std::ios_base::iostate state)
     {
-        os << StreamCharType(repr.escape);
-        try {
-            os << StreamCharType(repr.escapes.by_value.at(c));
-        } catch (const std::out_of_range& /*oor_ex*/) {
-            // custom hex escape sequence
-            os << StreamCharType('x') <<
-                std::hex << std::setfill(StreamCharType('0')) <<
-                std::setw(2 * sizeof(StringCharType)) <<
-                (hex_mask & static_cast<uint32_t>(c));
-        }
+        ostream_.setstate(state);
     }
-}
 
-// TBD maybe throw exeception rather than set failbit on quoted char size failure?
-/**
- * @brief ostream operator for string representations
- * @notes overloads as follows:
- *   - default: handles (const) basic_string& and (const) basic_string_view&
- *      represenations (potentially also (const) (CharT&)[] if not decayed?)
- *   - single-char: handles (const) CharT& representations
- *   - C string: handles (const) CharT* representations
- */
-template<typename StreamCharType, typename StringType, typename StringCharType>
-auto operator<<(
-    std::basic_ostream<StreamCharType>& ostream,
-    const string_repr<StringType&, StringCharType>& repr
-    ) -> std::enable_if_t<
-    traits::is_stl_string_type<std::remove_const_t<StringType>>::value,
-    std::basic_ostream<StreamCharType>&>
-{
-    if (repr.type == repr_type::quoted &&
-        sizeof(StreamCharType) < sizeof(StringCharType))
+    output_buffer& put(const CharType c)
     {
-        ostream.setstate(std::ios_base::failbit);
-        return ostream;
+        if (size_ == capacity)
+            flush();
+        buffer_[size_++] = c;
+        return *this;
     }
-    std::basic_ostringstream<StreamCharType> oss;
-    insert_literal_prefix<StreamCharType, StringCharType>(oss);
-    oss << StreamCharType(repr.delim);
-    if (repr.type == repr_type::quoted)
+
+    output_buffer& write(const CharType* s, const std::size_t n)
     {
-        for (const auto c : repr.string)
+        if (n > capacity - size_)
         {
-            if (c == repr.delim || c == repr.escape)
-                oss << StreamCharType(repr.escape);
-            oss << StreamCharType(c);
+            flush();
+            // blocks at least as large as the buffer are not worth copying
+            if (n >= capacity)
+            {
+                sputn(s, n);
+                return *this;
+            }
         }
+        traits_type::copy(buffer_ + size_, s, n);
+        size_ += n;
+        return *this;
     }
-    else
+
+    /**
+     * @brief writes buffer contents to the wrapped streambuf
+     */
+    output_buffer& flush()
     {
-        for (const auto c : repr.string)
-            insert_escaped_char(oss, repr, c);
+        if (size_ != 0)
+        {
+            sputn(buffer_, size_);
+            size_ = 0;
+        }
+        return *this;
     }
-    oss << StreamCharType(repr.delim);
-    return ostream << oss.str();
-}
 
-template <typename StreamCharType, typename CharType, typename StringCharType>
-auto operator<<(
-    std::basic_ostream<StreamCharType>& ostream,
-    const string_repr<CharType&, StringCharType>& repr
-    ) -> std::enable_if_t<
-    std::is_same<StringCharType, std::remove_const_t<CharType>>::value,
-    std::basic_ostream<StreamCharType>&>
-{
-    if (repr.type == repr_type::quoted &&
-        sizeof(StreamCharType) < sizeof(StringCharType))
+    /**
+     * @brief insertion operators
+     * @notes overloads as follows:
+     *   - CharT
+     *   - CharT* (null-terminated, eg decorator tokens)
+     *   - types with a buffered encoding (see traits::has_buffered_encoding)
+     *   - default: any other non-container type, inserted with the wrapped
+     *       ostream (containers resolve to the global operator<<, and so
+     *       remain buffered)
+     */
+    output_buffer& operator<<(const CharType c)
     {
-        ostream.setstate(std::ios_base::failbit);
-        return ostream;
+        return put(c);
     }
-    std::basic_ostringstream<StreamCharType> oss;
-    insert_literal_prefix<StreamCharType, StringCharType>(oss);
-    oss << StreamCharType(repr.delim);
-    if (repr.type == repr_type::quoted)
+
+    output_buffer& operator<<(const CharType* s)
     {
-        if (repr.string == repr.delim || repr.string == repr.escape)
-            oss << StreamCharType(repr.escape);
-        oss << StreamCharType(repr.string);
+        return write(s, traits_type::length(s));
     }
-    else
-        insert_escaped_char(oss, repr, repr.string);
-    oss << StreamCharType(repr.delim);
-    return ostream << oss.str();
-}
 
-template <typename StreamCharType, typename CharType, typename StringCharType>
-auto operator<<(
-    std::basic_ostream<StreamCharType>& ostream,
-    const string_repr<CharType*, StringCharType>& repr
-    ) -> std::enable_if_t<
-    std::is_same<StringCharType, std::remove_const_t<CharType>>::value,
-    std::basic_ostream<StreamCharType>&>
-{
-    if (repr.type == repr_type::quoted &&
-        sizeof(StreamCharType) < sizeof(StringCharType))
+    template <typename ValueType>
+    auto operator<<(const ValueType& value
+        ) -> std::enable_if_t<
+            traits::has_buffered_encoding<ValueType, output_buffer>::value,
+            output_buffer&>
     {
-        ostream.setstate(std::ios_base::failbit);
-        return ostream;
+        value.encode(*this);
+        return *this;
     }
-    std::basic_ostringstream<StreamCharType> oss;
-    insert_literal_prefix<StreamCharType, StringCharType>(oss);
-    oss << StreamCharType(repr.delim);
-    if (repr.type == repr_type::quoted)
+
+    template <typename ValueType>
+    auto operator<<(const ValueType& value
+        ) -> std::enable_if_t<
+            !traits::is_printable_as_container<ValueType>::value &&
+            !traits::has_buffered_encoding<ValueType, output_buffer>::value,
+            output_buffer&>
     {
-        for (auto p { repr.string }; *p; ++p)
-        {
-            if (*p == repr.delim || *p == repr.escape)
-                oss << StreamCharType(repr.escape);
-            oss << StreamCharType(*p);
-        }
+        flush();
+        ostream_ << value;
+        return *this;
     }
-    else
+
+private:
+    void sputn(const CharType* s, const std::size_t n)
     {
-        for (auto p { repr.string }; *p; ++p)
-            insert_escaped_char(oss, repr, *p);
+        if (!good())
+            return;
+        if (streambuf_->sputn(s, static_cast<std::streamsize>(n)) !=
+            static_cast<std::streamsize>(n))
+            ostream_.setstate(std::ios_base::badbit);
     }
-    oss << StreamCharType(repr.delim);
-    return ostream << oss.str();
-}
 
-/**
- * @brief helper to extract_string_repr, decodes/validates a literal prefix
- *   matching the target char type
- */
-template<typename StreamCharType, typename StringCharType>
-static void extract_literal_prefix(
-    std::basic_istream<StreamCharType>& istream)
-{
-    if (std::is_same<StringCharType, wchar_t>::value &&
-        istream.get() != StreamCharType('L'))
-        istream.setstate(std::ios_base::failbit);
+    ostream_type& ostream_;
+    typename ostream_type::sentry sentry_;
+    std::basic_streambuf<CharType, TraitsType>* streambuf_;
+    CharType buffer_[capacity];
+    std::size_t size_;
+};
 
-#if (__cplusplus > 201703L)
-    if (std::is_same<StringCharType, char8_t>::value &&
-        (istream.get() != StreamCharType('u') ||
-         istream.get() != StreamCharType('8')))
-        istream.setstate(std::ios_base::failbit);
-#endif
+#if (__cplusplus < 201703L)
 
-    if (std::is_same<StringCharType, char16_t>::value &&
-        istream.get() != StreamCharType('u'))
-        istream.setstate(std::ios_base::failbit);
+template <typename CharType, typename TraitsType>
+constexpr std::size_t output_buffer<CharType, TraitsType>::capacity;
 
-    if (std::is_same<StringCharType, char32_t>::value &&
-        istream.get() != StreamCharType('U'))
-        istream.setstate(std::ios_base::failbit);
-}
+#endif  // pre-C++17
 
 /**
- * @brief helper to extract_string_repr, decodes a hex escaped value and
- *   validates that it matches the width of the target char type
+ * @brief read-only streambuf over a caller-owned contiguous range of chars
+ *   (eg the data of a std::basic_string(_view) or a mapped file), so that it
+ *   can be parsed with an istream without copying
+ * @notes
+ *   - the whole range is the get area, so input_buffer windows span all of it
+ *   - chars are never written through the get area, which only holds
+ *       non-const pointers as required by std::basic_streambuf
  */
-template<typename StreamCharType, typename StringCharType>
-static int64_t extract_fixed_width_hex_value(
-    std::basic_istream<StreamCharType>& istream)
+template <typename CharType, typename TraitsType = std::char_traits<CharType>>
+class span_streambuf : public std::basic_streambuf<CharType, TraitsType>
 {
-    static constexpr uint32_t hex_length { sizeof(StringCharType) * 2 };
-    // strtol expects char* (not using wcstol due to variable size of wchar_t)
-    char buff[hex_length + 1] {};
-    char *p { buff };
-    // malformed hex strings could have values larger than StreamCharType max,
-    //   with unpredictable overflows, so we need to pre-screen one by one
-    //   rather than just call `get(buff, hex_length + 1)`
-    StreamCharType c;
-    for (uint32_t i {}; istream.good() && i < hex_length; ++i, ++p)
+public:
+    using char_type = CharType;
+    using traits_type = TraitsType;
+    using int_type = typename TraitsType::int_type;
+    using pos_type = typename TraitsType::pos_type;
+    using off_type = typename TraitsType::off_type;
+
+    /**
+     * @param stable whether chars outlive the streambuf unmodified, so that
+     *   parsed values may keep views into them (see strings::view_arena)
+     */
+    span_streambuf(const CharType* first, const CharType* last,
+                   const bool stable = true) :
+        stable_ { stable }
     {
-        istream >> c;
-        if (c > 0x7f || !isxdigit(c))
-            break;
-        *p = c;
+        CharType* const begin { const_cast<CharType*>(first) };
+        this->setg(begin, begin, begin + (last - first));
     }
-    if (p != &buff[hex_length])
-        istream.setstate(std::ios_base::failbit);
-    // strtol returns signed values, but interprets hex as unsigned
-    return std::strtol(buff, nullptr, 16);
-}
+
+    /**
+     * @brief next char to be read
+     */
+    const CharType* current() const
+    {
+        return this->gptr();
+    }
+
+    bool stable() const
+    {
+        return stable_;
+    }
+
+protected:
+    pos_type seekoff(const off_type off, const std::ios_base::seekdir dir,
+                     const std::ios_base::openmode which) override
+    {
+        if (!(which & std::ios_base::in))
+            return pos_type(off_type(-1));
+        const off_type base {
+            dir == std::ios_base::beg ? 0 :
+            dir == std::ios_base::cur ? this->gptr() - this->eback() :
+            this->egptr() - this->eback() };
+        return seekpos(pos_type(base + off), which);
+    }
+
+    pos_type seekpos(const pos_type pos,
+                     const std::ios_base::openmode which) override
+    {
+        const off_type off { off_type(pos) };
+        if (!(which & std::ios_base::in) || off < 0 ||
+            off > this->egptr() - this->eback())
+            return pos_type(off_type(-1));
+        this->setg(this->eback(), this->eback() + off, this->egptr());
+        return pos;
+    }
+
+private:
+    bool stable_;
+};
 
 /**
- * @brief helper to extract_string_repr, encapsulates main quoted representation
- *   decoding loop
+ * @brief write-only streambuf over growable local storage, which is kept
+ *   between uses, so that a streambuf reused for like serializations stops
+ *   allocating once grown to fit them (see output::to_stream_committed)
  */
-template<typename StreamCharType, typename StringCharType>
-static void extract_quoted_repr(
-    std::basic_istream<StreamCharType>& istream,
-    const string_repr<std::basic_string<StringCharType>&, StringCharType>& repr,
-    std::basic_string<StringCharType>& buffer)
+template <typename CharType, typename TraitsType = std::char_traits<CharType>>
+class growable_streambuf : public std::basic_streambuf<CharType, TraitsType>
 {
-    StreamCharType c;
-    std::ios_base::fmtflags orig_flags {
-        istream.flags(istream.flags() & ~std::ios_base::skipws) };
-    for (istream >> c;
-         istream.good() && c != StreamCharType(repr.delim); istream >> c)
-    {
-        if (c != StreamCharType(repr.escape))
+public:
+    using char_type = CharType;
+    using traits_type = TraitsType;
+    using int_type = typename TraitsType::int_type;
+
+    static constexpr std::size_t initial_capacity { 4096 / sizeof(CharType) };
+
+    const CharType* data() const
+    {
+        return this->pbase();
+    }
+
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(this->pptr() - this->pbase());
+    }
+
+    /**
+     * @brief discards contents, keeping storage
+     */
+    void clear()
+    {
+        this->setp(storage_.data(), storage_.data() + storage_.size());
+    }
+
+protected:
+    int_type overflow(const int_type c) override
+    {
+        if (traits_type::eq_int_type(c, traits_type::eof()))
+            return traits_type::not_eof(c);
+        grow(1);
+        *this->pptr() = traits_type::to_char_type(c);
+        this->pbump(1);
+        return c;
+    }
+
+    std::streamsize xsputn(const CharType* s, const std::streamsize n) override
+    {
+        const std::size_t count { static_cast<std::size_t>(n) };
+        if (static_cast<std::size_t>(this->epptr() - this->pptr()) < count)
+            grow(count);
+        traits_type::copy(this->pptr(), s, count);
+        advance(count);
+        return n;
+    }
+
+private:
+    void grow(const std::size_t count)
+    {
+        const std::size_t used { size() };
+        storage_.resize(std::max({ storage_.size() * 2, used + count,
+                                   std::size_t(initial_capacity) }));
+        clear();
+        advance(used);
+    }
+
+    // pbump takes an int
+    void advance(std::size_t count)
+    {
+        static constexpr std::size_t max_step {
+            static_cast<std::size_t>(std::numeric_limits<int>::max()) };
+        for (; count > max_step; count -= max_step)
+            this->pbump(static_cast<int>(max_step));
+        this->pbump(static_cast<int>(count));
+    }
+
+    std::vector<CharType> storage_;
+};
+
+#if (__cplusplus < 201703L)
+
+template <typename CharType, typename TraitsType>
+constexpr std::size_t growable_streambuf<CharType, TraitsType>::initial_capacity;
+
+#endif  // pre-C++17
+
+/**
+ * @brief write-only streambuf over a growable std::basic_string, which is
+ *   moved out whole once written, so that a serialization returned as a
+ *   string is formatted only once and never copied (see output::to_string)
+ */
+template <typename CharType, typename TraitsType = std::char_traits<CharType>>
+class string_ostreambuf : public std::basic_streambuf<CharType, TraitsType>
+{
+public:
+    using char_type = CharType;
+    using traits_type = TraitsType;
+    using int_type = typename TraitsType::int_type;
+    using string_type = std::basic_string<CharType, TraitsType>;
+
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(this->pptr() - this->pbase());
+    }
+
+    /**
+     * @brief chars put so far, after which the streambuf is empty
+     */
+    string_type release()
+    {
+        storage_.resize(size());
+        string_type string { std::move(storage_) };
+        storage_.clear();
+        this->setp(nullptr, nullptr);
+        return string;
+    }
+
+protected:
+    int_type overflow(const int_type c) override
+    {
+        if (traits_type::eq_int_type(c, traits_type::eof()))
+            return traits_type::not_eof(c);
+        grow(1);
+        *this->pptr() = traits_type::to_char_type(c);
+        this->pbump(1);
+        return c;
+    }
+
+    std::streamsize xsputn(const CharType* s, const std::streamsize n) override
+    {
+        const std::size_t count { static_cast<std::size_t>(n) };
+        if (static_cast<std::size_t>(this->epptr() - this->pptr()) < count)
+            grow(count);
+        traits_type::copy(this->pptr(), s, count);
+        advance(count);
+        return n;
+    }
+
+private:
+    void grow(const std::size_t count)
+    {
+        const std::size_t used { size() };
+        storage_.resize(std::max({ storage_.size() * 2, used + count,
+                                   storage_.capacity() }));
+        this->setp(&storage_[0], &storage_[0] + storage_.size());
+        advance(used);
+    }
+
+    // pbump takes an int
+    void advance(std::size_t count)
+    {
+        static constexpr std::size_t max_step {
+            static_cast<std::size_t>(std::numeric_limits<int>::max()) };
+        for (; count > max_step; count -= max_step)
+            this->pbump(static_cast<int>(max_step));
+        this->pbump(static_cast<int>(count));
+    }
+
+    string_type storage_;
+};
+
+/**
+ * @brief write-only streambuf over a caller-owned contiguous range of chars,
+ *   which counts all chars put to it, including any past the end of the
+ *   range, which are discarded
+ * @notes
+ *   - over an empty range, measures output without storing any of it (see
+ *       output::serialized_size)
+ *   - writes never fail, so that output exceeding the range can still be
+ *       measured in full
+ */
+template <typename CharType, typename TraitsType = std::char_traits<CharType>>
+class span_ostreambuf : public std::basic_streambuf<CharType, TraitsType>
+{
+public:
+    using char_type = CharType;
+    using traits_type = TraitsType;
+    using int_type = typename TraitsType::int_type;
+
+    span_ostreambuf() :
+        span_ostreambuf { nullptr, nullptr }
+    {}
+
+    span_ostreambuf(CharType* first, CharType* last) :
+        discarded_ {}
+    {
+        this->setp(first, last);
+    }
+
+    /**
+     * @brief count of chars put, whether stored or discarded
+     */
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(this->pptr() - this->pbase()) + discarded_;
+    }
+
+    /**
+     * @brief whether chars were put past the end of the range
+     */
+    bool overflowed() const
+    {
+        return discarded_ != 0;
+    }
+
+protected:
+    int_type overflow(const int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+            ++discarded_;
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const CharType* s, const std::streamsize n) override
+    {
+        const std::size_t count { static_cast<std::size_t>(n) };
+        const std::size_t stored { std::min(
+            count, static_cast<std::size_t>(this->epptr() - this->pptr())) };
+        traits_type::copy(this->pptr(), s, stored);
+        for (std::size_t remaining { stored }; remaining > 0; )
+        {
+            // pbump takes an int
+            const std::size_t step { std::min(
+                remaining, static_cast<std::size_t>(std::numeric_limits<int>::max())) };
+            this->pbump(static_cast<int>(step));
+            remaining -= step;
+        }
+        discarded_ += count - stored;
+        return n;
+    }
+
+private:
+    std::size_t discarded_;
+};
+
+/**
+ * @brief parses serialization input directly from the get area of the
+ *   wrapped istream's streambuf, in contiguous spans where possible
+ * @notes
+ *   - meant to be passed to input::from_stream in place of the wrapped
+ *       istream, so mimics the subset of the basic_istream interface used by
+ *       input::default_formatter
+ *   - no chars are held locally: the window is the streambuf's own pending
+ *       input [gptr(), egptr()), refilled with underflow() when exhausted, so
+ *       falling back on the wrapped istream (for types without a buffered
+ *       decoding) needs no synchronization
+ *   - streambufs without a get area are read one char at a time through the
+ *       same window interface
+ *   - stream state is kept by the wrapped istream, so exceptions raised
+ *       by setstate() follow its exceptions mask
+ */
+template <typename CharType, typename TraitsType = std::char_traits<CharType>>
+class input_buffer
+{
+public:
+    using char_type = CharType;
+    using traits_type = TraitsType;
+    using int_type = typename TraitsType::int_type;
+    using istream_type = std::basic_istream<CharType, TraitsType>;
+    using streambuf_type = std::basic_streambuf<CharType, TraitsType>;
+
+    explicit input_buffer(istream_type& istream) :
+        istream_{istream}, sentry_{istream, true}, streambuf_{istream.rdbuf()},
+        ctype_{}, single_{}, single_pending_{}, stable_source_{-1},
+        classic_numbers_{-1}
+    {}
+
+    input_buffer(const input_buffer&) = delete;
+    input_buffer& operator=(const input_buffer&) = delete;
+
+    istream_type& stream() noexcept
+    {
+        return istream_;
+    }
+
+    bool good() const
+    {
+        return sentry_ && istream_.good();
+    }
+
+    bool eof() const
+    {
+        return istream_.eof();
+    }
+
+    bool fail() const
+    {
+        return istream_.fail();
+    }
+
+    bool bad() const
+    {
+        return istream_.bad();
+    }
+
+    void setstate(const std::ios_base::iostate state)
+    {
+        istream_.setstate(state);
+    }
+
+    void clear(const std::ios_base::iostate state = std::ios_base::goodbit)
+    {
+        istream_.clear(state);
+    }
+
+    long& iword(const int index)
+    {
+        return istream_.iword(index);
+    }
+
+    void*& pword(const int index)
+    {
+        return istream_.pword(index);
+    }
+
+    std::streamsize in_avail()
+    {
+        return streambuf_->in_avail();
+    }
+
+    /**
+     * @brief tests if the streambuf is a stable span_streambuf, so that views
+     *   into the window remain valid after it is consumed
+     */
+    bool stable_source()
+    {
+        if (stable_source_ < 0)
+        {
+            const span_streambuf<CharType, TraitsType>* const span {
+                dynamic_cast<const span_streambuf<CharType, TraitsType>*>(
+                    streambuf_) };
+            stable_source_ = span != nullptr && span->stable();
+        }
+        return stable_source_ > 0;
+    }
+
+    /**
+     * @brief tests if numbers are extracted from the istream as in the C
+     *   locale: its locale is the classic one, and its basefield is dec
+     */
+    bool classic_numbers()
+    {
+        if (classic_numbers_ < 0)
+        {
+            classic_numbers_ =
+                (istream_.flags() & std::ios_base::basefield) == std::ios_base::dec &&
+                istream_.getloc() == std::locale::classic();
+        }
+        return classic_numbers_ > 0;
+    }
+
+    /**
+     * @brief ctype facet of the istream locale, used to classify whitespace
+     */
+    const std::ctype<CharType>& ctype()
+    {
+        if (ctype_ == nullptr)
+            ctype_ = &std::use_facet<std::ctype<CharType>>(istream_.getloc());
+        return *ctype_;
+    }
+
+    /**
+     * @brief makes the window non-empty, calling underflow() if needed
+     * @return false if not good, or at end of stream (setting eofbit)
+     */
+    bool fill_window()
+    {
+        single_pending_ = false;
+        if (!good())
+            return false;
+        if (get_area::current(*streambuf_) != get_area::end(*streambuf_))
+            return true;
+        const int_type c { streambuf_->sgetc() };
+        if (traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            istream_.setstate(std::ios_base::eofbit);
+            return false;
+        }
+        if (get_area::current(*streambuf_) == get_area::end(*streambuf_))
+        {
+            single_ = traits_type::to_char_type(c);
+            single_pending_ = true;
+        }
+        return true;
+    }
+
+    /**
+     * @brief bounds of pending input, valid after fill_window() until any
+     *   other member besides consume() is called
+     */
+    const CharType* window_begin() const
+    {
+        return single_pending_ ? &single_ : get_area::current(*streambuf_);
+    }
+
+    const CharType* window_end() const
+    {
+        return single_pending_ ? &single_ + 1 : get_area::end(*streambuf_);
+    }
+
+    /**
+     * @brief tests for chars which convert to eof() as int_type, and so are
+     *   read as end of stream by sgetc()/sbumpc() (only possible in char types
+     *   as wide as int_type, eg wchar_t)
+     */
+    static bool is_eof_value(const CharType c)
+    {
+        return sizeof(CharType) >= sizeof(int_type) &&
+            traits_type::eq_int_type(traits_type::to_int_type(c),
+                                     traits_type::eof());
+    }
+
+    /**
+     * @brief finds first char in [first, last) for which is_eof_value(),
+     *   or last
+     */
+    static const CharType* find_eof_value(
+        const CharType* first, const CharType* last)
+    {
+        if (sizeof(CharType) < sizeof(int_type))
+            return last;
+        return std::find_if(first, last, is_eof_value);
+    }
+
+    /**
+     * @brief advances past n chars of the window
+     */
+    void consume(std::size_t n)
+    {
+        if (single_pending_)
+        {
+            if (n != 0)
+            {
+                streambuf_->sbumpc();
+                single_pending_ = false;
+            }
+            return;
+        }
+        // gbump takes int, while get areas may not fit in one
+        static constexpr std::size_t max_bump {
+            static_cast<std::size_t>(std::numeric_limits<int>::max()) };
+        for (; n > max_bump; n -= max_bump)
+            get_area::bump(*streambuf_, static_cast<int>(max_bump));
+        get_area::bump(*streambuf_, static_cast<int>(n));
+    }
+
+    int_type peek()
+    {
+        if (!good())
+        {
+            istream_.setstate(std::ios_base::failbit);
+            return traits_type::eof();
+        }
+        const int_type c { streambuf_->sgetc() };
+        if (traits_type::eq_int_type(c, traits_type::eof()))
+            istream_.setstate(std::ios_base::eofbit);
+        return c;
+    }
+
+    int_type get()
+    {
+        if (!good())
+        {
+            istream_.setstate(std::ios_base::failbit);
+            return traits_type::eof();
+        }
+        const int_type c { streambuf_->sbumpc() };
+        if (traits_type::eq_int_type(c, traits_type::eof()))
+            istream_.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+        return c;
+    }
+
+    /**
+     * @brief extracts n chars, copying a window at a time, setting eofbit and
+     *   failbit if fewer are available, as with basic_istream::read()
+     */
+    input_buffer& read(CharType* s, std::streamsize n)
+    {
+        if (!good())
+        {
+            istream_.setstate(std::ios_base::failbit);
+            return *this;
+        }
+        while (n > 0)
+        {
+            if (!fill_window())
+            {
+                istream_.setstate(std::ios_base::failbit);
+                break;
+            }
+            const std::streamsize count {
+                std::min<std::streamsize>(n, window_end() - window_begin()) };
+            traits_type::copy(s, window_begin(), static_cast<std::size_t>(count));
+            consume(static_cast<std::size_t>(count));
+            s += count;
+            n -= count;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief skips whitespace as with std::ws, scanning a window at a time
+     */
+    input_buffer& skip_ws()
+    {
+        if (!good())
+        {
+            istream_.setstate(std::ios_base::failbit);
+            return *this;
+        }
+        const std::ctype<CharType>& facet { ctype() };
+        while (fill_window())
+        {
+            const CharType* const first { window_begin() };
+            const CharType* const last { window_end() };
+            const CharType* const p {
+                facet.scan_not(std::ctype_base::space, first, last) };
+            consume(static_cast<std::size_t>(p - first));
+            if (p != last)
+            {
+                if (is_eof_value(*p))
+                    istream_.setstate(std::ios_base::eofbit);
+                break;
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * @brief extracts an exact token, comparing a window at a time
+     * @notes as with per-char peek()/get() matching, any matching leading
+     *   chars are consumed before a mismatch sets failbit
+     */
+    bool match(const CharType* token, std::size_t length)
+    {
+        while (length != 0 && fill_window())
+        {
+            const CharType* const first { window_begin() };
+            const std::size_t n { std::min(
+                length, static_cast<std::size_t>(window_end() - first)) };
+            const std::size_t matched { static_cast<std::size_t>(
+                std::mismatch(first, first + n, token).first - first) };
+            consume(matched);
+            token += matched;
+            length -= matched;
+            if (matched != n)
+            {
+                if (is_eof_value(first[matched]))
+                    istream_.setstate(std::ios_base::eofbit);
+                break;
+            }
+        }
+        if (length != 0)
+            istream_.setstate(std::ios_base::failbit);
+        return length == 0;
+    }
+
+    /**
+     * @brief extraction operators
+     * @notes overloads as follows:
+     *   - istream manipulators (std::ws is handled by skip_ws())
+     *   - types with a buffered decoding (see traits::has_buffered_decoding)
+     *   - default: any other non-container type, extracted with the wrapped
+     *       istream (containers resolve to the global operator>>, and so
+     *       remain buffered)
+     */
+    input_buffer& operator>>(istream_type& (*manip)(istream_type&))
+    {
+        if (manip == static_cast<istream_type& (*)(istream_type&)>(std::ws))
+            return skip_ws();
+        manip(istream_);
+        return *this;
+    }
+
+    template <typename ValueType>
+    auto operator>>(const ValueType& value
+        ) -> std::enable_if_t<
+            traits::has_buffered_decoding<ValueType, input_buffer>::value,
+            input_buffer&>
+    {
+        value.decode(*this);
+        return *this;
+    }
+
+    template <typename ValueType>
+    auto operator>>(ValueType& value
+        ) -> std::enable_if_t<
+            !traits::is_parseable_as_container<ValueType>::value &&
+            !traits::has_buffered_decoding<ValueType, input_buffer>::value,
+            input_buffer&>
+    {
+        istream_ >> value;
+        return *this;
+    }
+
+private:
+    /**
+     * @brief exposes the protected get area pointers of any streambuf
+     *   (pointers to members named through a derived class may be applied to
+     *   objects of the base class)
+     */
+    struct get_area : public streambuf_type
+    {
+        static CharType* current(const streambuf_type& streambuf)
+        {
+            return (streambuf.*&get_area::gptr)();
+        }
+
+        static CharType* end(const streambuf_type& streambuf)
+        {
+            return (streambuf.*&get_area::egptr)();
+        }
+
+        static void bump(streambuf_type& streambuf, const int n)
+        {
+            (streambuf.*&get_area::gbump)(n);
+        }
+    };
+
+    istream_type& istream_;
+    typename istream_type::sentry sentry_;
+    streambuf_type* streambuf_;
+    const std::ctype<CharType>* ctype_;
+    CharType single_;      // window for streambufs without a get area
+    bool single_pending_;
+    int stable_source_;    // -1 until tested by stable_source()
+    int classic_numbers_;  // -1 until tested by classic_numbers()
+};
+
+/**
+ * @brief read-only view of the contents of a file, memory mapped where
+ *   supported (POSIX mmap, Win32 MapViewOfFile) if CONTAINER_STREAM_IO_MMAP
+ *   is defined, for parsing through a span_streambuf without copying
+ * @notes
+ *   - files that cannot be mapped (eg pipes, or any file unless
+ *       CONTAINER_STREAM_IO_MMAP is defined) are instead read into memory
+ *   - contents are only valid while the file is not modified
+ */
+class mapped_file
+{
+public:
+    explicit mapped_file(const std::string& path)
+    {
+        if (!map(path))
+            read(path);
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file()
+    {
+        if (!mapped_)
+            return;
+#if defined(CONTAINER_STREAM_IO_WIN32_MMAP)
+        ::UnmapViewOfFile(data_);
+#elif defined(CONTAINER_STREAM_IO_POSIX_MMAP)
+        ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+    bool is_open() const
+    {
+        return open_;
+    }
+
+    /**
+     * @brief tests if the contents are mapped, rather than read into memory
+     */
+    bool is_mapped() const
+    {
+        return mapped_;
+    }
+
+    const char* data() const
+    {
+        return data_;
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+private:
+#if defined(CONTAINER_STREAM_IO_WIN32_MMAP)
+    bool map(const std::string& path)
+    {
+        const HANDLE file { ::CreateFileA(
+            path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_FLAG_SEQUENTIAL_SCAN, nullptr) };
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER file_size;
+        if (!::GetFileSizeEx(file, &file_size) ||
+            ::GetFileType(file) != FILE_TYPE_DISK ||
+            static_cast<unsigned long long>(file_size.QuadPart) >
+            std::numeric_limits<std::size_t>::max())
+        {
+            ::CloseHandle(file);
+            return false;
+        }
+        if (file_size.QuadPart == 0)
+        {
+            open_ = true;  // empty mappings are not allowed
+        }
+        else
+        {
+            // view keeps the mapping alive after its handle is closed
+            const HANDLE mapping { ::CreateFileMappingA(
+                file, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+            if (mapping != nullptr)
+            {
+                const void* const view {
+                    ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) };
+                ::CloseHandle(mapping);
+                if (view != nullptr)
+                {
+                    data_ = static_cast<const char*>(view);
+                    size_ = static_cast<std::size_t>(file_size.QuadPart);
+                    open_ = mapped_ = true;
+                }
+            }
+        }
+        ::CloseHandle(file);
+        return open_;
+    }
+#elif defined(CONTAINER_STREAM_IO_POSIX_MMAP)
+    bool map(const std::string& path)
+    {
+        const int fd { ::open(path.c_str(), O_RDONLY) };
+        if (fd < 0)
+            return false;
+        struct stat file_stat;
+        if (::fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode) &&
+            static_cast<unsigned long long>(file_stat.st_size) <=
+            std::numeric_limits<std::size_t>::max())
+        {
+            if (file_stat.st_size == 0)
+            {
+                open_ = true;  // empty mappings are not allowed
+            }
+            else
+            {
+                const std::size_t file_size {
+                    static_cast<std::size_t>(file_stat.st_size) };
+                void* const view { ::mmap(nullptr, file_size, PROT_READ,
+                                          MAP_PRIVATE, fd, 0) };
+                if (view != MAP_FAILED)
+                {
+                    ::madvise(view, file_size, MADV_SEQUENTIAL);
+                    data_ = static_cast<const char*>(view);
+                    size_ = file_size;
+                    open_ = mapped_ = true;
+                }
+            }
+        }
+        ::close(fd);
+        return open_;
+    }
+#else
+    bool map(const std::string& /*path*/)
+    {
+        return false;
+    }
+#endif
+
+    void read(const std::string& path)
+    {
+        std::ifstream ifs { path, std::ios_base::in | std::ios_base::binary };
+        if (!ifs.is_open())
+            return;
+        contents_.assign(std::istreambuf_iterator<char> { ifs },
+                         std::istreambuf_iterator<char> {});
+        if (ifs.bad())
+            return;
+        data_ = contents_.data();
+        size_ = contents_.size();
+        open_ = true;
+    }
+
+    const char* data_ {};
+    std::size_t size_ {};
+    bool open_ {};
+    bool mapped_ {};
+    std::string contents_;  // used when not mapped
+};
+
+}  // namespace buffers
+
+/**
+ * @brief contains the instrumentation policy, which counts serialization
+ *   events in to_stream/from_stream when CONTAINER_STREAM_IO_INSTRUMENTATION
+ *   is defined, and otherwise compiles away
+ */
+namespace instrumentation {
+
+enum class direction { output, input };
+
+/**
+ * @brief events counted over one top-level output::to_stream or
+ *   input::from_stream call (including those of the stream operators)
+ */
+struct counters
+{
+    static constexpr std::size_t max_depth { 8 };
+
+    direction dir { direction::output };
+    // chars printed, if the streambuf reports its position (eg string and
+    //   file streams), otherwise 0; not counted for input
+    std::size_t bytes {};
+    // elements printed/parsed at each nesting level, top level first, with
+    //   levels past max_depth counted in the last
+    std::size_t elements[max_depth] {};
+    // strings (or chars) encoded with at least one char escaped, and those
+    //   copied whole
+    std::size_t escaped_strings {};
+    std::size_t unescaped_strings {};
+    std::size_t hex_escapes_decoded {};
+    // decorator tokens (eg separators) that did not match the input
+    std::size_t failed_token_probes {};
+    std::chrono::steady_clock::duration duration {};
+};
+
+using sink_type = std::function<void(const counters&)>;
+
+namespace detail {
+
+/**
+ * @brief user sink, shared by all threads
+ */
+inline sink_type& sink()
+{
+    static sink_type sink;
+    return sink;
+}
+
+/**
+ * @brief counters of the top-level call in progress on this thread, and
+ *   its current nesting depth
+ */
+struct thread_state
+{
+    counters current;
+    std::size_t depth {};
+    std::chrono::steady_clock::time_point start;
+};
+
+inline thread_state& local_state()
+{
+    static thread_local thread_state state;
+    return state;
+}
+
+inline void export_counters(const counters& exported)
+{
+    if (sink())
+        sink()(exported);
+}
+
+/**
+ * @brief adds the element and event counts of from to those of to
+ */
+inline void add_counts(counters& to, const counters& from)
+{
+    for (std::size_t i {}; i < counters::max_depth; ++i)
+        to.elements[i] += from.elements[i];
+    to.escaped_strings += from.escaped_strings;
+    to.unescaped_strings += from.unescaped_strings;
+    to.hex_escapes_decoded += from.hex_escapes_decoded;
+    to.failed_token_probes += from.failed_token_probes;
+}
+
+/**
+ * @brief counts events on this thread into target for its lifetime, as if
+ *   depth containers deep in a call, then restores the counters of any call
+ *   in progress on this thread
+ */
+class counting_redirect
+{
+public:
+    counting_redirect(counters& target, const std::size_t depth) :
+        target_ { target }, saved_ { local_state() }
+    {
+        thread_state& state { local_state() };
+        state.current = target;
+        state.depth = depth;
+    }
+
+    ~counting_redirect()
+    {
+        thread_state& state { local_state() };
+        target_ = state.current;
+        state = saved_;
+    }
+
+    counting_redirect(const counting_redirect&) = delete;
+    counting_redirect& operator=(const counting_redirect&) = delete;
+
+private:
+    counters& target_;
+    const thread_state saved_;
+};
+
+/**
+ * @brief position of the streambuf of ostream, or -1 if it has none or does
+ *   not report it
+ * @notes overloads as follows:
+ *   - std::basic_ostream
+ *   - default: other sinks, eg buffers::output_buffer
+ */
+template <typename CharType, typename TraitsType>
+static std::streamoff put_position(std::basic_ostream<CharType, TraitsType>& ostream)
+{
+    std::basic_streambuf<CharType, TraitsType>* const buf { ostream.rdbuf() };
+    return buf == nullptr ? -1 : static_cast<std::streamoff>(
+        buf->pubseekoff(0, std::ios_base::cur, std::ios_base::out));
+}
+
+template <typename StreamType>
+static auto put_position(StreamType& /*stream*/) -> std::enable_if_t<
+    !std::is_base_of<std::ios_base, StreamType>::value, std::streamoff>
+{
+    return -1;
+}
+
+}  // namespace detail
+
+/**
+ * @brief sets the sink to which the counters of each top-level call are
+ *   exported as it returns, on the thread that made it
+ * @notes not synchronized: set before streaming on other threads, and
+ *   make the sink itself thread safe if streaming on more than one
+ */
+inline void set_sink(sink_type sink)
+{
+    detail::sink() = std::move(sink);
+}
+
+/**
+ * @brief policy with no hooks, the default
+ */
+struct null_policy
+{
+    static constexpr bool enabled { false };
+
+    static void begin(direction /*dir*/) noexcept
+    {}
+    static void end(std::streamoff /*bytes*/) noexcept
+    {}
+    static void cancel() noexcept
+    {}
+    static void count_elements(std::size_t /*count*/) noexcept
+    {}
+    static void count_string(bool /*escaped*/) noexcept
+    {}
+    static void count_hex_escape() noexcept
+    {}
+    static void count_failed_probe() noexcept
+    {}
+};
+
+/**
+ * @brief policy counting events in thread local counters, which are
+ *   exported to the sink (see set_sink) at the end of each top-level call
+ */
+struct counting_policy
+{
+    static constexpr bool enabled { true };
+
+    /**
+     * @brief enters a container; at top level, starts new counters
+     */
+    static void begin(const direction dir)
+    {
+        detail::thread_state& state { detail::local_state() };
+        if (state.depth++ == 0)
+        {
+            state.current = counters {};
+            state.current.dir = dir;
+            state.start = std::chrono::steady_clock::now();
+        }
+    }
+
+    /**
+     * @brief leaves a container; at top level, exports the counters, with
+     *   bytes as counted by the caller (negative if unknown)
+     */
+    static void end(const std::streamoff bytes)
+    {
+        detail::thread_state& state { detail::local_state() };
+        if (--state.depth != 0)
+            return;
+        state.current.duration = std::chrono::steady_clock::now() - state.start;
+        state.current.bytes = bytes < 0 ? 0 : static_cast<std::size_t>(bytes);
+        detail::export_counters(state.current);
+    }
+
+    /**
+     * @brief leaves a container without exporting the counters, eg as a
+     *   parallel call falls back on another that counts anew
+     */
+    static void cancel()
+    {
+        --detail::local_state().depth;
+    }
+
+    static void count_elements(const std::size_t count)
+    {
+        detail::thread_state& state { detail::local_state() };
+        const std::size_t level { state.depth == 0 ? 0 :
+            std::min(state.depth, std::size_t { counters::max_depth }) - 1 };
+        state.current.elements[level] += count;
+    }
+
+    static void count_string(const bool escaped)
+    {
+        counters& current { detail::local_state().current };
+        ++(escaped ? current.escaped_strings : current.unescaped_strings);
+    }
+
+    static void count_hex_escape()
+    {
+        ++detail::local_state().current.hex_escapes_decoded;
+    }
+
+    static void count_failed_probe()
+    {
+        ++detail::local_state().current.failed_token_probes;
+    }
+};
+
+#ifdef CONTAINER_STREAM_IO_INSTRUMENTATION
+using policy = counting_policy;
+#else
+using policy = null_policy;
+#endif  // CONTAINER_STREAM_IO_INSTRUMENTATION
+
+/**
+ * @brief scope of each container printed by output::to_stream, which counts
+ *   the chars printed at top level
+ * @notes overloads as follows:
+ *   - default: policy enabled
+ *   - policy disabled: empty
+ */
+template <typename StreamType, typename PolicyType = policy,
+          bool Enabled = PolicyType::enabled>
+class output_scope
+{
+public:
+    explicit output_scope(StreamType& ostream) :
+        ostream_ { ostream },
+        start_ { detail::local_state().depth == 0 ?
+                 detail::put_position(ostream) : -1 }
+    {
+        PolicyType::begin(direction::output);
+    }
+
+    ~output_scope()
+    {
+        const std::streamoff end {
+            start_ < 0 ? -1 : detail::put_position(ostream_) };
+        PolicyType::end(end < 0 ? -1 : end - start_);
+    }
+
+    output_scope(const output_scope&) = delete;
+    output_scope& operator=(const output_scope&) = delete;
+
+private:
+    StreamType& ostream_;
+    const std::streamoff start_;
+};
+
+template <typename StreamType, typename PolicyType>
+class output_scope<StreamType, PolicyType, false>
+{
+public:
+    explicit output_scope(StreamType& /*ostream*/) noexcept
+    {}
+};
+
+/**
+ * @brief scope of each container parsed by input::from_stream
+ * @notes overloads as follows:
+ *   - default: policy enabled
+ *   - policy disabled: empty
+ */
+template <typename StreamType, typename PolicyType = policy,
+          bool Enabled = PolicyType::enabled>
+class input_scope
+{
+public:
+    explicit input_scope(StreamType& /*istream*/)
+    {
+        PolicyType::begin(direction::input);
+    }
+
+    ~input_scope()
+    {
+        if (cancelled_)
+            PolicyType::cancel();
+        else
+            PolicyType::end(-1);
+    }
+
+    input_scope(const input_scope&) = delete;
+    input_scope& operator=(const input_scope&) = delete;
+
+    /**
+     * @brief leaves the container without exporting, as the call falls
+     *   back on another that counts it anew
+     */
+    void cancel() noexcept
+    {
+        cancelled_ = true;
+    }
+
+private:
+    bool cancelled_ {};
+};
+
+template <typename StreamType, typename PolicyType>
+class input_scope<StreamType, PolicyType, false>
+{
+public:
+    explicit input_scope(StreamType& /*istream*/) noexcept
+    {}
+
+    void cancel() noexcept
+    {}
+};
+
+/**
+ * @brief counters of the workers of a parallel call (eg
+ *   output::to_stream_parallel), each counting on the thread it runs on as
+ *   if within the scope of the call, and merged into the counters of the
+ *   call on the thread that made it, so that the call is exported once
+ * @notes
+ *   - constructed within the scope of the call, on the thread that made it
+ *   - overloads as follows:
+ *     - default: policy enabled
+ *     - policy disabled: empty
+ */
+template <typename PolicyType = policy, bool Enabled = PolicyType::enabled>
+class worker_counters
+{
+public:
+    explicit worker_counters(const std::size_t worker_count) :
+        counters_ (worker_count), depth_ { detail::local_state().depth }
+    {}
+
+    /**
+     * @brief counts events on this thread into those of worker, for its
+     *   lifetime
+     */
+    class scope
+    {
+    public:
+        scope(worker_counters& owner, const std::size_t worker) :
+            redirect_ { owner.counters_[worker], owner.depth_ }
+        {}
+
+    private:
+        const detail::counting_redirect redirect_;
+    };
+
+    /**
+     * @brief adds the counters of all workers to those of the call, and
+     *   clears them
+     */
+    void merge()
+    {
+        for (counters& worker : counters_)
+        {
+            detail::add_counts(detail::local_state().current, worker);
+            worker = counters {};
+        }
+    }
+
+private:
+    std::vector<counters> counters_;
+    const std::size_t depth_;
+};
+
+template <typename PolicyType>
+class worker_counters<PolicyType, false>
+{
+public:
+    explicit worker_counters(std::size_t /*worker_count*/) noexcept
+    {}
+
+    class scope
+    {
+    public:
+        scope(worker_counters& /*owner*/, std::size_t /*worker*/) noexcept
+        {}
+    };
+
+    void merge() noexcept
+    {}
+};
+
+/**
+ * @brief counters of a top-level call made in steps (eg each
+ *   input::push_parser::feed), each counting on the thread it runs on as if
+ *   within the outermost container, exported once as the call ends
+ * @notes
+ *   - duration is that of the steps, excluding time between them
+ *   - overloads as follows:
+ *     - default: policy enabled
+ *     - policy disabled: empty
+ */
+template <typename PolicyType = policy, bool Enabled = PolicyType::enabled>
+class stepwise_scope
+{
+public:
+    explicit stepwise_scope(const direction dir)
+    {
+        counters_.dir = dir;
+    }
+
+    stepwise_scope(stepwise_scope&& other) noexcept :
+        counters_ { other.counters_ }, started_ { other.started_ },
+        ended_ { other.ended_ }
+    {
+        other.ended_ = true;
+    }
+
+    ~stepwise_scope()
+    {
+        end();
+    }
+
+    stepwise_scope(const stepwise_scope&) = delete;
+    stepwise_scope& operator=(const stepwise_scope&) = delete;
+
+    /**
+     * @brief counts events on this thread into those of the call, for its
+     *   lifetime
+     */
+    class step
+    {
+    public:
+        explicit step(stepwise_scope& call) :
+            redirect_ { call.counters_, 1 },
+            start_ { std::chrono::steady_clock::now() }
+        {
+            call.started_ = true;
+        }
+
+        ~step()
+        {
+            detail::local_state().current.duration +=
+                std::chrono::steady_clock::now() - start_;
+        }
+
+        step(const step&) = delete;
+        step& operator=(const step&) = delete;
+
+    private:
+        const detail::counting_redirect redirect_;
+        const std::chrono::steady_clock::time_point start_;
+    };
+
+    /**
+     * @brief exports the counters, once, if any step was made
+     */
+    void end()
+    {
+        if (started_ && !ended_)
+        {
+            ended_ = true;
+            detail::export_counters(counters_);
+        }
+    }
+
+    /**
+     * @brief ends the call, and begins counting the next
+     */
+    void reset()
+    {
+        end();
+        const direction dir { counters_.dir };
+        counters_ = counters {};
+        counters_.dir = dir;
+        started_ = ended_ = false;
+    }
+
+private:
+    counters counters_;
+    bool started_ {};
+    bool ended_ {};
+};
+
+template <typename PolicyType>
+class stepwise_scope<PolicyType, false>
+{
+public:
+    explicit stepwise_scope(direction /*dir*/) noexcept
+    {}
+
+    class step
+    {
+    public:
+        explicit step(stepwise_scope& /*call*/) noexcept
+        {}
+    };
+
+    void end() noexcept
+    {}
+
+    void reset() noexcept
+    {}
+};
+
+}  // namespace instrumentation
+
+/**
+ * @brief contains the nesting depth limit of to_stream/from_stream, which
+ *   fail before recursing past it
+ * @notes nesting of STL containers is bounded by their type, but elements of
+ *   recursive user types (eg a tree node streaming its vector of children)
+ *   nest as deep as their serialization, so without a limit untrusted input
+ *   can exhaust the stack, eg of a fiber or coroutine
+ */
+namespace nesting {
+
+namespace detail {
+
+/**
+ * @brief stream index getters for use with iword to set maxdepth, and to
+ *   count the containers currently being streamed
+ */
+inline int get_max_depth_i()
+{
+    static int i {std::ios_base::xalloc()};
+    return i;
+}
+
+inline int get_depth_i()
+{
+    static int i {std::ios_base::xalloc()};
+    return i;
+}
+
+/**
+ * @brief depth of a container being streamed, counting the outermost as 1,
+ *   and the limit set with maxdepth; carried by formatters to the
+ *   formatters of nested containers, so that only the outermost container
+ *   reads and counts itself in iword
+ * @notes depth is 0 if not carried, eg by formatters constructed by users
+ */
+struct level
+{
+    long depth;
+    long max_depth;
+
+    /**
+     * @brief level of the containers nested in this one, if carried
+     */
+    level nested() const noexcept
+    {
+        return level { depth > 0 ? depth + 1 : 0, max_depth };
+    }
+};
+
+/**
+ * @brief tests for formatters carrying the level of the container they
+ *   format, as returned by nesting_level()
+ */
+template <typename FormatterType, typename = void>
+struct carries_level : public std::false_type
+{};
+
+template <typename FormatterType>
+struct carries_level<FormatterType, std::void_t<
+    decltype(std::declval<const FormatterType&>().nesting_level())>>
+    : public std::true_type
+{};
+
+/**
+ * @brief level carried by formatter, if any
+ */
+template <typename FormatterType>
+static auto carried_level(const FormatterType& formatter) noexcept
+    -> std::enable_if_t<carries_level<FormatterType>::value, level>
+{
+    return formatter.nesting_level();
+}
+
+template <typename FormatterType>
+static auto carried_level(const FormatterType& /*formatter*/) noexcept
+    -> std::enable_if_t<!carries_level<FormatterType>::value, level>
+{
+    return level {};
+}
+
+/**
+ * @brief tests for element types streamed by code other than this library
+ *   (eg operator<< of a user type), which may stream nested containers of
+ *   its own, counted from iword
+ */
+template <typename ElementType>
+struct is_opaque_element : public std::integral_constant<bool,
+    !std::is_arithmetic<ElementType>::value &&
+    !traits::is_char_type<ElementType>::value &&
+    !traits::is_string_type<ElementType>::value &&
+    !traits::is_printable_as_container<ElementType>::value &&
+    !traits::is_parseable_as_container<ElementType>::value>
+{};
+
+/**
+ * @brief tests if any element of ContainerType may be opaque, taken to be
+ *   so for types of elements that are not known
+ */
+template <typename ContainerType, typename = void>
+struct has_opaque_elements : public std::true_type
+{};
+
+template <typename ContainerType>
+struct has_opaque_elements<ContainerType,
+                           std::void_t<typename ContainerType::value_type>>
+    : public is_opaque_element<
+        typename std::remove_cv<typename ContainerType::value_type>::type>
+{};
+
+template <typename ElementType, std::size_t ArraySize>
+struct has_opaque_elements<ElementType[ArraySize]>
+    : public is_opaque_element<typename std::remove_cv<ElementType>::type>
+{};
+
+template <typename FirstType, typename SecondType>
+struct has_opaque_elements<std::pair<FirstType, SecondType>>
+    : public std::integral_constant<bool,
+        is_opaque_element<typename std::remove_cv<FirstType>::type>::value ||
+        is_opaque_element<typename std::remove_cv<SecondType>::type>::value>
+{};
+
+/**
+ * @brief counts a container as being streamed with stream for its lifetime
+ * @notes
+ *   - overloads as follows:
+ *     - outermost: depth counted in iword, and limit read from it
+ *     - carried: level carried by the formatter of the container, if any,
+ *         written to iword only if elements may stream containers of their
+ *         own (see has_opaque_elements); otherwise counted as outermost
+ *   - buffers::input_buffer and buffers::output_buffer forward iword to
+ *       their streams, so nested containers count in the same stream
+ */
+template <typename StreamType>
+class depth_guard
+{
+public:
+    explicit depth_guard(StreamType& stream) :
+        depth_guard { stream, level {}, true }
+    {}
+
+    depth_guard(StreamType& stream, const level carried,
+                const bool opaque_elements) :
+        stream_ {}, level_ ( carried ), previous_ {}
+    {
+        if (level_.depth > 0 && !opaque_elements)
+            return;
+        if (level_.depth == 0)
+            level_.max_depth = stream.iword(get_max_depth_i());
+        // as iword references are invalidated by iword with other indices
+        long& depth { stream.iword(get_depth_i()) };
+        if (level_.depth == 0)
+            level_.depth = depth + 1;
+        stream_ = &stream;
+        previous_ = depth;
+        depth = level_.depth;
+    }
+
+    ~depth_guard()
+    {
+        if (stream_ != nullptr)
+            stream_->iword(get_depth_i()) = previous_;
+    }
+
+    depth_guard(const depth_guard&) = delete;
+    depth_guard& operator=(const depth_guard&) = delete;
+
+    /**
+     * @brief tests if the container is nested past the limit, if any
+     */
+    bool exceeded() const
+    {
+        return level_.max_depth > 0 && level_.depth > level_.max_depth;
+    }
+
+    /**
+     * @brief level of the container, to be carried by its formatter
+     */
+    level current() const
+    {
+        return level_;
+    }
+
+private:
+    StreamType* stream_;
+    level level_;
+    long previous_;
+};
+
+}  // namespace detail
+
+/**
+ * @brief argument of maxdepth, streamed to set the limit
+ */
+struct max_depth_setter
+{
+    long depth;
+};
+
+/**
+ * @brief parameterized iomanip to make streaming fail with failbit on
+ *   containers nested more than depth levels deep, counting the outermost
+ *   as 1; 0 sets no limit (default)
+ */
+inline max_depth_setter maxdepth(const std::size_t depth)
+{
+    return max_depth_setter { static_cast<long>(depth) };
+}
+
+template <typename CharType, typename TraitsType>
+std::basic_ostream<CharType, TraitsType>& operator<<(
+    std::basic_ostream<CharType, TraitsType>& ostream,
+    const max_depth_setter setter)
+{
+    ostream.iword(detail::get_max_depth_i()) = setter.depth;
+    return ostream;
+}
+
+template <typename CharType, typename TraitsType>
+std::basic_istream<CharType, TraitsType>& operator>>(
+    std::basic_istream<CharType, TraitsType>& istream,
+    const max_depth_setter setter)
+{
+    istream.iword(detail::get_max_depth_i()) = setter.depth;
+    return istream;
+}
+
+}  // namespace nesting
+
+/**
+ * @brief contains resources for string encoding/decoding
+ */
+namespace strings {
+
+/**
+ * @brief contains implementation of macros which generate compile-time string
+ *   or character literals templated by character type
+ * @notes adapted from: https://stackoverflow.com/a/60770220
+ */
+namespace compile_time {
+
+#if (__cplusplus >= 201703L)
+
+/**
+ * @brief C++17 implementation of CHAR_LITERAL
+ */
+template <typename CharType>
+constexpr const CharType char_literal(
+    [[maybe_unused]] const char ac,
+    [[maybe_unused]] const wchar_t wc,
+#if (__cplusplus > 201703L)
+    [[maybe_unused]] const char8_t u8c,
+#endif
+    [[maybe_unused]] const char16_t u16c,
+    [[maybe_unused]] const char32_t u32c)
+{
+    if      constexpr( std::is_same_v<CharType, char> )      return ac;
+    else if constexpr( std::is_same_v<CharType, wchar_t> )   return wc;
+#if (__cplusplus > 201703L)
+    else if constexpr( std::is_same_v<CharType, char8_t> )   return u8c;
+#endif
+    else if constexpr( std::is_same_v<CharType, char16_t> )  return u16c;
+    else if constexpr( std::is_same_v<CharType, char32_t> )  return u32c;
+}
+
+/**
+ * @brief C++17 implementation of STRING_LITERAL
+ */
+template <typename CharType,
+          std::size_t SizeAscii, std::size_t SizeWide,
+#if (__cplusplus > 201703L)
+         std::size_t SizeUTF8,
+#endif
+         std::size_t SizeUTF16, std::size_t SizeUTF32,
+         std::size_t Size = (
+         std::is_same_v<CharType, char>     ? SizeAscii :
+         std::is_same_v<CharType, wchar_t>  ? SizeWide  :
+#if (__cplusplus > 201703L)
+         std::is_same_v<CharType, char8_t>  ? SizeUTF8  :
+#endif
+         std::is_same_v<CharType, char16_t> ? SizeUTF16 :
+         std::is_same_v<CharType, char32_t> ? SizeUTF32 : 0 ) >
+constexpr auto string_literal(
+    [[maybe_unused]] const char (&as) [SizeAscii],
+    [[maybe_unused]] const wchar_t (&ws) [SizeWide],
+#if (__cplusplus > 201703L)
+    [[maybe_unused]] const char8_t (&u8s) [SizeUTF8],
+#endif
+    [[maybe_unused]] const char16_t (&u16s) [SizeUTF16],
+    [[maybe_unused]] const char32_t (&u32s) [SizeUTF32]
+        ) -> const CharType(&)[Size]
+{
+    if      constexpr( std::is_same_v<CharType, char> )     return as;
+    else if constexpr( std::is_same_v<CharType, wchar_t> )  return ws;
+#if (__cplusplus > 201703L)
+    else if constexpr( std::is_same_v<CharType, char8_t> )  return u8s;
+#endif
+    else if constexpr( std::is_same_v<CharType, char16_t> ) return u16s;
+    else if constexpr( std::is_same_v<CharType, char32_t> ) return u32s;
+}
+
+#else // __cplusplus < 201703L
+
+/**
+ * @brief C++11 implementation of CHAR_LITERAL
+ * @notes constepxr functions implicitly inline per C++11 standard:
+ *   https://stackoverflow.com/a/14391320
+ */
+template<typename CharType>
+constexpr CharType char_literal(
+    const char ac, const wchar_t wc, const char16_t u16c, const char32_t u32c);
+
+template<>
+constexpr char char_literal(
+    const char ac, const wchar_t /*wc*/, const char16_t /*u16c*/, const char32_t /*u32c*/)
+{
+    return ac;
+}
+
+template<>
+constexpr wchar_t char_literal(
+    const char /*ac*/, const wchar_t wc, const char16_t /*u16c*/, const char32_t /*u32c*/)
+{
+    return wc;
+}
+
+template<>
+constexpr char16_t char_literal(
+    const char /*ac*/, const wchar_t /*wc*/, const char16_t u16c, const char32_t /*u32c*/)
+{
+    return u16c;
+}
+
+template<>
+constexpr char32_t char_literal(
+    const char /*ac*/, const wchar_t /*wc*/, const char16_t /*u16c*/, const char32_t u32c)
+{
+    return u32c;
+}
+
+/**
+ * @brief C++11 implementation of STRING_LITERAL
+ * @notes partial function template specialization not allowed by standard, see:
+ *   https://stackoverflow.com/a/21218271, so instead using overloads each
+ *   templated by literal sizes and enabled by return char type
+ */
+template<typename CharType,
+         std::size_t SizeAscii, std::size_t SizeWide,
+         std::size_t SizeUTF16, std::size_t SizeUTF32>
+constexpr auto string_literal(
+    const char (&as)[SizeAscii], const wchar_t (&/*ws*/)[SizeWide],
+    const char16_t (&/*u16s*/)[SizeUTF16], const char32_t (&/*u32s*/)[SizeUTF32]
+    ) -> std::enable_if_t<
+        std::is_same<CharType, char>::value,
+        const char(&)[SizeAscii]>
+{
+    return as;
+}
+
+template<typename CharType,
+         std::size_t SizeAscii, std::size_t SizeWide,
+         std::size_t SizeUTF16, std::size_t SizeUTF32>
+constexpr auto string_literal(
+    const char (&/*as*/)[SizeAscii], const wchar_t (&ws)[SizeWide],
+    const char16_t (&/*u16s*/)[SizeUTF16], const char32_t (&/*u32s*/)[SizeUTF32]
+    ) -> std::enable_if_t<
+        std::is_same<CharType, wchar_t>::value,
+        const wchar_t(&)[SizeWide]>
+{
+    return ws;
+}
+
+template<typename CharType,
+         std::size_t SizeAscii, std::size_t SizeWide,
+         std::size_t SizeUTF16, std::size_t SizeUTF32>
+constexpr auto string_literal(
+    const char (&/*as*/)[SizeAscii], const wchar_t (&/*ws*/)[SizeWide],
+    const char16_t (&u16s)[SizeUTF16], const char32_t (&/*u32s*/)[SizeUTF32]
+    ) -> std::enable_if_t<
+        std::is_same<CharType, char16_t>::value,
+        const char16_t(&)[SizeUTF16]>
+{
+    return u16s;
+}
+
+template<typename CharType,
+         std::size_t SizeAscii, std::size_t SizeWide,
+         std::size_t SizeUTF16, std::size_t SizeUTF32>
+constexpr auto string_literal(
+    const char (&/*as*/)[SizeAscii], const wchar_t (&/*ws*/)[SizeWide],
+    const char16_t (&/*u16s*/)[SizeUTF16], const char32_t (&u32s)[SizeUTF32]
+    ) -> std::enable_if_t<
+        std::is_same<CharType, char32_t>::value,
+        const char32_t(&)[SizeUTF32]>
+{
+    return u32s;
+}
+
+#endif
+
+#if (__cplusplus > 201703L)
+
+#  define CHAR_LITERAL(CHAR_T, LITERAL) \
+    char_literal<CHAR_T>( LITERAL, L ## LITERAL, u8 ## LITERAL, \
+                          u ## LITERAL, U ## LITERAL )
+
+#  define STRING_LITERAL(CHAR_T, LITERAL) \
+    string_literal<CHAR_T>( LITERAL, L ## LITERAL, u8 ## LITERAL, \
+                            u ## LITERAL, U ## LITERAL )
+
+#else  // __cplusplus <= 201703L
+
+#  define CHAR_LITERAL(CHAR_T, LITERAL) \
+    char_literal<CHAR_T>( LITERAL, L ## LITERAL, u ## LITERAL, U ## LITERAL )
+
+#  define STRING_LITERAL(CHAR_T, LITERAL) \
+    string_literal<CHAR_T>( LITERAL, L ## LITERAL, u ## LITERAL, U ## LITERAL )
+
+#endif
+
+}  // namespace compile_time
+
+#if (__cplusplus >= 201703L)
+/**
+ * @brief owns copies of strings for std::basic_string_view container elements
+ *   which could not be parsed as views into the source (see viewarena)
+ * @notes
+ *   - chars are copied into large blocks, so that storing a string rarely
+ *       allocates
+ *   - views returned by store() remain valid until clear() or destruction
+ *   - store() may be called concurrently, eg by input::from_stream_parallel
+ */
+template <typename CharType>
+class view_arena
+{
+public:
+    view_arena() = default;
+    view_arena(const view_arena&) = delete;
+    view_arena& operator=(const view_arena&) = delete;
+
+    std::basic_string_view<CharType> store(
+        const std::basic_string_view<CharType> string)
+    {
+        const std::lock_guard<std::mutex> lock { mutex_ };
+        if (string.size() > remaining_)
+        {
+            const std::size_t block_size {
+                std::max(string.size(), min_block_size) };
+            blocks_.emplace_back(new CharType[block_size]);
+            next_ = blocks_.back().get();
+            remaining_ = block_size;
+        }
+        CharType* const first { next_ };
+        std::copy(string.begin(), string.end(), first);
+        next_ += string.size();
+        remaining_ -= string.size();
+        return { first, string.size() };
+    }
+
+    void clear()
+    {
+        const std::lock_guard<std::mutex> lock { mutex_ };
+        blocks_.clear();
+        next_ = nullptr;
+        remaining_ = 0;
+    }
+
+private:
+    static constexpr std::size_t min_block_size {
+        65536 / sizeof(CharType) };
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<CharType[]>> blocks_;
+    CharType* next_ {};
+    std::size_t remaining_ {};
+};
+
+#endif  // C++17
+/**
+ * @brief implementation details for quoted/literal
+ * @notes quoted/literal implementation (string_repr, operator<</>>(string_repr),
+ *   quoted(), literal()) is based on GNU ISO C++14 std::quoted (as seen in
+ *   headers `iomanip`, `bits/quoted_string.h`) and reworked here to add features
+ *   and allow use in C++11
+ */
+namespace detail {
+
+/**
+ * @brief labels for string representation type flag values
+ */
+enum class repr_type { literal, quoted, utf8 };
+
+/**
+ * @brief stream index getter for use with iword/pword to set literalrepr/
+ *   quotedrepr/utf8repr
+ */
+inline int get_manip_i()
+{
+    static int i {std::ios_base::xalloc()};
+    return i;
+}
+
+#if (__cplusplus >= 201703L)
+/**
+ * @brief stream index getter for use with pword to set viewarena, one per
+ *   char type of view_arena
+ */
+template <typename CharType>
+inline int get_view_arena_i()
+{
+    static int i {std::ios_base::xalloc()};
+    return i;
+}
+
+/**
+ * @brief returned by viewarena(), sets view_arena of a stream when streamed
+ */
+template <typename CharType>
+struct view_arena_setter
+{
+    view_arena<CharType>* arena;
+};
+
+template <typename StreamCharType, typename TraitsType, typename CharType>
+std::basic_istream<StreamCharType, TraitsType>& operator>>(
+    std::basic_istream<StreamCharType, TraitsType>& istream,
+    const view_arena_setter<CharType> setter)
+{
+    istream.pword(get_view_arena_i<CharType>()) = setter.arena;
+    return istream;
+}
+
+#endif  // C++17
+
+/**
+ * @brief classification of a 7-bit ASCII value, as used in literal encoding
+ *   and decoding
+ * @notes
+ *   - given Unicode code points below 0x7f map to 7-bit ASCII, classification
+ *       is the same for all char types
+ *   - legacy C trigraphs and "\?" -> '?' escaping ignored for now, see:
+ *       https://en.cppreference.com/w/cpp/language/escape
+ *       https://en.cppreference.com/w/c/language/operator_alternative
+ */
+struct ascii_char_class
+{
+    char escape_symbol;        // standard escape symbol for value, or 0 if none
+    signed char escape_value;  // value of value as escape symbol, or -1 if none
+    signed char hex_value;     // value of value as hex digit, or -1 if none
+    bool printable;            // printable in the "C" locale
+};
+
+/**
+ * @brief constexpr generators of ascii_char_class fields (single return
+ *   statements for C++11 compliance)
+ */
+constexpr char standard_escape_symbol(const std::size_t value)
+{
+    return value == '\a' ? 'a' : value == '\b' ? 'b' : value == '\f' ? 'f' :
+           value == '\n' ? 'n' : value == '\r' ? 'r' : value == '\t' ? 't' :
+           value == '\v' ? 'v' : value == '\0' ? '0' : '\0';
+}
+
+constexpr signed char standard_escape_value(const std::size_t symbol)
+{
+    return symbol == 'a' ? '\a' : symbol == 'b' ? '\b' : symbol == 'f' ? '\f' :
+           symbol == 'n' ? '\n' : symbol == 'r' ? '\r' : symbol == 't' ? '\t' :
+           symbol == 'v' ? '\v' : symbol == '0' ? '\0' : -1;
+}
+
+constexpr signed char hex_digit_value(const std::size_t digit)
+{
+    return (digit >= '0' && digit <= '9') ? static_cast<signed char>(digit - '0') :
+           (digit >= 'a' && digit <= 'f') ? static_cast<signed char>(digit - 'a' + 10) :
+           (digit >= 'A' && digit <= 'F') ? static_cast<signed char>(digit - 'A' + 10) :
+           -1;
+}
+
+constexpr ascii_char_class make_ascii_char_class(const std::size_t value)
+{
+    return { standard_escape_symbol(value), standard_escape_value(value),
+             hex_digit_value(value), value >= 0x20 && value < 0x7f };
+}
+
+/**
+ * @brief compile-time table of ascii_char_class indexed by 7-bit ASCII value,
+ *   used in place of runtime lookups (or std::isprint/isxdigit) when encoding
+ *   and decoding
+ */
+template <typename IndexSequence>
+struct ascii_char_class_table;
+
+template <std::size_t... Values>
+struct ascii_char_class_table<std::index_sequence<Values...>>
+{
+    static constexpr ascii_char_class values[sizeof...(Values)] {
+        make_ascii_char_class(Values)... };
+};
+
+#if (__cplusplus < 201703L)
+
+template <std::size_t... Values>
+constexpr ascii_char_class
+ascii_char_class_table<std::index_sequence<Values...>>::values[sizeof...(Values)];
+
+#endif  // pre-C++17
+
+using ascii_table = ascii_char_class_table<std::make_index_sequence<0x80>>;
+
+/**
+ * @brief tests for char (of any type) in 7-bit ASCII range, regardless of
+ *   signedness of char type
+ */
+template <typename CharType>
+constexpr bool is_ascii(const CharType c)
+{
+    return static_cast<typename std::make_unsigned<CharType>::type>(c) < 0x80;
+}
+
+/**
+ * @brief ascii_table lookups for char of any type, with values outside of
+ *   7-bit ASCII range treated as unprintable and not part of any escape
+ */
+template <typename CharType>
+constexpr bool is_printable_ascii(const CharType c)
+{
+    return is_ascii(c) && ascii_table::values[static_cast<std::size_t>(c)].printable;
+}
+
+template <typename CharType>
+constexpr char standard_escape_symbol_of(const CharType c)
+{
+    return is_ascii(c) ? ascii_table::values[static_cast<std::size_t>(c)].escape_symbol :
+                         '\0';
+}
+
+template <typename CharType>
+constexpr int standard_escape_value_of(const CharType c)
+{
+    return is_ascii(c) ? ascii_table::values[static_cast<std::size_t>(c)].escape_value :
+                         -1;
+}
+
+template <typename CharType>
+constexpr int hex_digit_value_of(const CharType c)
+{
+    return is_ascii(c) ? ascii_table::values[static_cast<std::size_t>(c)].hex_value :
+                         -1;
+}
+
+/**
+ * @brief contains vectorized kernels to find the next char in a string that
+ *   needs escaping, so that runs of chars that do not can be copied in bulk,
+ *   and the end of a run of digits, so that numbers can be decoded in bulk
+ *   (see numeric::detail::scan_numbers)
+ * @notes
+ *   - instruction set is chosen at compile time: AVX2 (if enabled, eg with
+ *       -mavx2,) SSE2, or NEON, with a scalar loop for any remainder shorter
+ *       than a vector; defining CONTAINER_STREAM_IO_NO_SIMD leaves only the
+ *       scalar loop
+ *   - each instruction set is wrapped in structs of lane operations
+ *       specialized by char size, so one kernel serves all char types
+ *   - printable range comparisons are signed, so that values outside of
+ *       7-bit ASCII range (negative when signed) compare as unprintable
+ */
+namespace simd {
+
+inline unsigned count_trailing_zeros(const uint64_t bits)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+}
+
+#ifdef CONTAINER_STREAM_IO_AVX2
+
+template <std::size_t CharSize>
+struct avx2_base
+{
+    using vector_type = __m256i;
+    static constexpr std::size_t size { 32 / CharSize };  // chars per vector
+
+    static vector_type load(const void* p)
+    {
+        return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+    }
+    static vector_type bit_or(const vector_type a, const vector_type b)
+    {
+        return _mm256_or_si256(a, b);
+    }
+    static vector_type bit_and_not(const vector_type a, const vector_type b)
+    {
+        return _mm256_andnot_si256(_mm256_and_si256(a, b), _mm256_set1_epi8(-1));
+    }
+    static int first_set(const vector_type mask)
+    {
+        const uint32_t bits { static_cast<uint32_t>(_mm256_movemask_epi8(mask)) };
+        return bits ? static_cast<int>(count_trailing_zeros(bits) / CharSize) : -1;
+    }
+};
+
+template <std::size_t CharSize>
+struct avx2;
+
+template <>
+struct avx2<1> : public avx2_base<1>
+{
+    static vector_type splat(const uint32_t v) { return _mm256_set1_epi8(static_cast<char>(v)); }
+    static vector_type eq(const vector_type a, const vector_type b) { return _mm256_cmpeq_epi8(a, b); }
+    static vector_type gt(const vector_type a, const vector_type b) { return _mm256_cmpgt_epi8(a, b); }
+};
+
+template <>
+struct avx2<2> : public avx2_base<2>
+{
+    static vector_type splat(const uint32_t v) { return _mm256_set1_epi16(static_cast<short>(v)); }
+    static vector_type eq(const vector_type a, const vector_type b) { return _mm256_cmpeq_epi16(a, b); }
+    static vector_type gt(const vector_type a, const vector_type b) { return _mm256_cmpgt_epi16(a, b); }
+};
+
+template <>
+struct avx2<4> : public avx2_base<4>
+{
+    static vector_type splat(const uint32_t v) { return _mm256_set1_epi32(static_cast<int>(v)); }
+    static vector_type eq(const vector_type a, const vector_type b) { return _mm256_cmpeq_epi32(a, b); }
+    static vector_type gt(const vector_type a, const vector_type b) { return _mm256_cmpgt_epi32(a, b); }
+};
+
+#endif  // CONTAINER_STREAM_IO_AVX2
+#ifdef CONTAINER_STREAM_IO_SSE2
+
+template <std::size_t CharSize>
+struct sse2_base
+{
+    using vector_type = __m128i;
+    static constexpr std::size_t size { 16 / CharSize };  // chars per vector
+
+    static vector_type load(const void* p)
+    {
+        return _mm_loadu_si128(static_cast<const __m128i*>(p));
+    }
+    static vector_type bit_or(const vector_type a, const vector_type b)
+    {
+        return _mm_or_si128(a, b);
+    }
+    static vector_type bit_and_not(const vector_type a, const vector_type b)
+    {
+        return _mm_andnot_si128(_mm_and_si128(a, b), _mm_set1_epi8(-1));
+    }
+    static int first_set(const vector_type mask)
+    {
+        const uint32_t bits { static_cast<uint32_t>(_mm_movemask_epi8(mask)) };
+        return bits ? static_cast<int>(count_trailing_zeros(bits) / CharSize) : -1;
+    }
+};
+
+template <std::size_t CharSize>
+struct sse2;
+
+template <>
+struct sse2<1> : public sse2_base<1>
+{
+    static vector_type splat(const uint32_t v) { return _mm_set1_epi8(static_cast<char>(v)); }
+    static vector_type eq(const vector_type a, const vector_type b) { return _mm_cmpeq_epi8(a, b); }
+    static vector_type gt(const vector_type a, const vector_type b) { return _mm_cmpgt_epi8(a, b); }
+};
+
+template <>
+struct sse2<2> : public sse2_base<2>
+{
+    static vector_type splat(const uint32_t v) { return _mm_set1_epi16(static_cast<short>(v)); }
+    static vector_type eq(const vector_type a, const vector_type b) { return _mm_cmpeq_epi16(a, b); }
+    static vector_type gt(const vector_type a, const vector_type b) { return _mm_cmpgt_epi16(a, b); }
+};
+
+template <>
+struct sse2<4> : public sse2_base<4>
+{
+    static vector_type splat(const uint32_t v) { return _mm_set1_epi32(static_cast<int>(v)); }
+    static vector_type eq(const vector_type a, const vector_type b) { return _mm_cmpeq_epi32(a, b); }
+    static vector_type gt(const vector_type a, const vector_type b) { return _mm_cmpgt_epi32(a, b); }
+};
+
+#endif  // CONTAINER_STREAM_IO_SSE2
+#ifdef CONTAINER_STREAM_IO_NEON
+
+template <std::size_t CharSize>
+struct neon;
+
+template <>
+struct neon<1>
+{
+    using vector_type = uint8x16_t;
+    static constexpr std::size_t size { 16 };  // chars per vector
+
+    static vector_type load(const void* p) { return vld1q_u8(static_cast<const uint8_t*>(p)); }
+    static vector_type splat(const uint32_t v) { return vdupq_n_u8(static_cast<uint8_t>(v)); }
+    static vector_type eq(const vector_type a, const vector_type b) { return vceqq_u8(a, b); }
+    static vector_type gt(const vector_type a, const vector_type b)
+    {
+        return vcgtq_s8(vreinterpretq_s8_u8(a), vreinterpretq_s8_u8(b));
+    }
+    static vector_type bit_or(const vector_type a, const vector_type b) { return vorrq_u8(a, b); }
+    static vector_type bit_and_not(const vector_type a, const vector_type b)
+    {
+        return vmvnq_u8(vandq_u8(a, b));
+    }
+    static int first_set(const vector_type mask)
+    {
+        // narrowing shift leaves 4 bits per lane
+        const uint64_t bits { vget_lane_u64(vreinterpret_u64_u8(
+            vshrn_n_u16(vreinterpretq_u16_u8(mask), 4)), 0) };
+        return bits ? static_cast<int>(count_trailing_zeros(bits) / 4) : -1;
+    }
+};
+
+template <>
+struct neon<2>
+{
+    using vector_type = uint16x8_t;
+    static constexpr std::size_t size { 8 };  // chars per vector
+
+    static vector_type load(const void* p) { return vld1q_u16(static_cast<const uint16_t*>(p)); }
+    static vector_type splat(const uint32_t v) { return vdupq_n_u16(static_cast<uint16_t>(v)); }
+    static vector_type eq(const vector_type a, const vector_type b) { return vceqq_u16(a, b); }
+    static vector_type gt(const vector_type a, const vector_type b)
+    {
+        return vcgtq_s16(vreinterpretq_s16_u16(a), vreinterpretq_s16_u16(b));
+    }
+    static vector_type bit_or(const vector_type a, const vector_type b) { return vorrq_u16(a, b); }
+    static vector_type bit_and_not(const vector_type a, const vector_type b)
+    {
+        return vmvnq_u16(vandq_u16(a, b));
+    }
+    static int first_set(const vector_type mask)
+    {
+        // narrowing leaves 8 bits per lane
+        const uint64_t bits { vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(mask)), 0) };
+        return bits ? static_cast<int>(count_trailing_zeros(bits) / 8) : -1;
+    }
+};
+
+template <>
+struct neon<4>
+{
+    using vector_type = uint32x4_t;
+    static constexpr std::size_t size { 4 };  // chars per vector
+
+    static vector_type load(const void* p) { return vld1q_u32(static_cast<const uint32_t*>(p)); }
+    static vector_type splat(const uint32_t v) { return vdupq_n_u32(v); }
+    static vector_type eq(const vector_type a, const vector_type b) { return vceqq_u32(a, b); }
+    static vector_type gt(const vector_type a, const vector_type b)
+    {
+        return vcgtq_s32(vreinterpretq_s32_u32(a), vreinterpretq_s32_u32(b));
+    }
+    static vector_type bit_or(const vector_type a, const vector_type b) { return vorrq_u32(a, b); }
+    static vector_type bit_and_not(const vector_type a, const vector_type b)
+    {
+        return vmvnq_u32(vandq_u32(a, b));
+    }
+    static int first_set(const vector_type mask)
+    {
+        // narrowing leaves 16 bits per lane
+        const uint64_t bits { vget_lane_u64(vreinterpret_u64_u16(vmovn_u32(mask)), 0) };
+        return bits ? static_cast<int>(count_trailing_zeros(bits) / 16) : -1;
+    }
+};
+
+#endif  // CONTAINER_STREAM_IO_NEON
+
+/**
+ * @brief scans whole vectors of [first, last) for delim, escape, or (if
+ *   Literal) chars outside of printable 7-bit ASCII
+ * @return pointer to first match, or if none is found, to the remainder of
+ *   the range too short to fill a vector
+ */
+template <typename Ops, bool Literal, typename CharType>
+static const CharType* find_escape_blocks(
+    const CharType* first, const CharType* last,
+    const CharType delim, const CharType escape, bool& matched)
+{
+    using vector_type = typename Ops::vector_type;
+    const vector_type delims { Ops::splat(static_cast<uint32_t>(delim)) };
+    const vector_type escapes { Ops::splat(static_cast<uint32_t>(escape)) };
+    const vector_type below_printable { Ops::splat(0x1f) };
+    const vector_type above_printable { Ops::splat(0x7f) };
+
+    matched = false;
+    for (; static_cast<std::size_t>(last - first) >= Ops::size; first += Ops::size)
+    {
+        const vector_type chars { Ops::load(first) };
+        vector_type mask { Ops::bit_or(Ops::eq(chars, delims),
+                                       Ops::eq(chars, escapes)) };
+        if (Literal)
+            mask = Ops::bit_or(mask, Ops::bit_and_not(
+                                   Ops::gt(chars, below_printable),
+                                   Ops::gt(above_printable, chars)));
+        const int index { Ops::first_set(mask) };
+        if (index >= 0)
+        {
+            matched = true;
+            return first + index;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief finds first char in [first, last) that is delim, escape, or (if
+ *   Literal) outside of printable 7-bit ASCII, or returns last
+ */
+template <bool Literal, typename CharType>
+static const CharType* find_escape(
+    const CharType* first, const CharType* last,
+    const CharType delim, const CharType escape)
+{
+    bool matched {};
+#ifdef CONTAINER_STREAM_IO_AVX2
+    first = find_escape_blocks<avx2<sizeof(CharType)>, Literal>(
+        first, last, delim, escape, matched);
+    if (matched)
+        return first;
+#endif
+#if defined(CONTAINER_STREAM_IO_SSE2)
+    first = find_escape_blocks<sse2<sizeof(CharType)>, Literal>(
+        first, last, delim, escape, matched);
+#elif defined(CONTAINER_STREAM_IO_NEON)
+    first = find_escape_blocks<neon<sizeof(CharType)>, Literal>(
+        first, last, delim, escape, matched);
+#endif
+    if (matched)
+        return first;
+    for (; first != last; ++first)
+    {
+        if (*first == delim || *first == escape ||
+            (Literal && !is_printable_ascii(*first)))
+            break;
+    }
+    return first;
+}
+
+/**
+ * @brief scans whole vectors of [first, last) for chars other than '0'-'9'
+ * @return pointer to first match, or if none is found, to the remainder of
+ *   the range too short to fill a vector
+ */
+template <typename Ops, typename CharType>
+static const CharType* find_non_digit_blocks(
+    const CharType* first, const CharType* last, bool& matched)
+{
+    using vector_type = typename Ops::vector_type;
+    const vector_type below_digits { Ops::splat('0' - 1) };
+    const vector_type above_digits { Ops::splat('9' + 1) };
+
+    matched = false;
+    for (; static_cast<std::size_t>(last - first) >= Ops::size; first += Ops::size)
+    {
+        const vector_type chars { Ops::load(first) };
+        const int index { Ops::first_set(Ops::bit_and_not(
+            Ops::gt(chars, below_digits), Ops::gt(above_digits, chars))) };
+        if (index >= 0)
+        {
+            matched = true;
+            return first + index;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief finds first char in [first, last) other than '0'-'9', or returns
+ *   last
+ * @notes AVX2 is not used, as most numbers end within the first SSE2/NEON
+ *   vector
+ */
+template <typename CharType>
+static const CharType* find_non_digit(
+    const CharType* first, const CharType* last)
+{
+    bool matched {};
+#if defined(CONTAINER_STREAM_IO_SSE2)
+    first = find_non_digit_blocks<sse2<sizeof(CharType)>>(first, last, matched);
+#elif defined(CONTAINER_STREAM_IO_NEON)
+    first = find_non_digit_blocks<neon<sizeof(CharType)>>(first, last, matched);
+#endif
+    if (matched)
+        return first;
+    for (; first != last; ++first)
+    {
+        if (*first < CharType('0') || *first > CharType('9'))
+            break;
+    }
+    return first;
+}
+
+}  // namespace simd
+
+/**
+ * @brief finds next char in quoted encoding needing escape (delim or escape)
+ */
+template <typename CharType>
+inline const CharType* find_quoted_escape(
+    const CharType* first, const CharType* last,
+    const CharType delim, const CharType escape)
+{
+    return simd::find_escape<false>(first, last, delim, escape);
+}
+
+/**
+ * @brief finds next char in literal encoding needing escape (delim, escape,
+ *   or not printable 7-bit ASCII)
+ */
+template <typename CharType>
+inline const CharType* find_literal_escape(
+    const CharType* first, const CharType* last,
+    const CharType delim, const CharType escape)
+{
+    return simd::find_escape<true>(first, last, delim, escape);
+}
+
+/**
+ * @brief string representation, contains data necessary to istream/ostream a
+ *   a quoted/literal string encoding
+ */
+template <typename StringType, typename CharType>
+struct string_repr
+{
+    // TBD change to SFINAE with enable_if
+    static_assert(std::is_pointer<StringType>::value ||
+                  std::is_reference<StringType>::value,
+                  "String type must be a pointer or reference");
+
+    StringType string;
+    CharType delim;
+    CharType escape;
+    repr_type type;
+
+    /**
+     * @brief writes encoded string to a sink providing put(), write(), and
+     *   setstate(), eg buffers::output_buffer
+     */
+    template <typename SinkType>
+    void encode(SinkType& sink) const;
+
+    /**
+     * @brief reads encoded string from a source providing the window
+     *   interface of buffers::input_buffer, and assigns it to the represented
+     *   (non-const) string or char
+     */
+    template <typename SourceType>
+    void decode(SourceType& source) const;
+
+    string_repr() = delete;
+    string_repr(const StringType str, const CharType dlm,
+                const CharType esc, const repr_type typ) :
+        string{str}, delim{dlm}, escape{esc}, type{typ}
+    {
+        if (type == repr_type::literal &&
+            (!is_printable_ascii(dlm) || !is_printable_ascii(esc)))
+            throw(std::invalid_argument(
+                      "literal delim and escape must be printable 7-bit ASCII characters"));
+    }
+
+    string_repr& operator=(string_repr&) = delete;
+};
+
+/**
+ * @brief helper to string_repr::encode, gets contiguous range of chars to
+ *   encode from the represented string
+ * @notes overloads as follows:
+ *   - (const) basic_string&
+ *   - (const) basic_string_view&
+ *   - single-char: (const) CharT&
+ *   - C string: (const) CharT*
+ */
+template <typename CharType, typename TraitsType, typename AllocType>
+static std::pair<const CharType*, std::size_t> string_range(
+    const std::basic_string<CharType, TraitsType, AllocType>& string)
+{
+    return { string.data(), string.size() };
+}
+
+#if (__cplusplus >= 201703L)
+template <typename CharType, typename TraitsType>
+static std::pair<const CharType*, std::size_t> string_range(
+    const std::basic_string_view<CharType, TraitsType>& string_view)
+{
+    return { string_view.data(), string_view.size() };
+}
+
+#endif  // C++17 and above
+template <typename CharType>
+static auto string_range(const CharType& c
+    ) -> std::enable_if_t<
+        traits::is_char_type<CharType>::value,
+        std::pair<const CharType*, std::size_t>>
+{
+    return { &c, 1 };
+}
+
+template <typename CharType>
+static std::pair<const CharType*, std::size_t> string_range(
+    const CharType* string)
+{
+    return { string, std::char_traits<CharType>::length(string) };
+}
+
+/**
+ * @brief helper to string_repr::encode, writes literal prefix
+ */
+template <typename StreamCharType, typename StringCharType, typename SinkType>
+static void insert_literal_prefix(SinkType& sink)
+{
+    using namespace compile_time;  // char_literal, string_literal
+    if (std::is_same<StringCharType, wchar_t>::value)
+        sink.put(CHAR_LITERAL(StreamCharType, 'L'));
+#if (__cplusplus > 201703L)
+    if (std::is_same<StringCharType, char8_t>::value)
+        sink << STRING_LITERAL(StreamCharType, "u8");
+#endif
+    if (std::is_same<StringCharType, char16_t>::value)
+        sink.put(CHAR_LITERAL(StreamCharType, 'u'));
+    if (std::is_same<StringCharType, char32_t>::value)
+        sink.put(CHAR_LITERAL(StreamCharType, 'U'));
+}
+
+/**
+ * @brief helper to string_repr::encode, writes a run of chars that need no
+ *   escaping
+ * @notes overloads as follows:
+ *   - matching sink and string char types: copied as a single block
+ *   - differing char types: converted one at a time
+ */
+template <typename SinkType, typename StringCharType>
+static auto insert_run(
+    SinkType& sink, const StringCharType* first, const StringCharType* last
+    ) -> std::enable_if_t<
+        std::is_same<typename SinkType::char_type, StringCharType>::value,
+        void>
+{
+    if (first != last)
+        sink.write(first, static_cast<std::size_t>(last - first));
+}
+
+template <typename SinkType, typename StringCharType>
+static auto insert_run(
+    SinkType& sink, const StringCharType* first, const StringCharType* last
+    ) -> std::enable_if_t<
+        !std::is_same<typename SinkType::char_type, StringCharType>::value,
+        void>
+{
+    using stream_char_type = typename SinkType::char_type;
+    for (; first != last; ++first)
+        sink.put(stream_char_type(*first));
+}
+
+/**
+ * @brief helper to string_repr::encode, writes one escaped character from a
+ *   literal string representation
+ */
+template <typename SinkType, typename StringType, typename StringCharType>
+static void insert_escaped_char(
+    SinkType& sink,
+    const string_repr<StringType, StringCharType>& repr,
+    const StringCharType c)
+{
+    using stream_char_type = typename SinkType::char_type;
+    static constexpr uint32_t hex_mask {
+        (sizeof(StringCharType) == 1) ? 0xff :
+        (sizeof(StringCharType) == 2) ? 0xffff :
+                                        0xffffffff };
+    static constexpr std::size_t hex_length { sizeof(StringCharType) * 2 };
+    static constexpr char hex_digits[] { "0123456789abcdef" };
+
+    if (is_printable_ascii(c))
+    {
+        // literal_repr ctor enforces ASCII-printable delim and escape
+        if (c == repr.delim || c == repr.escape)
+            sink.put(stream_char_type(repr.escape));
+        sink.put(stream_char_type(c));
+        return;
+    }
+    sink.put(stream_char_type(repr.escape));
+    const char symbol { standard_escape_symbol_of(c) };
+    if (symbol != '\0')
+    {
+        sink.put(stream_char_type(symbol));
+        return;
+    }
+    // custom hex escape sequence, fixed width proportional to char size
+    stream_char_type hex_escape[hex_length + 1];
+    hex_escape[0] = stream_char_type('x');
+    uint32_t value { hex_mask & static_cast<uint32_t>(c) };
+    for (std::size_t i { hex_length }; i > 0; --i, value >>= 4)
+        hex_escape[i] = stream_char_type(hex_digits[value & 0xf]);
+    sink.write(hex_escape, hex_length + 1);
+}
+
+/**
+ * @brief helper to insert_utf8_char, writes a code point as UTF-8
+ */
+template <typename SinkType>
+static void insert_code_point(SinkType& sink, const uint32_t code_point)
+{
+    using stream_char_type = typename SinkType::char_type;
+
+    stream_char_type bytes[4];
+    std::size_t length {};
+    if (code_point < 0x800)
+    {
+        bytes[length++] = stream_char_type(0xc0 | (code_point >> 6));
+    }
+    else if (code_point < 0x10000)
+    {
+        bytes[length++] = stream_char_type(0xe0 | (code_point >> 12));
+        bytes[length++] = stream_char_type(0x80 | ((code_point >> 6) & 0x3f));
+    }
+    else
+    {
+        bytes[length++] = stream_char_type(0xf0 | (code_point >> 18));
+        bytes[length++] = stream_char_type(0x80 | ((code_point >> 12) & 0x3f));
+        bytes[length++] = stream_char_type(0x80 | ((code_point >> 6) & 0x3f));
+    }
+    bytes[length++] = stream_char_type(0x80 | (code_point & 0x3f));
+    sink.write(bytes, length);
+}
+
+/**
+ * @brief helper to string_repr::encode, writes the char at p from a utf8
+ *   string representation (see utf8repr), with non-ASCII code points
+ *   transcoded to UTF-8 rather than hex escaped
+ * @notes overloads as follows:
+ *   - single byte string chars: non-ASCII bytes written as they are, eg of
+ *       strings already holding UTF-8
+ *   - default: UTF-16 surrogate pairs (of 2 byte string chars) combined, and
+ *       chars that are not valid code points (eg unpaired surrogates) hex
+ *       escaped as in literal representations
+ * @return position after the encoded char(s)
+ */
+template <typename SinkType, typename StringType, typename StringCharType>
+static auto insert_utf8_char(
+    SinkType& sink,
+    const string_repr<StringType, StringCharType>& repr,
+    const StringCharType* p, const StringCharType* /*last*/
+    ) -> std::enable_if_t<
+        sizeof(StringCharType) == 1,
+        const StringCharType*>
+{
+    using stream_char_type = typename SinkType::char_type;
+
+    if (is_ascii(*p))
+        insert_escaped_char(sink, repr, *p);
+    else
+        sink.put(stream_char_type(*p));
+    return p + 1;
+}
+
+template <typename SinkType, typename StringType, typename StringCharType>
+static auto insert_utf8_char(
+    SinkType& sink,
+    const string_repr<StringType, StringCharType>& repr,
+    const StringCharType* p, const StringCharType* last
+    ) -> std::enable_if_t<
+        sizeof(StringCharType) != 1,
+        const StringCharType*>
+{
+    static constexpr uint32_t unit_mask {
+        (sizeof(StringCharType) == 2) ? 0xffff : 0xffffffff };
+
+    uint32_t code_point { unit_mask & static_cast<uint32_t>(*p) };
+    const StringCharType* next { p + 1 };
+    if (sizeof(StringCharType) == 2 &&
+        code_point >= 0xd800 && code_point < 0xdc00 && next != last)
+    {
+        const uint32_t low { unit_mask & static_cast<uint32_t>(*next) };
+        if (low >= 0xdc00 && low < 0xe000)
+        {
+            code_point = 0x10000 + ((code_point - 0xd800) << 10) + (low - 0xdc00);
+            ++next;
+        }
+    }
+    if (code_point < 0x80 || (code_point >= 0xd800 && code_point < 0xe000) ||
+        code_point > 0x10ffff)
+    {
+        insert_escaped_char(sink, repr, *p);
+        return p + 1;
+    }
+    insert_code_point(sink, code_point);
+    return next;
+}
+
+// TBD maybe throw exeception rather than set failbit on quoted char size failure?
+/**
+ * @notes
+ *   - unescaped runs of chars are written to the sink in single blocks
+ *   - utf8 representations are only transcoded for sinks of single byte
+ *       chars, and are otherwise encoded as literal representations
+ */
+template <typename StringType, typename CharType>
+template <typename SinkType>
+void string_repr<StringType, CharType>::encode(SinkType& sink) const
+{
+    using stream_char_type = typename SinkType::char_type;
+
+    if (type == repr_type::quoted &&
+        sizeof(stream_char_type) < sizeof(CharType))
+    {
+        sink.setstate(std::ios_base::failbit);
+        return;
+    }
+    const auto range (string_range(string));
+    const CharType* run { range.first };
+    const CharType* const end { range.first + range.second };
+
+    bool escaped {};
+
+    insert_literal_prefix<stream_char_type, CharType>(sink);
+    sink.put(stream_char_type(delim));
+    if (type == repr_type::quoted)
+    {
+        for (const CharType* p { find_quoted_escape(run, end, delim, escape) };
+             p != end; p = find_quoted_escape(p + 1, end, delim, escape))
+        {
+            escaped = true;
+            // escaped char itself begins next run
+            insert_run(sink, run, p);
+            sink.put(stream_char_type(escape));
+            run = p;
+        }
+    }
+    else
+    {
+        const bool transcoded {
+            type == repr_type::utf8 && sizeof(stream_char_type) == 1 };
+        for (const CharType* p { find_literal_escape(run, end, delim, escape) };
+             p != end; p = find_literal_escape(run, end, delim, escape))
+        {
+            escaped = true;
+            insert_run(sink, run, p);
+            if (transcoded)
+            {
+                run = insert_utf8_char(sink, *this, p, end);
+                continue;
+            }
+            insert_escaped_char(sink, *this, *p);
+            run = p + 1;
+        }
+    }
+    insert_run(sink, run, end);
+    sink.put(stream_char_type(delim));
+    instrumentation::policy::count_string(escaped);
+}
+
+/**
+ * @brief ostream operator for string representations
+ * @notes
+ *   - encodes directly to the streambuf through a buffers::output_buffer,
+ *       rather than through an intermediate basic_ostringstream
+ *   - as with std::quoted, any field width set on the ostream applies to the
+ *       encoding as a whole, which in that case does require encoding to an
+ *       intermediate string
+ */
+template<typename StreamCharType, typename StringType, typename StringCharType>
+std::basic_ostream<StreamCharType>& operator<<(
+    std::basic_ostream<StreamCharType>& ostream,
+    const string_repr<StringType, StringCharType>& repr)
+{
+    if (ostream.width() > 0)
+    {
+        std::basic_ostringstream<StreamCharType> oss;
+        oss << repr;
+        if (oss.fail())
+        {
+            ostream.setstate(std::ios_base::failbit);
+            return ostream;
+        }
+        return ostream << oss.str();
+    }
+    buffers::output_buffer<StreamCharType> buffer { ostream };
+    if (buffer.good())
+        repr.encode(buffer);
+    buffer.flush();
+    return ostream;
+}
+
+/**
+ * @brief helper to string_repr::decode, decodes/validates a literal prefix
+ *   matching the target char type
+ */
+template<typename StringCharType, typename SourceType>
+static void extract_literal_prefix(SourceType& source)
+{
+    using stream_char_type = typename SourceType::char_type;
+
+    if (std::is_same<StringCharType, wchar_t>::value &&
+        source.get() != stream_char_type('L'))
+        source.setstate(std::ios_base::failbit);
+
+#if (__cplusplus > 201703L)
+    if (std::is_same<StringCharType, char8_t>::value &&
+        (source.get() != stream_char_type('u') ||
+         source.get() != stream_char_type('8')))
+        source.setstate(std::ios_base::failbit);
+#endif
+
+    if (std::is_same<StringCharType, char16_t>::value &&
+        source.get() != stream_char_type('u'))
+        source.setstate(std::ios_base::failbit);
+
+    if (std::is_same<StringCharType, char32_t>::value &&
+        source.get() != stream_char_type('U'))
+        source.setstate(std::ios_base::failbit);
+}
+
+/**
+ * @brief helper to string_repr::decode, decodes a hex escaped value and
+ *   validates that it matches the width of the target char type
+ */
+template<typename StringCharType, typename SourceType>
+static uint32_t extract_fixed_width_hex_value(SourceType& source)
+{
+    using stream_char_type = typename SourceType::char_type;
+    static constexpr uint32_t hex_length { sizeof(StringCharType) * 2 };
+
+    // malformed hex strings could have values larger than StreamCharType max,
+    //   with unpredictable overflows, so we need to pre-screen one by one
+    uint32_t value {};
+    uint32_t i {};
+    for (; i < hex_length; ++i)
+    {
+        const auto c (source.get());
+        if (!source.good())
+            break;
+        const int digit { hex_digit_value_of(stream_char_type(c)) };
+        if (digit < 0)
+            break;
+        value = (value << 4) | static_cast<uint32_t>(digit);
+    }
+    if (i != hex_length)
+        source.setstate(std::ios_base::failbit);
+    else
+        instrumentation::policy::count_hex_escape();
+    return value;
+}
+
+/**
+ * @brief helper to string_repr::decode, appends a run of decoded chars
+ * @notes overloads as follows:
+ *   - stream and string char types are the same: appended as a block
+ *   - default: converted char by char
+ */
+template <typename CharType>
+static void append_run(std::basic_string<CharType>& buffer,
+                       const CharType* first, const CharType* last)
+{
+    buffer.append(first, last);
+}
+
+template <typename StringCharType, typename StreamCharType>
+static void append_run(std::basic_string<StringCharType>& buffer,
+                       const StreamCharType* first, const StreamCharType* last)
+{
+    for (; first != last; ++first)
+        buffer += StringCharType(*first);
+}
+
+/**
+ * @brief helper to string_repr::decode, encapsulates main quoted representation
+ *   decoding loop
+ * @notes runs of unescaped chars are found with find_quoted_escape() and
+ *   appended a window at a time
+ */
+template<typename SourceType, typename StringType, typename StringCharType>
+static void extract_quoted_repr(
+    SourceType& source, const string_repr<StringType, StringCharType>& repr,
+    std::basic_string<StringCharType>& buffer)
+{
+    using stream_char_type = typename SourceType::char_type;
+    const stream_char_type delim { stream_char_type(repr.delim) };
+    const stream_char_type escape { stream_char_type(repr.escape) };
+
+    while (source.fill_window())
+    {
+        const stream_char_type* const first { source.window_begin() };
+        const stream_char_type* const last { source.window_end() };
+        const stream_char_type* const p {
+            find_quoted_escape(first, last, delim, escape) };
+        const stream_char_type* const eof_value {
+            source.find_eof_value(first, p) };
+        append_run(buffer, first, eof_value);
+        source.consume(static_cast<std::size_t>(eof_value - first));
+        if (eof_value != p)
+        {
+            source.setstate(std::ios_base::eofbit);
+            break;
+        }
+        if (p == last)
+            continue;
+        const stream_char_type c { *p };
+        source.consume(1);
+        if (c == delim)
+            return;
+        const stream_char_type escaped ( source.get() );
+        if (!source.good())
+            break;
+        if (escaped != escape && escaped != delim)
+            break;  // invalid quoted encoding
+        buffer += StringCharType(escaped);
+    }
+    source.setstate(std::ios_base::failbit);
+}
+
+/**
+ * @brief helper to extract_literal_repr, decodes a non-ASCII char of a utf8
+ *   string representation (see utf8repr), beginning with lead, and appends it
+ * @notes overloads as follows:
+ *   - single byte string chars: byte appended as it is
+ *   - default: UTF-8 sequence validated (no overlong encodings, surrogates,
+ *       or values past U+10FFFF) and decoded to a code point, which is
+ *       appended as a UTF-16 surrogate pair for 2 byte string chars
+ * @return false if the sequence is invalid
+ */
+template <typename StringCharType, typename SourceType>
+static auto extract_utf8_char(
+    SourceType& /*source*/, const typename SourceType::char_type lead,
+    std::basic_string<StringCharType>& buffer
+    ) -> std::enable_if_t<
+        sizeof(StringCharType) == 1,
+        bool>
+{
+    buffer += StringCharType(lead);
+    return true;
+}
+
+template <typename StringCharType, typename SourceType>
+static auto extract_utf8_char(
+    SourceType& source, const typename SourceType::char_type lead,
+    std::basic_string<StringCharType>& buffer
+    ) -> std::enable_if_t<
+        sizeof(StringCharType) != 1,
+        bool>
+{
+    using stream_char_type = typename SourceType::char_type;
+    static constexpr uint32_t min_code_points[] { 0, 0, 0x80, 0x800, 0x10000 };
+
+    const uint32_t lead_byte { static_cast<unsigned char>(lead) };
+    std::size_t length {};
+    uint32_t code_point {};
+    if (lead_byte >= 0xc2 && lead_byte < 0xe0)
+    {
+        length = 2;
+        code_point = lead_byte & 0x1f;
+    }
+    else if (lead_byte >= 0xe0 && lead_byte < 0xf0)
+    {
+        length = 3;
+        code_point = lead_byte & 0x0f;
+    }
+    else if (lead_byte >= 0xf0 && lead_byte < 0xf5)
+    {
+        length = 4;
+        code_point = lead_byte & 0x07;
+    }
+    else
+    {
+        return false;
+    }
+    for (std::size_t i { 1 }; i < length; ++i)
+    {
+        const auto c (source.get());
+        if (!source.good())
+            return false;
+        const uint32_t byte { static_cast<unsigned char>(stream_char_type(c)) };
+        if ((byte & 0xc0) != 0x80)
+            return false;
+        code_point = (code_point << 6) | (byte & 0x3f);
+    }
+    if (code_point < min_code_points[length] ||
+        (code_point >= 0xd800 && code_point < 0xe000) || code_point > 0x10ffff)
+        return false;
+    if (sizeof(StringCharType) == 2 && code_point >= 0x10000)
+    {
+        code_point -= 0x10000;
+        buffer += StringCharType(0xd800 + (code_point >> 10));
+        buffer += StringCharType(0xdc00 + (code_point & 0x3ff));
+        return true;
+    }
+    buffer += StringCharType(code_point);
+    return true;
+}
+
+/**
+ * @brief helper to string_repr::decode, encapsulates main literal
+ *   representation decoding loop
+ * @notes
+ *   - runs of printable unescaped chars are found with find_literal_escape()
+ *       and appended a window at a time
+ *   - utf8 representations are only transcoded from sources of single byte
+ *       chars, and are otherwise decoded as literal representations
+ */
+template<typename SourceType, typename StringType, typename StringCharType>
+static void extract_literal_repr(
+    SourceType& source, const string_repr<StringType, StringCharType>& repr,
+    std::basic_string<StringCharType>& buffer)
+{
+    using stream_char_type = typename SourceType::char_type;
+    const stream_char_type delim { stream_char_type(repr.delim) };
+    const stream_char_type escape { stream_char_type(repr.escape) };
+    const bool transcoded {
+        repr.type == repr_type::utf8 && sizeof(stream_char_type) == 1 };
+
+    while (source.fill_window())
+    {
+        const stream_char_type* const first { source.window_begin() };
+        const stream_char_type* const last { source.window_end() };
+        const stream_char_type* const p {
+            find_literal_escape(first, last, delim, escape) };
+        append_run(buffer, first, p);
+        source.consume(static_cast<std::size_t>(p - first));
+        if (p == last)
+            continue;
+        const stream_char_type c { *p };
+        source.consume(1);
+        if (c == delim)
+            return;
+        if (transcoded && !is_ascii(c))
+        {
+            if (!extract_utf8_char<StringCharType>(source, c, buffer))
+                break;  // invalid UTF-8
+            continue;
+        }
+        if (c != escape)
+        {
+            // unprintable char
+            if (source.is_eof_value(c))
+                source.setstate(std::ios_base::eofbit);
+            break;
+        }
+        const stream_char_type escaped ( source.get() );
+        if (!source.good() || !is_printable_ascii(escaped))
+            break;  // invalid escape
+        if (escaped == escape || escaped == delim)
+        {
+            buffer += StringCharType(escaped);
+            continue;
+        }
+        const int escape_value { standard_escape_value_of(escaped) };
+        if (escape_value >= 0)
+        {
+            buffer += StringCharType(escape_value);
+            continue;
+        }
+        if (escaped != stream_char_type('x'))
+            break;  // invalid escape
+        const uint32_t value {
+            extract_fixed_width_hex_value<StringCharType>(source) };
+        if (!source.good())
+            break;
+        buffer += StringCharType(value);
+    }
+    source.setstate(std::ios_base::failbit);
+}
+
+/**
+ * @brief helper to string_repr::decode, assigns decoded string to target
+ * @notes overloads as follows:
+ *   - basic_string&
+ *   - basic_string& with other traits or allocator (eg std::pmr::string),
+ *       copied into target to keep its allocator
+ *   - CharT&: fails unless exactly one char was decoded
+ *   - basic_string_view&: stored in the view_arena set with viewarena, or
+ *       fails if there is none
+ */
+template <typename CharType, typename SourceType>
+static bool assign_decoded(std::basic_string<CharType>& target,
+                           std::basic_string<CharType>& decoded,
+                           SourceType& /*source*/)
+{
+    target = std::move(decoded);
+    return true;
+}
+
+template <typename CharType, typename TraitsType, typename AllocType,
+          typename SourceType>
+static bool assign_decoded(
+    std::basic_string<CharType, TraitsType, AllocType>& target,
+    const std::basic_string<CharType>& decoded, SourceType& /*source*/)
+{
+    target.assign(decoded.data(), decoded.size());
+    return true;
+}
+
+template <typename CharType, typename SourceType>
+static bool assign_decoded(CharType& target,
+                           const std::basic_string<CharType>& decoded,
+                           SourceType& /*source*/)
+{
+    if (decoded.size() != 1)
+        return false;
+    target = decoded[0];
+    return true;
+}
+
+#if (__cplusplus >= 201703L)
+template <typename CharType, typename SourceType>
+static bool assign_decoded(std::basic_string_view<CharType>& target,
+                           const std::basic_string<CharType>& decoded,
+                           SourceType& source)
+{
+    view_arena<CharType>* const arena {
+        static_cast<view_arena<CharType>*>(
+            source.pword(get_view_arena_i<CharType>())) };
+    if (arena == nullptr)
+        return false;
+    target = arena->store(decoded);
+    return true;
+}
+
+#endif  // C++17
+/**
+ * @brief helper to string_repr::decode, assigns an encoded string without
+ *   escapes directly as a view into the source, when its chars are stable
+ *   (see buffers::input_buffer::stable_source)
+ * @notes overloads as follows:
+ *   - basic_string_view& with matching stream and string char types
+ *   - default: not possible
+ * @return false if not assigned, with nothing consumed
+ */
+template <typename SourceType, typename ReprType>
+static bool decode_in_place(SourceType& /*source*/, const ReprType& /*repr*/)
+{
+    return false;
+}
+
+#if (__cplusplus >= 201703L)
+template <typename SourceType, typename CharType>
+static auto decode_in_place(
+    SourceType& source,
+    const string_repr<std::basic_string_view<CharType>&, CharType>& repr
+    ) -> std::enable_if_t<
+        std::is_same<typename SourceType::char_type, CharType>::value,
+        bool>
+{
+    if (!source.stable_source() || !source.fill_window())
+        return false;
+    const CharType* const first { source.window_begin() };
+    const CharType* const last { source.window_end() };
+    const CharType* const p { repr.type == repr_type::quoted ?
+        find_quoted_escape(first, last, repr.delim, repr.escape) :
+        find_literal_escape(first, last, repr.delim, repr.escape) };
+    if (p == last || *p != repr.delim || source.find_eof_value(first, p) != p)
+        return false;
+    repr.string = std::basic_string_view<CharType>(
+        first, static_cast<std::size_t>(p - first));
+    source.consume(static_cast<std::size_t>(p - first) + 1);
+    return true;
+}
+
+#endif  // C++17
+template <typename StringType, typename CharType>
+template <typename SourceType>
+void string_repr<StringType, CharType>::decode(SourceType& source) const
+{
+    using stream_char_type = typename SourceType::char_type;
+
+    // quoted encoding expects full potential range of StreamCharType values,
+    //   and so could create overflow if casting to a smaller StringCharType,
+    //   whereas literal encoding expects only printable 7-bit ASCII values due
+    //   to escapes
+    if (type == repr_type::quoted &&
+        sizeof(stream_char_type) > sizeof(CharType))
+    {
+        source.setstate(std::ios_base::failbit);
+        return;
+    }
+    extract_literal_prefix<CharType>(source);
+    if (!source.good())
+        return;
+    // get() returns int_type
+    if (stream_char_type(source.get()) != stream_char_type(delim))
+        source.setstate(std::ios_base::failbit);
+    if (!source.good() || decode_in_place(source, *this))
+        return;
+    std::basic_string<CharType> temp;
+    if (type == repr_type::quoted)
+        extract_quoted_repr(source, *this, temp);
+    else
+        extract_literal_repr(source, *this, temp);
+    if (source.good() && !assign_decoded(string, temp, source))
+        source.setstate(std::ios_base::failbit);
+}
+
+/**
+ * @brief istream operator for string representations
+ * @notes
+ *   - overloads as follows:
+ *     - CharT&
+ *     - basic_string&
+ *     - basic_string_view& (see viewarena)
+ *   - decodes directly from the streambuf through a buffers::input_buffer,
+ *       rather than by formatted extraction of each char
+ */
+template<typename StreamCharType, typename StringCharType>
+auto operator>>(
+    std::basic_istream<StreamCharType>& istream,
+    const string_repr<StringCharType&, StringCharType>& repr
+    ) -> std::basic_istream<StreamCharType>&
+{
+    buffers::input_buffer<StreamCharType> buffer { istream };
+    if (buffer.good())
+        repr.decode(buffer);
+    return istream;
+}
+
+template<typename StreamCharType, typename StringCharType,
+         typename TraitsType, typename AllocType>
+auto operator>>(
+    std::basic_istream<StreamCharType>& istream,
+    const string_repr<std::basic_string<StringCharType, TraitsType, AllocType>&,
+                      StringCharType>& repr
+    ) -> std::basic_istream<StreamCharType>&
+{
+    buffers::input_buffer<StreamCharType> buffer { istream };
+    if (buffer.good())
+        repr.decode(buffer);
+    return istream;
+}
+
+#if (__cplusplus >= 201703L)
+template<typename StreamCharType, typename StringCharType>
+auto operator>>(
+    std::basic_istream<StreamCharType>& istream,
+    const string_repr<std::basic_string_view<StringCharType>&, StringCharType>& repr
+    ) -> std::basic_istream<StreamCharType>&
+{
+    buffers::input_buffer<StreamCharType> buffer { istream };
+    if (buffer.good())
+        repr.decode(buffer);
+    return istream;
+}
+
+#endif  // C++17
+
+}  // namespace detail
+
+/**
+ * @brief iomanip to set encoding/decoding of strings/chars in containers to
+ *   literal
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& literalrepr(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_manip_i()) =
+        static_cast<int>(detail::repr_type::literal);
+    return stream;
+}
+
+/**
+ * @brief iomanip to set encoding/decoding of strings/chars in containers to
+ *   quoted
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& quotedrepr(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_manip_i()) =
+        static_cast<int>(detail::repr_type::quoted);
+    return stream;
+}
+
+/**
+ * @brief iomanip to set encoding/decoding of strings/chars in containers to
+ *   literal, but with non-ASCII chars transcoded to and from UTF-8 on streams
+ *   of single byte chars
+ * @notes
+ *   - wchar_t, char16_t (as UTF-16) and char32_t strings are written as the
+ *       UTF-8 of their code points instead of hex escapes of each char, and
+ *       single byte strings (eg already holding UTF-8) with their non-ASCII
+ *       bytes unescaped; delimiters, escapes and ASCII control chars are
+ *       still escaped
+ *   - chars of wide strings that are not valid code points (eg unpaired
+ *       surrogates) are hex escaped, so that all strings are restored as
+ *       they were
+ *   - on streams of wider chars, same as literalrepr
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& utf8repr(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_manip_i()) =
+        static_cast<int>(detail::repr_type::utf8);
+    return stream;
+}
+
+#if (__cplusplus >= 201703L)
+/**
+ * @brief istream manipulator to parse std::basic_string_view<CharType>
+ *   container elements
+ * @notes
+ *   - strings without escapes are viewed in place when parsing from a stable
+ *       buffers::span_streambuf (eg over a buffers::mapped_file), and are
+ *       otherwise decoded and stored in arena, which must outlive the views
+ *   - without an arena set, views can only be parsed in place, and parsing
+ *       any other string fails
+ *   - a null arena pointer unsets the arena
+ */
+template <typename CharType>
+detail::view_arena_setter<CharType> viewarena(view_arena<CharType>* arena)
+{
+    return { arena };
+}
+
+template <typename CharType>
+detail::view_arena_setter<CharType> viewarena(view_arena<CharType>& arena)
+{
+    return { &arena };
+}
+
+#endif  // C++17
+
+/**
+ * @brief generates quoted string represenation intended for use with stream
+ *   operators
+ * @notes
+ *   - overloads need to be supplied for each string type of param `string`,
+ *       so that it can both be templated for any char type, and allow the
+ *       deduction of the `delim` and `escape` types when they are not given as
+ *       params
+ *   - overloads should support the following string types: (const) CharT&,
+ *       (const) CharT*, (const) basic_string&, (const) basic_string_view&
+ */
+template<typename CharType>
+inline auto quoted(
+    CharType& string,
+    CharType delim = CharType('\''), CharType escape = CharType('\\')
+    ) -> std::enable_if_t<
+        traits::is_char_type<CharType>::value,
+        detail::string_repr<CharType&, CharType>>
+{
+    return detail::string_repr<CharType&, CharType>(
+            string, delim, escape, detail::repr_type::quoted);
+}
+
+template<typename CharType>
+inline auto quoted(
+    const CharType& string,
+    CharType delim = CharType('\''), CharType escape = CharType('\\')
+    ) -> std::enable_if_t<
+        traits::is_char_type<CharType>::value,
+        detail::string_repr<const CharType&, CharType>>
+{
+    return detail::string_repr<const CharType&, CharType>(
+            string, delim, escape, detail::repr_type::quoted);
+}
+
+template<typename CharType>
+inline auto quoted(
+    CharType* string,
+    CharType delim = CharType('"'), CharType escape = CharType('\\')
+    ) -> detail::string_repr<CharType*, CharType>
+{
+    return detail::string_repr<CharType*, CharType>(
+            string, delim, escape, detail::repr_type::quoted);
+}
+
+template<typename CharType>
+inline auto quoted(
+    const CharType* string,
+    CharType delim = CharType('"'), CharType escape = CharType('\\')
+    ) -> detail::string_repr<const CharType*, CharType>
+{
+    return detail::string_repr<const CharType*, CharType>(
+            string, delim, escape, detail::repr_type::quoted);
+}
+
+template<typename CharType, typename TraitsType, typename AllocType>
+inline auto quoted(
+    std::basic_string<CharType, TraitsType, AllocType>& string,
+    CharType delim = CharType('"'), CharType escape = CharType('\\')
+    ) -> detail::string_repr<
+        std::basic_string<CharType, TraitsType, AllocType>&, CharType>
+{
+    return detail::string_repr<
+	std::basic_string<CharType, TraitsType, AllocType>&, CharType>(
+	    string, delim, escape, detail::repr_type::quoted);
+}
+
+template<typename CharType, typename TraitsType, typename AllocType>
+inline auto quoted(
+    const std::basic_string<CharType, TraitsType, AllocType>& string,
+    CharType delim = CharType('"'), CharType escape = CharType('\\')
+    ) -> detail::string_repr<
+        const std::basic_string<CharType, TraitsType, AllocType>&, CharType>
+{
+    return detail::string_repr<
+	const std::basic_string<CharType, TraitsType, AllocType>&, CharType>(
+	    string, delim, escape, detail::repr_type::quoted);
+}
+
+#if __cplusplus >= 201703L
+template<typename CharType, typename TraitsType>
+inline auto quoted(
+    std::basic_string_view<CharType, TraitsType>& string_view,
+    CharType delim = CharType('"'), CharType escape = CharType('\\')
+    ) -> detail::string_repr<
+        std::basic_string_view<CharType, TraitsType>&, CharType>
+{
+    return detail::string_repr<
+        std::basic_string_view<CharType, TraitsType>&, CharType>(
+	    string_view, delim, escape, detail::repr_type::quoted);
+}
+
+template<typename CharType, typename TraitsType>
+inline auto quoted(
+    const std::basic_string_view<CharType, TraitsType>& string_view,
+    CharType delim = CharType('"'), CharType escape = CharType('\\')
+    ) -> detail::string_repr<
+        const std::basic_string_view<CharType, TraitsType>&, CharType>
+{
+    return detail::string_repr<
+        const std::basic_string_view<CharType, TraitsType>&, CharType>(
+	    string_view, delim, escape, detail::repr_type::quoted);
+}
+#endif  // C++17
+
+/**
+ * @brief generates literal string represenation intended for use with stream
+ *   operators
+ * @notes
+ *   - overloads need to be supplied for each string type of param `string`,
+ *       so that it can both be templated for any char type, and allow the
+ *       deduction of the `delim` and `escape` types when they are not given as
+ *       params
+ *   - overloads should support the following string types: (const) CharT&,
+ *       (const) CharT*, (const) basic_string&, (const) basic_string_view&
+ */
+template<typename CharType>
+inline auto literal(
+    CharType& string,
+    CharType delim = CharType('\''), CharType escape = CharType('\\')
+    ) -> std::enable_if_t<
+        traits::is_char_type<CharType>::value,
+        detail::string_repr<CharType&, CharType>>
+{
+    return detail::string_repr<CharType&, CharType>(
+            string, delim, escape, detail::repr_type::literal);
+}
+
+template<typename CharType>
+inline auto literal(
+    const CharType& string,
+    CharType delim = CharType('\''), CharType escape = CharType('\\')
+    ) -> std::enable_if_t<
+        traits::is_char_type<CharType>::value,
+        detail::string_repr<const CharType&, CharType>>
+{
+    return detail::string_repr<const CharType&, CharType>(
+            string, delim, escape, detail::repr_type::literal);
+}
+
+template<typename CharType>
+inline auto literal(
+    CharType* string,
+    CharType delim = CharType('"'), CharType escape = CharType('\\')
+    ) -> detail::string_repr<CharType*, CharType>
+{
+    return detail::string_repr<CharType*, CharType>(
+            string, delim, escape, detail::repr_type::literal);
+}
+
+template<typename CharType>
+inline auto literal(
+    const CharType* string,
+    CharType delim = CharType('"'), CharType escape = CharType('\\')
+    ) -> detail::string_repr<const CharType*, CharType>
+{
+    return detail::string_repr<const CharType*, CharType>(
+            string, delim, escape, detail::repr_type::literal);
+}
+
+template<typename CharType, typename TraitsType, typename AllocType>
+inline auto literal(
+    std::basic_string<CharType, TraitsType, AllocType>& string,
+    CharType delim = CharType('"'), CharType escape = CharType('\\')
+    ) -> detail::string_repr<
+        std::basic_string<CharType, TraitsType, AllocType>&, CharType>
+{
+    return detail::string_repr<
+	std::basic_string<CharType, TraitsType, AllocType>&, CharType>(
+	    string, delim, escape, detail::repr_type::literal);
+}
+
+template<typename CharType, typename TraitsType, typename AllocType>
+inline auto literal(
+    const std::basic_string<CharType, TraitsType, AllocType>& string,
+    CharType delim = CharType('"'), CharType escape = CharType('\\')
+    ) -> detail::string_repr<
+        const std::basic_string<CharType, TraitsType, AllocType>&, CharType>
+{
+    return detail::string_repr<
+	const std::basic_string<CharType, TraitsType, AllocType>&, CharType>(
+	    string, delim, escape, detail::repr_type::literal);
+}
+
+#if __cplusplus >= 201703L
+template<typename CharType, typename TraitsType>
+inline auto literal(
+    std::basic_string_view<CharType, TraitsType>& string_view,
+    CharType delim = CharType('"'), CharType escape = CharType('\\')
+    ) -> detail::string_repr<
+        std::basic_string_view<CharType, TraitsType>&, CharType>
+{
+    return detail::string_repr<
+        std::basic_string_view<CharType, TraitsType>&, CharType>(
+	    string_view, delim, escape, detail::repr_type::literal);
+}
+
+template<typename CharType, typename TraitsType>
+inline auto literal(
+    const std::basic_string_view<CharType, TraitsType>& string_view,
+    CharType delim = CharType('"'), CharType escape = CharType('\\')
+    ) -> detail::string_repr<
+        const std::basic_string_view<CharType, TraitsType>&, CharType>
+{
+    return detail::string_repr<
+        const std::basic_string_view<CharType, TraitsType>&, CharType>(
+	    string_view, delim, escape, detail::repr_type::literal);
+}
+#endif  // C++17
+
+namespace detail {
+
+/**
+ * @brief literal representation of string with default delim and escape, as
+ *   used by container formatters, with type literal or utf8 (see utf8repr)
+ */
+template <typename StringType>
+static auto unquoted(StringType& string, const repr_type type
+    ) -> decltype(literal(string))
+{
+    auto repr (literal(string));
+    repr.type = type;
+    return repr;
+}
+
+}  // namespace detail
+
+}  // namespace strings
+
+/**
+ * @brief contains structures which provide tokens used around and between
+ *   elements in conatiner serializations
+ */
+namespace decorator {
+
+/**
+ * @brief wraps tokens used around and between elements in serialization of a
+ *   given set of container types
+ */
+template <typename CharType>
+struct delim_wrapper
+{
+    const CharType* prefix;
+    const CharType* separator;
+    const CharType* whitespace;
+    const CharType* suffix;
+};
+
+using namespace strings::compile_time;  // char_literal, string_literal
+
+// TBD consider making map/multimap curly braced, as they are essentially sets of pairs
+/**
+ * @brief wraps delim_wrapper, allowing templating by both char and container
+ *   types
+ * @notes overloads as follows:
+ *   - default (eg std::array, C array, vector, list, forward_list, queue,
+ *       unordered(multi)(map|set))
+ *   - set/multiset
+ *   - pair
+ *   - tuple
+ */
+template <typename ContainerType,
+          typename CharType>
+struct delimiters
+{
+    static constexpr delim_wrapper<CharType> values {
+        STRING_LITERAL(CharType, "["),
+        STRING_LITERAL(CharType, ","),
+        STRING_LITERAL(CharType, " "),
+        STRING_LITERAL(CharType, "]") };
+};
+
+template <typename DataType, typename CompareType, typename AllocType,
+          typename CharType>
+struct delimiters<std::set<DataType, CompareType, AllocType>, CharType>
+{
+    static constexpr delim_wrapper<CharType> values {
+        STRING_LITERAL(CharType, "{"),
+        STRING_LITERAL(CharType, ","),
+        STRING_LITERAL(CharType, " "),
+        STRING_LITERAL(CharType, "}") };
+};
+
+template <typename DataType, typename CompareType, typename AllocType,
+          typename CharType>
+struct delimiters<std::multiset<DataType, CompareType, AllocType>, CharType>
+{
+    static constexpr delim_wrapper<CharType> values {
+        STRING_LITERAL(CharType, "{"),
+        STRING_LITERAL(CharType, ","),
+        STRING_LITERAL(CharType, " "),
+        STRING_LITERAL(CharType, "}") };
+};
+
+template <typename FirstType, typename SecondType,
+          typename CharType>
+struct delimiters<std::pair<FirstType, SecondType>, CharType>
+{
+    static constexpr delim_wrapper<CharType> values {
+        STRING_LITERAL(CharType, "("),
+        STRING_LITERAL(CharType, ","),
+        STRING_LITERAL(CharType, " "),
+        STRING_LITERAL(CharType, ")") };
+};
+
+template <typename... DataType,
+          typename CharType>
+struct delimiters<std::tuple<DataType...>, CharType>
+{
+    static constexpr delim_wrapper<CharType> values {
+        STRING_LITERAL(CharType, "<"),
+        STRING_LITERAL(CharType, ","),
+        STRING_LITERAL(CharType, " "),
+        STRING_LITERAL(CharType, ">") };
+};
+
+/**
+ * @brief wraps tokens around an element count hint, which when enabled with
+ *   counthint follows the prefix of non-empty serializations of (non-pair,
+ *   non-tuple) containers, eg "[#3: 1, 2, 3]"
+ */
+template <typename CharType>
+struct count_hint_wrapper
+{
+    const CharType* marker;
+    const CharType* terminator;
+};
+
+template <typename CharType>
+struct count_hint_delimiters
+{
+    static constexpr count_hint_wrapper<CharType> values {
+        STRING_LITERAL(CharType, "#"),
+        STRING_LITERAL(CharType, ":") };
+};
+
+/**
+ * @brief length of a null-terminated decorator token (0 for nullptr), for use
+ *   in constant expressions
+ */
+template <typename CharType>
+constexpr std::size_t token_length(const CharType* token,
+                                   const std::size_t offset = 0)
+{
+    return (token == nullptr || token[offset] == CharType()) ?
+        offset : token_length(token, offset + 1);
+}
+
+/**
+ * @brief null-terminated token stored by value, eg as concatenated from two
+ *   decorator tokens at compile time
+ */
+template <typename CharType, std::size_t Length>
+struct fixed_token
+{
+    CharType chars[Length + 1];
+};
+
+/**
+ * @brief contains implementation details of decorator token concatenation
+ */
+namespace detail {
+
+template <typename CharType>
+constexpr CharType concatenated_char(
+    const CharType* first, const std::size_t first_length,
+    const CharType* second, const std::size_t index)
+{
+    return index < first_length ? first[index] : second[index - first_length];
+}
+
+template <std::size_t Length, typename CharType, std::size_t... Indices>
+constexpr fixed_token<CharType, Length> concatenate_tokens(
+    const CharType* first, const CharType* second,
+    std::index_sequence<Indices...> /*indices*/)
+{
+    return fixed_token<CharType, Length> { {
+            concatenated_char(first, token_length(first), second, Indices)...,
+            CharType() } };
+}
+
+}  // namespace detail
+
+/**
+ * @brief decorator tokens of a container type measured at compile time, so
+ *   that the default formatters insert each token with one fixed length write
+ *   and extract it with one fixed length comparison
+ * @notes
+ *   - taken from delimiters<ContainerType, CharType>::values and
+ *       count_hint_delimiters<CharType>::values, so that custom
+ *       specializations of either are measured alike
+ *   - for output, separator and whitespace are fused into one token, as are
+ *       the count hint terminator and whitespace
+ */
+template <typename ContainerType, typename CharType>
+struct tokens
+{
+    static constexpr std::size_t prefix_length {
+        token_length(delimiters<ContainerType, CharType>::values.prefix) };
+    static constexpr std::size_t separator_length {
+        token_length(delimiters<ContainerType, CharType>::values.separator) };
+    static constexpr std::size_t whitespace_length {
+        token_length(delimiters<ContainerType, CharType>::values.whitespace) };
+    static constexpr std::size_t suffix_length {
+        token_length(delimiters<ContainerType, CharType>::values.suffix) };
+    static constexpr std::size_t marker_length {
+        token_length(count_hint_delimiters<CharType>::values.marker) };
+    static constexpr std::size_t terminator_length {
+        token_length(count_hint_delimiters<CharType>::values.terminator) };
+
+    static constexpr std::size_t spaced_separator_length {
+        separator_length + whitespace_length };
+    static constexpr std::size_t spaced_terminator_length {
+        terminator_length + whitespace_length };
+
+    /**
+     * @brief separator followed by whitespace
+     */
+    static const CharType* spaced_separator() noexcept
+    {
+        static constexpr fixed_token<CharType, spaced_separator_length> token {
+            detail::concatenate_tokens<spaced_separator_length>(
+                delimiters<ContainerType, CharType>::values.separator,
+                delimiters<ContainerType, CharType>::values.whitespace,
+                std::make_index_sequence<spaced_separator_length> {}) };
+        return token.chars;
+    }
+
+    /**
+     * @brief count hint terminator followed by whitespace
+     */
+    static const CharType* spaced_terminator() noexcept
+    {
+        static constexpr fixed_token<CharType, spaced_terminator_length> token {
+            detail::concatenate_tokens<spaced_terminator_length>(
+                count_hint_delimiters<CharType>::values.terminator,
+                delimiters<ContainerType, CharType>::values.whitespace,
+                std::make_index_sequence<spaced_terminator_length> {}) };
+        return token.chars;
+    }
+};
+
+/**
+ * @brief contains implementation details of count hint settings
+ */
+namespace detail {
+
+/**
+ * @brief stream index getter for use with iword/pword to set
+ *   counthint/nocounthint
+ */
+inline int get_count_hint_i()
+{
+    static int i {std::ios_base::xalloc()};
+    return i;
+}
+
+/**
+ * @brief tests if count hints are written to/accepted from stream
+ */
+template <typename StreamType>
+static bool count_hints_enabled(StreamType& stream)
+{
+    return stream.iword(get_count_hint_i()) != 0;
+}
+
+}  // namespace detail
+
+/**
+ * @brief iomanip to have container serializations inserted with element count
+ *   hints, or have them optionally accepted on extraction (where they are used
+ *   to preallocate containers, or validate array lengths)
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& counthint(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_count_hint_i()) = 1;
+    return stream;
+}
+
+/**
+ * @brief iomanip to have container serializations streamed without element
+ *   count hints (default)
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& nocounthint(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_count_hint_i()) = 0;
+    return stream;
+}
+
+}  // namespace decorator
+
+/**
+ * @brief contains the encoding shared by input::binary_formatter and
+ *   output::binary_formatter, in which:
+ *   - element counts of (non-pair, non-tuple) containers, and lengths of
+ *       strings, precede their elements as 64-bit unsigned integers
+ *   - arithmetic and enum values are little-endian, of their size on the host
+ *   - bools are one byte, 0 or 1
+ *   - other trivially copyable (non-container, non-string) types are copied
+ *       as their bytes on the host, so are not portable between platforms
+ *   - there are no decorators
+ */
+namespace binary {
+
+/**
+ * @brief contains implementation details of binary encoding
+ */
+namespace detail {
+
+/**
+ * @brief stream index getter for use with iword/pword to set
+ *   binaryrepr/textrepr
+ */
+inline int get_binary_i()
+{
+    static int i {std::ios_base::xalloc()};
+    return i;
+}
+
+/**
+ * @brief tests if compatible containers should be streamed in binary, which
+ *   is only possible for streams of single byte chars
+ */
+template <typename StreamType>
+static auto binary_enabled(StreamType& stream
+    ) -> std::enable_if_t<
+        sizeof(typename StreamType::char_type) == 1,
+        bool>
+{
+    return stream.iword(get_binary_i()) != 0;
+}
+
+template <typename StreamType>
+static auto binary_enabled(StreamType& /*stream*/
+    ) -> std::enable_if_t<
+        sizeof(typename StreamType::char_type) != 1,
+        bool>
+{
+    return false;
+}
+
+/**
+ * @brief tests for types encoded as little-endian values
+ */
+template <typename Type>
+struct is_value : public std::integral_constant<
+    bool, std::is_arithmetic<Type>::value || std::is_enum<Type>::value>
+{};
+
+/**
+ * @brief tests for pointers to chars, encoded as the strings they point to
+ */
+template <typename Type>
+struct is_c_string : public std::integral_constant<
+    bool, std::is_pointer<Type>::value && traits::is_c_string_type<Type>::value>
+{};
+
+/**
+ * @brief tests for types encoded as their bytes on the host, excluding
+ *   pointers, whose addresses would not be meaningful when parsed
+ */
+template <typename Type>
+struct is_raw : public std::integral_constant<
+    bool, std::is_trivially_copyable<Type>::value && !is_value<Type>::value &&
+    !std::is_pointer<Type>::value && !std::is_member_pointer<Type>::value &&
+    !traits::is_printable_as_container<Type>::value &&
+    !traits::is_parseable_as_container<Type>::value &&
+    !traits::is_stl_string_type<Type>::value>
+{};
+
+/**
+ * @brief tests if the host is little-endian, so that value blocks need no
+ *   reordering
+ */
+inline bool little_endian()
+{
+    const std::uint16_t value { 1 };
+    unsigned char first_byte {};
+    std::memcpy(&first_byte, &value, 1);
+    return first_byte == 1;
+}
+
+template <typename StreamType>
+static void write_bytes(StreamType& ostream, const void* bytes,
+                        const std::size_t size)
+{
+    ostream.write(static_cast<const typename StreamType::char_type*>(bytes),
+                  static_cast<std::streamsize>(size));
+}
+
+template <typename StreamType>
+static void read_bytes(StreamType& istream, void* bytes, const std::size_t size)
+{
+    istream.read(static_cast<typename StreamType::char_type*>(bytes),
+                 static_cast<std::streamsize>(size));
+}
+
+/**
+ * @brief writes/reads a value, reordering bytes on big-endian hosts
+ * @notes read_value overloads as follows:
+ *   - default
+ *   - bool: fails if not 0 or 1
+ */
+template <typename StreamType, typename ValueType>
+static void write_value(StreamType& ostream, const ValueType& value)
+{
+    unsigned char bytes[sizeof(ValueType)];
+    std::memcpy(bytes, &value, sizeof(ValueType));
+    if (!little_endian())
+        std::reverse(std::begin(bytes), std::end(bytes));
+    write_bytes(ostream, bytes, sizeof(ValueType));
+}
+
+template <typename StreamType, typename ValueType>
+static void read_value(StreamType& istream, ValueType& value)
+{
+    unsigned char bytes[sizeof(ValueType)];
+    read_bytes(istream, bytes, sizeof(ValueType));
+    if (istream.fail())
+        return;
+    if (!little_endian())
+        std::reverse(std::begin(bytes), std::end(bytes));
+    std::memcpy(&value, bytes, sizeof(ValueType));
+}
+
+template <typename StreamType>
+static void read_value(StreamType& istream, bool& value)
+{
+    unsigned char byte {};
+    read_bytes(istream, &byte, 1);
+    if (istream.fail())
+        return;
+    if (byte > 1)
+        istream.setstate(std::ios_base::failbit);
+    else
+        value = byte != 0;
+}
+
+/**
+ * @brief writes/reads consecutive (non-bool) values, as a single block on
+ *   little-endian hosts
+ */
+template <typename StreamType, typename ValueType>
+static void write_block(StreamType& ostream, const ValueType* values,
+                        std::size_t count)
+{
+    if (little_endian())
+    {
+        write_bytes(ostream, values, count * sizeof(ValueType));
+        return;
+    }
+    for (; count != 0; --count, ++values)
+        write_value(ostream, *values);
+}
+
+template <typename StreamType, typename ValueType>
+static void read_block(StreamType& istream, ValueType* values,
+                       const std::size_t count)
+{
+    read_bytes(istream, values, count * sizeof(ValueType));
+    if (istream.fail() || little_endian())
+        return;
+    for (std::size_t i {}; i < count; ++i)
+    {
+        unsigned char* const bytes { reinterpret_cast<unsigned char*>(values + i) };
+        std::reverse(bytes, bytes + sizeof(ValueType));
+    }
+}
+
+/**
+ * @brief writes/reads a 64-bit element count or string length
+ */
+template <typename StreamType>
+static void write_size(StreamType& ostream, const std::size_t size)
+{
+    write_value(ostream, static_cast<std::uint64_t>(size));
+}
+
+template <typename StreamType>
+static bool read_size(StreamType& istream, std::size_t& size)
+{
+    std::uint64_t value {};
+    read_value(istream, value);
+    if (!istream.fail() && value > std::numeric_limits<std::size_t>::max())
+        istream.setstate(std::ios_base::failbit);
+    if (istream.fail())
+        return false;
+    size = static_cast<std::size_t>(value);
+    return true;
+}
+
+/**
+ * @brief writes/reads a length-prefixed string
+ * @notes strings are read in steps, so that a corrupt length can't allocate
+ *   beyond the contents of the stream
+ */
+template <typename StreamType, typename CharType>
+static void write_string(StreamType& ostream, const CharType* chars,
+                         const std::size_t size)
+{
+    write_size(ostream, size);
+    write_block(ostream, chars, size);
+}
+
+template <typename StreamType, typename CharType, typename TraitsType,
+          typename AllocType>
+static void read_string(
+    StreamType& istream,
+    std::basic_string<CharType, TraitsType, AllocType>& string)
+{
+    const std::size_t step { 65536 / sizeof(CharType) };
+    std::size_t size {};
+    if (!read_size(istream, size))
+        return;
+    string.clear();
+    while (size != 0 && !istream.fail())
+    {
+        const std::size_t n { std::min(size, step) };
+        const std::size_t offset { string.size() };
+        string.resize(offset + n);
+        read_block(istream, &string[offset], n);
+        size -= n;
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief iomanip to have compatible containers streamed with the stream
+ *   operators in binary (see input::binary_formatter and
+ *   output::binary_formatter), for streams of single byte chars
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& binaryrepr(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_binary_i()) = 1;
+    return stream;
+}
+
+/**
+ * @brief iomanip to have compatible containers streamed with the stream
+ *   operators as text (default)
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& textrepr(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_binary_i()) = 0;
+    return stream;
+}
+
+}  // namespace binary
+
+/**
+ * @brief contains the C locale representation of numeric container elements,
+ *   formatted with std::to_chars and parsed with std::from_chars, rather than
+ *   with the num_put/num_get facets of the stream locale
+ * @notes only available where the standard library provides to_chars and
+ *   from_chars for floating point types (see CONTAINER_STREAM_IO_CHARCONV),
+ *   otherwise numbers are always streamed with the stream locale
+ */
+namespace numeric {
+
+/**
+ * @brief contains implementation details of C locale numeric encoding
+ */
+namespace detail {
+
+/**
+ * @brief stream index getter for use with iword/pword to set
+ *   clocalerepr/localerepr
+ */
+inline int get_numeric_i()
+{
+    static int i {std::ios_base::xalloc()};
+    return i;
+}
+
+/**
+ * @brief tests if numbers are streamed in their C locale representation
+ */
+template <typename StreamType>
+static bool c_locale_enabled(StreamType& stream)
+{
+    return stream.iword(get_numeric_i()) != 0;
+}
+
+/**
+ * @brief tests for types with a C locale representation: arithmetic types
+ *   other than bool and char types (including signed and unsigned char,
+ *   which streams insert as chars)
+ */
+template <typename Type>
+struct is_charconv_number : public std::integral_constant<
+    bool,
+#ifdef CONTAINER_STREAM_IO_CHARCONV
+    std::is_arithmetic<Type>::value && !std::is_same<Type, bool>::value &&
+    !std::is_same<Type, char>::value && !std::is_same<Type, signed char>::value &&
+    !std::is_same<Type, unsigned char>::value &&
+    !traits::is_char_type<Type>::value
+#else
+    false
+#endif  // CONTAINER_STREAM_IO_CHARCONV
+    >
+{};
+
+/**
+ * @brief tests for chars which may be part of a C locale representation,
+ *   including those of exponents and of inf/nan
+ */
+template <typename CharType>
+static bool is_number_char(const CharType c)
+{
+    return (c >= CharType('0') && c <= CharType('9')) ||
+        (c >= CharType('a') && c <= CharType('z')) ||
+        (c >= CharType('A') && c <= CharType('Z')) ||
+        c == CharType('-') || c == CharType('+') || c == CharType('.');
+}
+
+#ifdef CONTAINER_STREAM_IO_CHARCONV
+/**
+ * @brief maximum length of a C locale representation, which for floating
+ *   point types is the shortest that parses back to the same value
+ */
+static constexpr std::size_t max_number_length { 128 };
+
+/**
+ * @brief helper to number_repr::encode, writes formatted chars to sink
+ * @notes overloads as follows:
+ *   - sinks of char
+ *   - default: chars widened to the sink char type
+ */
+template <typename SinkType>
+static auto write_number(SinkType& sink, const char* first, const char* last
+    ) -> std::enable_if_t<
+        std::is_same<typename SinkType::char_type, char>::value,
+        void>
+{
+    sink.write(first, static_cast<std::size_t>(last - first));
+}
+
+template <typename SinkType>
+static auto write_number(SinkType& sink, const char* first, const char* last
+    ) -> std::enable_if_t<
+        !std::is_same<typename SinkType::char_type, char>::value,
+        void>
+{
+    using char_type = typename SinkType::char_type;
+
+    char_type chars[max_number_length];
+    std::copy(first, last, chars);
+    sink.write(chars, static_cast<std::size_t>(last - first));
+}
+
+/**
+ * @brief helper to number_repr::decode, parses a number wholly within the
+ *   current window of source, without copying it
+ * @notes overloads as follows:
+ *   - sources of char
+ *   - default: never parsed in place
+ * @return false if the number may continue past the window, in which case
+ *   nothing is consumed
+ */
+template <typename SourceType, typename ValueType>
+static auto parse_in_window(SourceType& source, ValueType& value
+    ) -> std::enable_if_t<
+        std::is_same<typename SourceType::char_type, char>::value,
+        bool>
+{
+    const char* const first { source.window_begin() };
+    const char* const last { source.window_end() };
+    ValueType parsed {};
+    const std::from_chars_result result { std::from_chars(first, last, parsed) };
+    // eg "1e" may be followed by "+5" after the window
+    const char* p { result.ptr };
+    while (p != last && is_number_char(*p))
+        ++p;
+    if (p == last)
+        return false;
+    if (result.ec != std::errc())
+    {
+        source.setstate(std::ios_base::failbit);
+        return true;
+    }
+    source.consume(static_cast<std::size_t>(result.ptr - first));
+    value = parsed;
+    return true;
+}
+
+template <typename SourceType, typename ValueType>
+static auto parse_in_window(SourceType& /*source*/, ValueType& /*value*/
+    ) -> std::enable_if_t<
+        !std::is_same<typename SourceType::char_type, char>::value,
+        bool>
+{
+    return false;
+}
+
+#endif  // CONTAINER_STREAM_IO_CHARCONV
+
+/**
+ * @brief tests for element types decoded in bulk by scan_numbers: integral
+ *   types of up to 64 bits other than bool and char types, and with
+ *   CONTAINER_STREAM_IO_CHARCONV, floating point types
+ */
+template <typename Type>
+struct is_bulk_number : public std::integral_constant<
+    bool,
+    (std::is_integral<Type>::value && sizeof(Type) <= sizeof(uint64_t) &&
+     !std::is_same<Type, bool>::value && !std::is_same<Type, char>::value &&
+     !std::is_same<Type, signed char>::value &&
+     !std::is_same<Type, unsigned char>::value &&
+     !traits::is_char_type<Type>::value)
+#ifdef CONTAINER_STREAM_IO_CHARCONV
+    || std::is_floating_point<Type>::value
+#endif  // CONTAINER_STREAM_IO_CHARCONV
+    >
+{};
+
+/**
+ * @brief decodes 8 digit chars at once, as packed into a little-endian
+ *   64-bit value: each step combines adjacent lanes of half the width,
+ *   eg "12345678" -> 1 2 3 4 5 6 7 8 -> 12 34 56 78 -> 1234 5678 -> 12345678
+ */
+inline uint64_t decode_eight_digits(const char* digits)
+{
+    uint64_t chunk;
+    std::memcpy(&chunk, digits, sizeof(chunk));
+    chunk -= 0x3030303030303030;
+    chunk = (chunk * 10 + (chunk >> 8)) & 0x00ff00ff00ff00ff;
+    chunk = (chunk * 100 + (chunk >> 16)) & 0x0000ffff0000ffff;
+    return (chunk * 10000 + (chunk >> 32)) & 0x00000000ffffffff;
+}
+
+/**
+ * @brief decodes up to 19 digit chars, which can't overflow 64 bits
+ */
+inline uint64_t decode_digits(const char* digits, std::size_t length)
+{
+    uint64_t value {};
+    if (binary::detail::little_endian())
+    {
+        for (; length >= 8; length -= 8, digits += 8)
+            value = value * 100000000 + decode_eight_digits(digits);
+    }
+    for (; length != 0; --length, ++digits)
+        value = value * 10 + static_cast<uint64_t>(*digits - '0');
+    return value;
+}
+
+/**
+ * @brief helper to scan_numbers, decodes a number at the start of
+ *   [first, last) in the simplest form of both its C locale and its classic
+ *   num_get representations, which parse to the same value
+ * @notes overloads as follows:
+ *   - integral: -?[0-9]+ (no '-' if unsigned), of up to 19 digits and in
+ *       range of ValueType
+ *   - floating point: -?[0-9]+(\.[0-9]+)?([eE][-+]?[0-9]+)?, decoded with
+ *       std::from_chars
+ * @return end of the number, or nullptr if it is in any other form, out of
+ *   range, or not followed by a char in [first, last) that ends it, in which
+ *   case value is unmodified and the number must be parsed from the stream
+ */
+template <typename ValueType>
+static auto scan_number(const char* first, const char* last, ValueType& value
+    ) -> std::enable_if_t<
+        std::is_integral<ValueType>::value,
+        const char*>
+{
+    using limits = std::numeric_limits<ValueType>;
+
+    const char* p { first };
+    const bool negative { p != last && *p == '-' };
+    if (negative)
+    {
+        if (!limits::is_signed)
+            return nullptr;
+        ++p;
+    }
+    const char* const end { strings::detail::simd::find_non_digit(p, last) };
+    const std::size_t length { static_cast<std::size_t>(end - p) };
+    if (length == 0 || length > 19 || end == last || is_number_char(*end))
+        return nullptr;
+    const uint64_t magnitude { decode_digits(p, length) };
+    if (negative)
+    {
+        // magnitude of min(), which is not representable as a positive value
+        const uint64_t max_magnitude {
+            static_cast<uint64_t>(-(limits::min() + 1)) + 1 };
+        if (magnitude > max_magnitude)
+            return nullptr;
+        value = magnitude == 0 ? ValueType {} : static_cast<ValueType>(
+            -static_cast<ValueType>(magnitude - 1) - 1);
+    }
+    else
+    {
+        if (magnitude > static_cast<uint64_t>(limits::max()))
+            return nullptr;
+        value = static_cast<ValueType>(magnitude);
+    }
+    return end;
+}
+
+#ifdef CONTAINER_STREAM_IO_CHARCONV
+template <typename ValueType>
+static auto scan_number(const char* first, const char* last, ValueType& value
+    ) -> std::enable_if_t<
+        std::is_floating_point<ValueType>::value,
+        const char*>
+{
+    using strings::detail::simd::find_non_digit;
+
+    const char* p { first };
+    if (p != last && *p == '-')
+        ++p;
+    const char* q { find_non_digit(p, last) };
+    if (q == p)
+        return nullptr;
+    p = q;
+    if (p != last && *p == '.')
+    {
+        q = find_non_digit(p + 1, last);
+        if (q == p + 1)
+            return nullptr;
+        p = q;
+    }
+    if (p != last && (*p == 'e' || *p == 'E'))
+    {
+        ++p;
+        if (p != last && (*p == '-' || *p == '+'))
+            ++p;
+        q = find_non_digit(p, last);
+        if (q == p)
+            return nullptr;
+        p = q;
+    }
+    if (p == last || is_number_char(*p))
+        return nullptr;
+    ValueType parsed {};
+    const std::from_chars_result result { std::from_chars(first, p, parsed) };
+    if (result.ec != std::errc() || result.ptr != p)
+        return nullptr;
+    value = parsed;
+    return p;
+}
+#endif  // CONTAINER_STREAM_IO_CHARCONV
+
+/**
+ * @brief decodes the numeric elements wholly within the current window of
+ *   source, a buffers::input_buffer of char, into out, each preceded by
+ *   separator if preceded (ie after the first element of a container)
+ * @notes
+ *   - whitespace is skipped as by std::ws, with the source locale's ctype
+ *   - elements are only consumed whole, with any separator before them, so
+ *       scanning stops before the first that is not decoded by scan_number
+ *       (eg as it crosses the end of the window), or is not preceded by
+ *       separator (eg the container suffix follows instead)
+ *   - only valid where scan_number decodes the same values as the stream
+ *       would, ie with numeric::clocalerepr or buffers::input_buffer::
+ *       classic_numbers()
+ * @return number of elements decoded, at most capacity
+ */
+template <typename SourceType, typename ValueType>
+static std::size_t scan_numbers(
+    SourceType& source, ValueType* out, const std::size_t capacity,
+    bool preceded, const char* separator, const std::size_t separator_length)
+{
+    if (capacity == 0 || !source.fill_window())
+        return 0;
+    const std::ctype<char>& ctype { source.ctype() };
+    const char* const first { source.window_begin() };
+    const char* const last { source.window_end() };
+    const char* p { first };
+    std::size_t count {};
+    for (; count != capacity; ++count, preceded = true)
+    {
+        const char* q { p };
+        if (preceded)
+        {
+            q = ctype.scan_not(std::ctype_base::space, q, last);
+            if (separator == nullptr ||
+                static_cast<std::size_t>(last - q) < separator_length ||
+                !std::equal(separator, separator + separator_length, q))
+                break;
+            q += separator_length;
+        }
+        q = ctype.scan_not(std::ctype_base::space, q, last);
+        q = scan_number(q, last, out[count]);
+        if (q == nullptr)
+            break;
+        p = q;
+    }
+    source.consume(static_cast<std::size_t>(p - first));
+    return count;
+}
+/**
+ * @brief wraps a numeric value for streaming in its C locale representation
+ * @notes ValueType expected to be a const reference for insertion, and a
+ *   non-const reference for extraction
+ */
+template <typename ValueType>
+struct number_repr
+{
+    static_assert(std::is_reference<ValueType>::value,
+                  "Value type must be a reference");
+
+    ValueType value;
+
+#ifdef CONTAINER_STREAM_IO_CHARCONV
+    /**
+     * @brief writes formatted value to a sink providing write() and
+     *   setstate(), eg buffers::output_buffer
+     */
+    template <typename SinkType>
+    void encode(SinkType& sink) const
+    {
+        char chars[max_number_length];
+        const std::to_chars_result result {
+            std::to_chars(chars, chars + max_number_length, value) };
+        if (result.ec != std::errc())
+        {
+            sink.setstate(std::ios_base::failbit);
+            return;
+        }
+        write_number(sink, chars, result.ptr);
+    }
+
+    /**
+     * @brief reads value from a source providing the window interface of
+     *   buffers::input_buffer, parsing it in place if it is wholly in the
+     *   current window, and otherwise from a copy of its chars
+     * @notes unlike num_get, a leading '+' is not accepted, as it is never
+     *   produced by to_chars
+     */
+    template <typename SourceType>
+    void decode(SourceType& source) const
+    {
+        using char_type = typename SourceType::char_type;
+
+        if (!source.fill_window())
+        {
+            source.setstate(std::ios_base::failbit);
+            return;
+        }
+        if (parse_in_window(source, value))
+            return;
+        char chars[max_number_length];
+        std::size_t length {};
+        while (source.fill_window())
+        {
+            const char_type* const first { source.window_begin() };
+            const char_type* const last { source.window_end() };
+            const char_type* p { first };
+            for (; p != last && is_number_char(*p); ++p)
+            {
+                if (length == max_number_length)
+                {
+                    source.setstate(std::ios_base::failbit);
+                    return;
+                }
+                chars[length++] = static_cast<char>(*p);
+            }
+            source.consume(static_cast<std::size_t>(p - first));
+            if (p != last)
+                break;
+        }
+        typename std::remove_reference<ValueType>::type parsed {};
+        const std::from_chars_result result {
+            std::from_chars(chars, chars + length, parsed) };
+        if (result.ec != std::errc() || result.ptr != chars + length)
+        {
+            source.setstate(std::ios_base::failbit);
+            return;
+        }
+        value = parsed;
+    }
+#endif  // CONTAINER_STREAM_IO_CHARCONV
+};
+
+/**
+ * @brief wraps value in number_repr
+ */
+template <typename ValueType>
+number_repr<ValueType&> number(ValueType& value)
+{
+    return number_repr<ValueType&> { value };
+}
+
+/**
+ * @brief stream operators for number representations
+ * @notes
+ *   - encoded to/decoded from the streambuf through buffers::output_buffer/
+ *       input_buffer
+ *   - any field width set on the ostream applies to the representation as a
+ *       whole, as with string representations
+ *   - without CONTAINER_STREAM_IO_CHARCONV, values are streamed as usual
+ */
+template <typename CharType, typename TraitsType, typename ValueType>
+std::basic_ostream<CharType, TraitsType>& operator<<(
+    std::basic_ostream<CharType, TraitsType>& ostream,
+    const number_repr<ValueType>& repr)
+{
+#ifdef CONTAINER_STREAM_IO_CHARCONV
+    if (ostream.width() > 0)
+    {
+        std::basic_ostringstream<CharType, TraitsType> oss;
+        oss << repr;
+        if (oss.fail())
+        {
+            ostream.setstate(std::ios_base::failbit);
+            return ostream;
+        }
+        return ostream << oss.str();
+    }
+    buffers::output_buffer<CharType, TraitsType> buffer { ostream };
+    if (buffer.good())
+        repr.encode(buffer);
+    buffer.flush();
+    return ostream;
+#else
+    return ostream << repr.value;
+#endif  // CONTAINER_STREAM_IO_CHARCONV
+}
+
+template <typename CharType, typename TraitsType, typename ValueType>
+std::basic_istream<CharType, TraitsType>& operator>>(
+    std::basic_istream<CharType, TraitsType>& istream,
+    const number_repr<ValueType&>& repr)
+{
+#ifdef CONTAINER_STREAM_IO_CHARCONV
+    buffers::input_buffer<CharType, TraitsType> buffer { istream };
+    if (buffer.good())
+        repr.decode(buffer);
+    return istream;
+#else
+    return istream >> repr.value;
+#endif  // CONTAINER_STREAM_IO_CHARCONV
+}
+
+}  // namespace detail
+
+/**
+ * @brief iomanip to have numeric elements of containers streamed in their C
+ *   locale representation, formatted with std::to_chars (for floating point
+ *   types, the shortest that parses back to the same value) and parsed with
+ *   std::from_chars, ignoring the stream locale and number format flags
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& clocalerepr(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_numeric_i()) = 1;
+    return stream;
+}
+
+/**
+ * @brief iomanip to have numeric elements of containers streamed with the
+ *   stream locale and number format flags (default)
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& localerepr(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_numeric_i()) = 0;
+    return stream;
+}
+
+}  // namespace numeric
+
+/**
+ * @brief contains the worker threads of input::from_stream_parallel and
+ *   output::to_stream_parallel
+ */
+namespace parallel {
+
+/**
+ * @brief threads running a task for each worker index in rounds, started
+ *   once and reused by every round, then joined on destruction (including
+ *   as the caller unwinds)
+ * @notes
+ *   - worker 0 is run on the calling thread, as are any workers whose
+ *       threads could not be started
+ *   - tasks must not throw, as they run on threads that can't rethrow
+ */
+class worker_group
+{
+public:
+    using task_type = std::function<void(std::size_t)>;
+
+    explicit worker_group(const std::size_t worker_count) :
+        worker_count_ { worker_count }
+    {
+        threads_.reserve(worker_count - 1);
+        try {
+            for (std::size_t i { 1 }; i < worker_count; ++i)
+                threads_.emplace_back(&worker_group::work, this, i);
+        } catch (const std::system_error&) {
+            // out of threads, remaining workers run on the calling thread
+        } catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    ~worker_group()
+    {
+        stop();
+    }
+
+    worker_group(const worker_group&) = delete;
+    worker_group& operator=(const worker_group&) = delete;
+
+    /**
+     * @brief runs task(i) for each worker i, returning once all have
+     */
+    void run(const task_type& task)
+    {
+        {
+            const std::lock_guard<std::mutex> lock { mutex_ };
+            task_ = &task;
+            pending_ = threads_.size();
+            ++round_;
+        }
+        started_.notify_all();
+        task(0);
+        for (std::size_t i { threads_.size() + 1 }; i < worker_count_; ++i)
+            task(i);
+        std::unique_lock<std::mutex> lock { mutex_ };
+        finished_.wait(lock, [this] { return pending_ == 0; });
+    }
+
+private:
+    void work(const std::size_t worker)
+    {
+        std::size_t last_round {};
+        for (;;)
+        {
+            const task_type* task {};
+            {
+                std::unique_lock<std::mutex> lock { mutex_ };
+                started_.wait(lock, [&] {
+                    return stopping_ || round_ != last_round; });
+                if (stopping_)
+                    return;
+                last_round = round_;
+                task = task_;
+            }
+            (*task)(worker);
+            const std::lock_guard<std::mutex> lock { mutex_ };
+            if (--pending_ == 0)
+                finished_.notify_one();
+        }
+    }
+
+    void stop()
+    {
+        {
+            const std::lock_guard<std::mutex> lock { mutex_ };
+            stopping_ = true;
+        }
+        started_.notify_all();
+        for (std::thread& thread : threads_)
+            thread.join();
+        threads_.clear();
+    }
+
+    const std::size_t worker_count_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable started_;
+    std::condition_variable finished_;
+    const task_type* task_ {};
+    std::size_t pending_ {};
+    std::size_t round_ {};
+    bool stopping_ {};
+};
+
+}  // namespace parallel
+
+/**
+ * @brief stream format settings used by input::default_formatter and
+ *   output::default_formatter, read from the stream once per top-level
+ *   from_stream/to_stream call and passed down to the formatters of nested
+ *   containers
+ */
+struct format_state
+{
+    strings::detail::repr_type repr { strings::detail::repr_type::literal };
+    bool count_hints {};
+    bool c_locale_numbers {};
+    // level of the container formatted, if carried (not read from stream)
+    nesting::detail::level nesting_level {};
+
+    /**
+     * @brief reads settings from stream, as set with strings::quotedrepr/
+     *   literalrepr, decorator::counthint/nocounthint and numeric::clocalerepr/
+     *   localerepr
+     */
+    template <typename StreamType>
+    static format_state capture(StreamType& stream)
+    {
+        format_state state;
+        state.repr = static_cast<strings::detail::repr_type>(
+            stream.iword(strings::detail::get_manip_i()));
+        state.count_hints = decorator::detail::count_hints_enabled(stream);
+        state.c_locale_numbers = numeric::detail::c_locale_enabled(stream);
+        return state;
+    }
+
+    /**
+     * @brief state for the formatters of nested containers
+     */
+    format_state nested() const noexcept
+    {
+        format_state state = *this;
+        state.nesting_level = nesting_level.nested();
+        return state;
+    }
+};
+
+/**
+ * @brief contains functions to govern input streaming/extraction of compatible
+ *   containers
+ */
+namespace input {
+
+/**
+ * @brief contains implementation details of input exception safety settings
+ */
+namespace detail {
+
+/**
+ * @brief labels for container parsing guarantee flag values
+ * @notes
+ *   - strong: elements are parsed into a new container, which is only moved
+ *       into the target if the whole serialization is parsed
+ *   - basic: elements are parsed directly into the (cleared) target, which on
+ *       failure is left holding any elements parsed so far
+ */
+enum class guarantee { strong, basic };
+
+/**
+ * @brief stream index getter for use with iword/pword to set
+ *   strongguarantee/basicguarantee
+ */
+inline int get_guarantee_i()
+{
+    static int i {std::ios_base::xalloc()};
+    return i;
+}
+
+/**
+ * @brief tests if containers should be parsed directly into their target
+ */
+template <typename StreamType>
+static bool parses_in_place(StreamType& istream)
+{
+    return static_cast<guarantee>(istream.iword(get_guarantee_i())) ==
+        guarantee::basic;
+}
+
+/**
+ * @brief stream index getter for use with iword/pword to set
+ *   sortedonly/anyorder
+ */
+inline int get_order_i()
+{
+    static int i {std::ios_base::xalloc()};
+    return i;
+}
+
+/**
+ * @brief tests if elements of ordered associative containers must be
+ *   serialized in the order of the container
+ */
+template <typename StreamType>
+static bool requires_order(StreamType& istream)
+{
+    return istream.iword(get_order_i()) != 0;
+}
+
+#ifdef CONTAINER_STREAM_IO_PMR
+/**
+ * @brief stream index getter for use with pword to set the memory resource of
+ *   parsing temporaries, see from_stream
+ */
+inline int get_resource_i()
+{
+    static int i {std::ios_base::xalloc()};
+    return i;
+}
+
+/**
+ * @brief memory resource set for parsing temporaries, or nullptr if none
+ */
+template <typename StreamType>
+static std::pmr::memory_resource* parse_resource(StreamType& istream)
+{
+    return static_cast<std::pmr::memory_resource*>(
+        istream.pword(get_resource_i()));
+}
+
+/**
+ * @brief sets the memory resource of parsing temporaries for its lifetime,
+ *   restoring the previous one on destruction (including by exception)
+ */
+template <typename StreamType>
+class resource_setter
+{
+public:
+    resource_setter(StreamType& istream, std::pmr::memory_resource* resource) :
+        istream_(istream), previous_(istream.pword(get_resource_i()))
+    {
+        istream_.pword(get_resource_i()) = resource;
+    }
+
+    resource_setter(const resource_setter&) = delete;
+    resource_setter& operator=(const resource_setter&) = delete;
+
+    ~resource_setter()
+    {
+        istream_.pword(get_resource_i()) = previous_;
+    }
+
+private:
+    StreamType& istream_;
+    void* previous_;
+};
+#endif  // CONTAINER_STREAM_IO_PMR
+
+}  // namespace detail
+
+/**
+ * @brief iomanip to make parsing of (non-array, non-tuple) containers leave
+ *   targets unmodified on failure (default)
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& strongguarantee(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_guarantee_i()) =
+        static_cast<int>(detail::guarantee::strong);
+    return stream;
+}
+
+/**
+ * @brief iomanip to make parsing of (non-array, non-tuple) containers emplace
+ *   elements directly into targets, saving a move of each container, but
+ *   leaving targets partially parsed on failure
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& basicguarantee(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_guarantee_i()) =
+        static_cast<int>(detail::guarantee::basic);
+    return stream;
+}
+
+/**
+ * @brief iomanip to make parsing of ordered associative containers (eg
+ *   std::set, std::map) fail on elements serialized out of container order,
+ *   as `to_stream` prints them
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& sortedonly(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_order_i()) = 1;
+    return stream;
+}
+
+/**
+ * @brief iomanip to accept elements of ordered associative containers in any
+ *   order (default)
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& anyorder(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_order_i()) = 0;
+    return stream;
+}
+
+/**
+ * @brief helper to default_formatter::extract_token, consumes chars of
+ *   stream matching token, setting failbit on mismatch
+ * @notes overloads as follows:
+ *   - default: matched char by char with peek()/get()
+ *   - buffers::input_buffer: matched a window at a time
+ */
+template <typename StreamType, typename CharType>
+static void match_token(
+    StreamType& istream, const CharType* token, const std::size_t length)
+{
+    const CharType* const end { token + length };
+    while (istream.good() && token != end &&
+           CharType(istream.peek()) == *token)
+    {
+        istream.get();
+        ++token;
+    }
+    if (token != end)
+        istream.setstate(std::ios_base::failbit);
+}
+
+template <typename CharType, typename TraitsType>
+static void match_token(
+    buffers::input_buffer<CharType, TraitsType>& buffer,
+    const CharType* token, const std::size_t length)
+{
+    buffer.match(token, length);
+}
+
+/**
+ * @brief default formatter for the parsing of decorators and elements in a
+ *   container serialization
+ */
+template <typename ContainerType, typename StreamType>
+struct default_formatter
+{
+    using repr_type = strings::detail::repr_type;
+    using stream_char_type = typename StreamType::char_type;
+
+    static constexpr auto decorators {
+        decorator::delimiters<ContainerType, stream_char_type>::values };
+    static constexpr auto count_hint_decorators {
+        decorator::count_hint_delimiters<stream_char_type>::values };
+    using decorator_tokens = decorator::tokens<ContainerType, stream_char_type>;
+
+    /**
+     * @brief same formatter for use with another stream type, eg
+     *   buffers::input_buffer
+     */
+    template <typename OtherStreamType>
+    using rebind = default_formatter<ContainerType, OtherStreamType>;
+
+    /**
+     * @brief constructors
+     * @notes overloads as follows:
+     *   - default: format state read from the stream on each use
+     *   - format_state: state captured beforehand, eg by from_stream
+     */
+    default_formatter() = default;
+
+    explicit default_formatter(const format_state& state) noexcept :
+        state_ { state }, captured_ { true }
+    {}
+
+    /**
+     * @brief format state used with istream, as captured or read anew
+     */
+    template <typename OtherStreamType>
+    format_state state(OtherStreamType& istream) const
+    {
+        return captured_ ? state_ : format_state::capture(istream);
+    }
+
+    /**
+     * @brief level of the container, if carried (see nesting::detail::level)
+     */
+    nesting::detail::level nesting_level() const noexcept
+    {
+        return state_.nesting_level;
+    }
+
+    /**
+     * @brief attempts stream extraction of an exact token, of length measured
+     *   at compile time (see decorator::tokens)
+     */
+    static void extract_token(StreamType& istream, const stream_char_type* token,
+                              const std::size_t length)
+    {
+        if (token == nullptr)
+        {
+            istream.setstate(std::ios_base::failbit);
+            return;
+        }
+        istream >> std::ws;
+        match_token(istream, token, length);
+        if (istream.fail())
+            instrumentation::policy::count_failed_probe();
+    }
+
+    /**
+     * @brief extracts prefix decorator from stream
+     */
+    static void parse_prefix(StreamType& istream)
+    {
+        extract_token(istream, decorators.prefix, decorator_tokens::prefix_length);
+    }
+
+    /**
+     * @brief extracts element count hint from stream, if enabled with
+     *   decorator::counthint and present
+     * @return true if a hint was extracted
+     */
+    bool parse_count_hint(StreamType& istream, std::size_t& count) const
+    {
+        if (!count_hints(istream))
+            return false;
+        istream >> std::ws;
+        if (!istream.good() ||
+            stream_char_type(istream.peek()) != *count_hint_decorators.marker)
+            return false;
+        istream.get();
+        std::size_t value {};
+        bool digits {};
+        for (auto c (istream.peek()); istream.good() &&
+                 stream_char_type(c) >= stream_char_type('0') &&
+                 stream_char_type(c) <= stream_char_type('9');
+             c = istream.peek())
+        {
+            const std::size_t digit {
+                static_cast<std::size_t>(stream_char_type(c) - stream_char_type('0')) };
+            if (value > (std::numeric_limits<std::size_t>::max() - digit) / 10)
+                break;  // overflow
+            value = value * 10 + digit;
+            digits = true;
+            istream.get();
+        }
+        if (!digits)
+            istream.setstate(std::ios_base::failbit);
+        extract_token(istream, count_hint_decorators.terminator,
+                      decorator_tokens::terminator_length);
+        count = value;
+        return istream.good();
+    }
+
+    /**
+     * @brief extracts element from stream
+     * @notes overloads as follows:
+     *   - default
+     *   - compatible containers: parsed with a formatter sharing this
+     *       formatter's format state
+     *   - numbers, in their C locale representation if set with
+     *       numeric::clocalerepr
+     *   - CharT&
+     *   - (CharT&)[] (invoked in case of nested C arrays, eg CharT[][])
+     *   - basic_string&
+     *   - basic_string_view& (see strings::viewarena)
+     */
+    template<typename ElementType>
+    static auto parse_element(StreamType& istream, ElementType& element
+        ) -> std::enable_if_t<
+            !traits::is_char_type<ElementType>::value &&
+            !traits::is_parseable_as_container<ElementType>::value &&
+            !numeric::detail::is_charconv_number<ElementType>::value,
+            void>
+    {
+        istream >> std::ws >> element;
+    }
+
+    template<typename ElementType>
+    auto parse_element(StreamType& istream, ElementType& element
+        ) const -> std::enable_if_t<
+            numeric::detail::is_charconv_number<ElementType>::value,
+            void>
+    {
+        if (c_locale_numbers(istream))
+            istream >> std::ws >> numeric::detail::number(element);
+        else
+            istream >> std::ws >> element;
+    }
+
+    template<typename ElementType>
+    auto parse_element(StreamType& istream, ElementType& element
+        ) const -> std::enable_if_t<
+            !traits::is_stl_string_type<ElementType>::value &&
+            traits::is_parseable_as_container<ElementType>::value,
+            void>
+    {
+        from_stream(istream, element, default_formatter<ElementType, StreamType>{
+            state(istream).nested() });
+    }
+
+    template<typename ElementType>
+    auto parse_element(StreamType& istream, ElementType& element
+        ) const -> std::enable_if_t<
+            traits::is_char_type<ElementType>::value,
+            void>
+    {
+        const repr_type type { repr(istream) };
+        if (type == repr_type::quoted)
+            istream >> std::ws >> strings::quoted(element);
+        else
+            istream >> std::ws >> strings::detail::unquoted(element, type);
+    }
+
+    template <typename CharType, std::size_t ArraySize>
+    auto parse_element(
+        StreamType& istream, CharType (&element)[ArraySize]
+        ) const -> std::enable_if_t<
+            traits::is_char_type<CharType>::value,
+            void>
+    {
+        std::basic_string<CharType> s;
+        const repr_type type { repr(istream) };
+        if (type == repr_type::quoted)
+            istream >> std::ws >> strings::quoted(s);
+        else
+            istream >> std::ws >> strings::detail::unquoted(s, type);
+        if (s.size() < ArraySize)
+        {
+            auto it {std::copy(s.begin(), s.end(), std::begin(element))};
+            std::fill(it, std::end(element), CharType('\0'));
+        }
+        else
+        {
+            istream.setstate(std::ios_base::failbit);
+        }
+    }
+
+    template<typename CharType, typename TraitsType, typename AllocType>
+    void parse_element(
+        StreamType& istream,
+        std::basic_string<CharType, TraitsType, AllocType>& element) const
+    {
+        const repr_type type { repr(istream) };
+        if (type == repr_type::quoted)
+            istream >> std::ws >> strings::quoted(element);
+        else
+            istream >> std::ws >> strings::detail::unquoted(element, type);
+    }
+
+#if (__cplusplus >= 201703L)
+    template<typename CharType>
+    void parse_element(StreamType& istream,
+                       std::basic_string_view<CharType>& element) const
+    {
+        const repr_type type { repr(istream) };
+        if (type == repr_type::quoted)
+            istream >> std::ws >> strings::quoted(element);
+        else
+            istream >> std::ws >> strings::detail::unquoted(element, type);
+    }
+#endif  // C++17
+
+    /**
+     * @brief extracts separator decorator from stream
+     */
+    static void parse_separator(StreamType& istream)
+    {
+        extract_token(istream, decorators.separator,
+                      decorator_tokens::separator_length);
+    }
+
+    /**
+     * @brief extracts suffix decorator from stream
+     */
+    static void parse_suffix(StreamType& istream)
+    {
+        extract_token(istream, decorators.suffix, decorator_tokens::suffix_length);
+    }
+
+    /**
+     * @brief extracts suffix decorator from stream if next, as found by
+     *   peeking at its first char
+     * @notes if the first char matches, the rest of the suffix must follow
+     * @return true if the suffix was extracted, false (without setting
+     *   failbit) if it is not next
+     */
+    static bool try_parse_suffix(StreamType& istream)
+    {
+        using traits_type = typename StreamType::traits_type;
+
+        if (decorators.suffix == nullptr)
+            return false;
+        istream >> std::ws;
+        if (decorator_tokens::suffix_length == 0)
+            return !istream.fail();
+        if (!istream.good() ||
+            !traits_type::eq_int_type(istream.peek(),
+                                      traits_type::to_int_type(*decorators.suffix)))
+            return false;
+        match_token(istream, decorators.suffix, decorator_tokens::suffix_length);
+        return !istream.fail();
+    }
+
+    /**
+     * @brief parses the run of numeric elements wholly within the window of
+     *   a buffers::input_buffer of char, each preceded by a separator if
+     *   preceded, when they decode as they would with parse_element (see
+     *   numeric::detail::scan_numbers)
+     * @return number of elements parsed into out, at most capacity; any
+     *   next element is to be parsed with parse_separator/parse_element
+     */
+    template <typename ElementType>
+    auto parse_numbers(StreamType& istream, ElementType* out,
+                       const std::size_t capacity, const bool preceded
+        ) const -> std::enable_if_t<
+            numeric::detail::is_bulk_number<ElementType>::value &&
+            std::is_same<StreamType, buffers::input_buffer<
+                char, typename StreamType::traits_type>>::value,
+            std::size_t>
+    {
+        if (!c_locale_numbers(istream) && !istream.classic_numbers())
+            return 0;
+        return numeric::detail::scan_numbers(
+            istream, out, capacity, preceded,
+            decorators.separator, decorator_tokens::separator_length);
+    }
+
+private:
+    repr_type repr(StreamType& istream) const
+    {
+        return captured_ ? state_.repr : static_cast<repr_type>(
+            istream.iword(strings::detail::get_manip_i()));
+    }
+
+    bool count_hints(StreamType& istream) const
+    {
+        return captured_ ? state_.count_hints :
+            decorator::detail::count_hints_enabled(istream);
+    }
+
+    bool c_locale_numbers(StreamType& istream) const
+    {
+        return captured_ ? state_.c_locale_numbers :
+            numeric::detail::c_locale_enabled(istream);
+    }
+
+    format_state state_ {};
+    bool captured_ {};
+};
+
+/**
+ * @brief tests for formatters that can be run against a buffers::input_buffer
+ *   in place of the istream passed to from_stream
+ * @notes only default_formatter and binary_formatter qualify, as custom
+ *   formatters may extract types or use members of StreamType not provided by
+ *   input_buffer
+ */
+template <typename FormatterType, typename StreamType, typename = void>
+struct is_bufferable_formatter : public std::false_type
+{};
+
+template <typename ContainerType, typename FormatterStreamType, typename StreamType>
+struct is_bufferable_formatter<
+    default_formatter<ContainerType, FormatterStreamType>, StreamType,
+    std::void_t<typename StreamType::char_type, typename StreamType::traits_type>>
+    : public std::is_base_of<std::basic_istream<typename StreamType::char_type,
+                                                typename StreamType::traits_type>,
+                             StreamType>
+{};
+
+/**
+ * @brief formatter for the parsing of elements of a container serialized in
+ *   binary (see namespace binary), eg as printed by output::binary_formatter
+ * @notes
+ *   - keeps the number of elements remaining in the container as state, so
+ *       a new formatter is used for each (nested) container
+ *   - only for streams of single byte chars
+ *   - std::basic_string_view elements can not be parsed
+ */
+template <typename ContainerType, typename StreamType>
+struct binary_formatter
+{
+    static_assert(sizeof(typename StreamType::char_type) == 1,
+                  "binary_formatter requires a stream of single byte chars");
+
+    /**
+     * @brief same formatter for use with another stream type, eg
+     *   buffers::input_buffer
+     */
+    template <typename OtherStreamType>
+    using rebind = binary_formatter<ContainerType, OtherStreamType>;
+
+    /**
+     * @brief constructors
+     * @notes overloads as follows:
+     *   - default: level not carried
+     *   - level: carried from the container enclosing this one, eg by
+     *       from_stream
+     */
+    binary_formatter() = default;
+
+    explicit binary_formatter(const nesting::detail::level level) noexcept :
+        level_ ( level )
+    {}
+
+    nesting::detail::level nesting_level() const noexcept
+    {
+        return level_;
+    }
+
+    void parse_prefix(StreamType& /*istream*/) const noexcept
+    {}
+
+    /**
+     * @brief extracts element count, which is required in binary
+     */
+    bool parse_count_hint(StreamType& istream, std::size_t& count) const
+    {
+        if (!binary::detail::read_size(istream, count))
+            return false;
+        remaining_ = count;
+        return true;
+    }
+
+    /**
+     * @brief extracts element from stream
+     * @notes overloads as follows:
+     *   - arithmetic and enum types
+     *   - basic_string&
+     *   - compatible containers
+     *   - other trivially copyable types, excluding pointers
+     *   - default: fails, including C strings, which are parsed into
+     *       basic_string instead
+     */
+    template <typename ElementType>
+    auto parse_element(StreamType& istream, ElementType& element
+        ) const -> std::enable_if_t<
+            binary::detail::is_value<ElementType>::value,
+            void>
+    {
+        binary::detail::read_value(istream, element);
+        count_element();
+    }
+
+    template <typename CharType, typename TraitsType, typename AllocType>
+    void parse_element(
+        StreamType& istream,
+        std::basic_string<CharType, TraitsType, AllocType>& element) const
+    {
+        binary::detail::read_string(istream, element);
+        count_element();
+    }
+
+    template <typename ElementType>
+    auto parse_element(StreamType& istream, ElementType& element
+        ) const -> std::enable_if_t<
+            traits::is_parseable_as_container<ElementType>::value,
+            void>
+    {
+        from_stream(istream, element,
+                    binary_formatter<ElementType, StreamType>{ level_.nested() });
+        count_element();
+    }
+
+    template <typename ElementType>
+    auto parse_element(StreamType& istream, ElementType& element
+        ) const -> std::enable_if_t<
+            binary::detail::is_raw<ElementType>::value,
+            void>
+    {
+        binary::detail::read_bytes(istream, &element, sizeof(ElementType));
+        count_element();
+    }
+
+    template <typename ElementType>
+    auto parse_element(StreamType& istream, ElementType& /*element*/
+        ) const -> std::enable_if_t<
+            !binary::detail::is_value<ElementType>::value &&
+            !traits::is_parseable_as_container<ElementType>::value &&
+            !binary::detail::is_raw<ElementType>::value &&
+            !traits::is_stl_string_type<ElementType>::value,
+            void>
+    {
+        istream.setstate(std::ios_base::failbit);
+    }
+
+#if (__cplusplus >= 201703L)
+    template <typename CharType>
+    void parse_element(StreamType& istream,
+                       std::basic_string_view<CharType>& /*element*/) const
+    {
+        istream.setstate(std::ios_base::failbit);
+    }
+
+#endif  // C++17
+    /**
+     * @brief extracts the elements of a contiguous container at once
+     */
+    template <typename ElementType>
+    auto parse_block(StreamType& istream, ElementType* elements,
+                     const std::size_t count
+        ) const -> std::enable_if_t<
+            binary::detail::is_value<ElementType>::value &&
+            !std::is_same<ElementType, bool>::value,
+            void>
+    {
+        binary::detail::read_block(istream, elements, count);
+        remaining_ -= std::min(remaining_, count);
+    }
+
+    void parse_separator(StreamType& /*istream*/) const noexcept
+    {}
+
+    /**
+     * @brief fails unless all counted elements have been extracted
+     */
+    void parse_suffix(StreamType& istream) const
+    {
+        if (remaining_ != 0)
+            istream.setstate(std::ios_base::failbit);
+    }
+
+    /**
+     * @brief tests if all counted elements have been extracted
+     */
+    bool try_parse_suffix(StreamType& /*istream*/) const noexcept
+    {
+        return remaining_ == 0;
+    }
+
+private:
+    void count_element() const
+    {
+        if (remaining_ != 0)
+            --remaining_;
+    }
+
+    mutable std::size_t remaining_ {};
+    nesting::detail::level level_ {};
+};
+
+template <typename ContainerType, typename FormatterStreamType, typename StreamType>
+struct is_bufferable_formatter<
+    binary_formatter<ContainerType, FormatterStreamType>, StreamType,
+    std::void_t<typename StreamType::char_type, typename StreamType::traits_type>>
+    : public std::is_base_of<std::basic_istream<typename StreamType::char_type,
+                                                typename StreamType::traits_type>,
+                             StreamType>
+{};
+
+/**
+ * @brief helper to from_stream and from_stream_parallel overloads, formatter rebound to
+ *   read from another stream type (eg a buffers::input_buffer wrapping istream)
+ * @notes
+ *   - overloads as follows:
+ *     - default_formatter: carries over format state, as captured or read
+ *         from istream, so that it is read once for the whole call
+ *     - binary_formatter
+ *     - default: rebound formatter default constructed
+ *   - level of the container (see nesting::detail::depth_guard) is carried
+ *       by default_formatter and binary_formatter to those of nested
+ *       containers
+ */
+template <typename OtherStreamType, typename ContainerType,
+          typename FormatterStreamType, typename StreamType>
+static default_formatter<ContainerType, OtherStreamType> rebind_formatter(
+    const default_formatter<ContainerType, FormatterStreamType>& formatter,
+    StreamType& istream, const nesting::detail::level level = {})
+{
+    format_state state { formatter.state(istream) };
+    state.nesting_level = level;
+    return default_formatter<ContainerType, OtherStreamType> { state };
+}
+
+template <typename OtherStreamType, typename ContainerType,
+          typename FormatterStreamType, typename StreamType>
+static binary_formatter<ContainerType, OtherStreamType> rebind_formatter(
+    const binary_formatter<ContainerType, FormatterStreamType>& /*formatter*/,
+    StreamType& /*istream*/, const nesting::detail::level level = {})
+{
+    return binary_formatter<ContainerType, OtherStreamType> { level };
+}
+
+template <typename OtherStreamType, typename FormatterType, typename StreamType>
+static typename FormatterType::template rebind<OtherStreamType> rebind_formatter(
+    const FormatterType& /*formatter*/, StreamType& /*istream*/,
+    const nesting::detail::level /*level*/ = {})
+{
+    return typename FormatterType::template rebind<OtherStreamType> {};
+}
+
+/**
+ * @brief helper to array_from_stream and extract_container overloads, calls
+ *   formatter parse_count_hint hook if provided (see
+ *   traits::has_parse_count_hint)
+ * @return true if a hint was extracted
+ */
+template <typename FormatterType, typename StreamType>
+static auto parse_count_hint(
+    const FormatterType& formatter, StreamType& istream, std::size_t& count
+    ) -> std::enable_if_t<
+        traits::has_parse_count_hint<FormatterType, StreamType>::value,
+        bool>
+{
+    return formatter.parse_count_hint(istream, count);
+}
+
+template <typename FormatterType, typename StreamType>
+static auto parse_count_hint(
+    const FormatterType& /*formatter*/, StreamType& /*istream*/,
+    std::size_t& /*count*/
+    ) -> std::enable_if_t<
+        !traits::has_parse_count_hint<FormatterType, StreamType>::value,
+        bool>
+{
+    return false;
+}
+
+/**
+ * @brief helper to extract_container overloads, extracts suffix if it is next,
+ *   to detect the end of a serialization
+ * @notes overloads as follows:
+ *   - formatter try_parse_suffix hook provided (see
+ *       traits::has_try_parse_suffix)
+ *   - default: parse_suffix attempted, clearing the stream state if the
+ *       suffix was not next
+ * @return true if the suffix was extracted
+ */
+template <typename FormatterType, typename StreamType>
+static auto extract_suffix(const FormatterType& formatter, StreamType& istream
+    ) -> std::enable_if_t<
+        traits::has_try_parse_suffix<FormatterType, StreamType>::value,
+        bool>
+{
+    return formatter.try_parse_suffix(istream);
+}
+
+template <typename FormatterType, typename StreamType>
+static auto extract_suffix(const FormatterType& formatter, StreamType& istream
+    ) -> std::enable_if_t<
+        !traits::has_try_parse_suffix<FormatterType, StreamType>::value,
+        bool>
+{
+    formatter.parse_suffix(istream);
+    if (istream.bad())
+        return false;
+    if (!istream.fail())
+        return true;
+    istream.clear();
+    return false;
+}
+
+/**
+ * @brief helper to extract_container, maximum number of elements that can be
+ *   reserved for a count hint
+ * @notes as each element takes at least one char to serialize, hints are
+ *   trusted up to the number of chars the streambuf reports as available, or
+ *   if fewer, up to a fixed minimum
+ */
+static constexpr std::size_t min_reserve_limit { 4096 };
+
+template <typename StreamType>
+static std::size_t reserve_limit(StreamType& /*istream*/)
+{
+    return min_reserve_limit;
+}
+
+template <typename CharType, typename TraitsType>
+static std::size_t reserve_limit(
+    buffers::input_buffer<CharType, TraitsType>& buffer)
+{
+    const std::streamsize available { buffer.in_avail() };
+    return available > static_cast<std::streamsize>(min_reserve_limit) ?
+        static_cast<std::size_t>(available) : min_reserve_limit;
+}
+
+/**
+ * @brief helper to extract_container and from_stream_parallel, preallocates
+ *   for a number of elements
+ * @notes overloads as follows:
+ *   - reserve() available (eg std::vector, std::unordered_(multi)(set|map))
+ *   - default: count ignored
+ */
+template <typename ContainerType>
+static auto reserve_elements(ContainerType& container, const std::size_t count
+    ) -> std::enable_if_t<
+        traits::has_reserve<ContainerType>::value,
+        void>
+{
+    container.reserve(count);
+}
+
+template <typename ContainerType>
+static auto reserve_elements(ContainerType& /*container*/,
+                             const std::size_t /*count*/
+    ) -> std::enable_if_t<
+        !traits::has_reserve<ContainerType>::value,
+        void>
+{}
+
+/**
+ * @brief helper to array_from_stream and extract_container, calls formatter
+ *   parse_block hook if provided for the elements of a contiguous container
+ *   (see traits::has_parse_block)
+ * @notes overloads as follows:
+ *   - resizable (eg std::vector): resized in steps as elements are parsed,
+ *       so that a corrupt count can't allocate beyond the stream contents
+ *   - fixed size (eg std::array, C arrays): count must be the array size
+ *   - default: no hook
+ * @return true if the elements were parsed by the hook
+ */
+template <typename FormatterType, typename StreamType, typename ContainerType>
+static auto extract_block(
+    const FormatterType& formatter, StreamType& istream,
+    ContainerType& container, std::size_t count
+    ) -> std::enable_if_t<
+        traits::has_parse_block<FormatterType, StreamType, ContainerType>::value &&
+        traits::has_resize<ContainerType>::value,
+        bool>
+{
+    using element_type =
+        typename traits::is_contiguous_container<ContainerType>::element_type;
+    const std::size_t step { 65536 / sizeof(element_type) };
+
+    container.clear();
+    while (count != 0 && istream.good())
+    {
+        const std::size_t n { std::min(count, step) };
+        const std::size_t offset { container.size() };
+        container.resize(offset + n);
+        formatter.parse_block(istream, container.data() + offset, n);
+        count -= n;
+    }
+    return true;
+}
+
+template <typename FormatterType, typename StreamType, typename ContainerType>
+static auto extract_block(
+    const FormatterType& formatter, StreamType& istream,
+    ContainerType& container, const std::size_t count
+    ) -> std::enable_if_t<
+        traits::has_parse_block<FormatterType, StreamType, ContainerType>::value &&
+        !traits::has_resize<ContainerType>::value,
+        bool>
+{
+    formatter.parse_block(istream, &*std::begin(container), count);
+    return true;
+}
+
+template <typename FormatterType, typename StreamType, typename ContainerType>
+static auto extract_block(
+    const FormatterType& /*formatter*/, StreamType& /*istream*/,
+    ContainerType& /*container*/, const std::size_t /*count*/
+    ) -> std::enable_if_t<
+        !traits::has_parse_block<FormatterType, StreamType, ContainerType>::value,
+        bool>
+{
+    return false;
+}
+
+/**
+ * @brief helper to array_from_stream and extract_container, calls formatter
+ *   parse_numbers hook if provided for the elements of a contiguous container
+ *   following the first parsed elements (see traits::has_parse_numbers)
+ * @notes overloads as follows:
+ *   - resizable (eg std::vector): appended a chunk at a time, so that
+ *       growth (and any capacity reserved) is as with emplace_back
+ *   - fixed size (eg std::array, C arrays): up to the array size
+ *   - default: no hook
+ * @return number of elements parsed by the hook, to be followed by
+ *   parse_separator/parse_element for any others
+ */
+template <typename FormatterType, typename StreamType, typename ContainerType>
+static auto extract_numbers(
+    const FormatterType& formatter, StreamType& istream,
+    ContainerType& container, const std::size_t parsed
+    ) -> std::enable_if_t<
+        traits::has_parse_numbers<FormatterType, StreamType, ContainerType>::value &&
+        traits::has_resize<ContainerType>::value,
+        std::size_t>
+{
+    using element_type =
+        typename traits::is_contiguous_container<ContainerType>::element_type;
+    static constexpr std::size_t step { 4096 / sizeof(element_type) };
+
+    element_type chunk[step];
+    std::size_t count {};
+    for (std::size_t n { step }; n == step; count += n)
+    {
+        n = formatter.parse_numbers(istream, chunk, step, parsed + count != 0);
+        container.insert(container.end(), chunk, chunk + n);
+    }
+    return count;
+}
+
+template <typename FormatterType, typename StreamType, typename ContainerType>
+static auto extract_numbers(
+    const FormatterType& formatter, StreamType& istream,
+    ContainerType& container, const std::size_t parsed
+    ) -> std::enable_if_t<
+        traits::has_parse_numbers<FormatterType, StreamType, ContainerType>::value &&
+        !traits::has_resize<ContainerType>::value,
+        std::size_t>
+{
+    const std::size_t size { static_cast<std::size_t>(
+        std::distance(std::begin(container), std::end(container))) };
+    return formatter.parse_numbers(istream, &*std::begin(container) + parsed,
+                                   size - parsed, parsed != 0);
+}
+
+template <typename FormatterType, typename StreamType, typename ContainerType>
+static auto extract_numbers(
+    const FormatterType& /*formatter*/, StreamType& /*istream*/,
+    ContainerType& /*container*/, const std::size_t /*parsed*/
+    ) -> std::enable_if_t<
+        !traits::has_parse_numbers<FormatterType, StreamType, ContainerType>::value,
+        std::size_t>
+{
+    return 0;
+}
+
+/**
+ * @brief helper to array_from_stream and extract_container overloads, used to
+ *   move elements which themselves may be nested containers with C arrays at
+ *   some level of nesting
+ */
+template<typename ContainerType>
+static auto c_array_compatible_move_assignment(ContainerType& source,
+                                               ContainerType& target
+    ) -> std::enable_if_t<
+        std::is_move_assignable<ContainerType>::value,
+        void>
+{
+    target = std::move(source);
+}
+
+// TBD can this be improved with std::make_move_iterator?
+template<typename ElementType, std::size_t ArraySize>
+static void c_array_compatible_move_assignment(ElementType (&source)[ArraySize],
+                                               ElementType (&target)[ArraySize])
+{
+    auto t_end {std::end(target)};
+    for (auto s_it {std::begin(source)}, t_it {std::begin(target)};
+         t_it != t_end; ++s_it, ++t_it)
+    {
+        c_array_compatible_move_assignment(*s_it, *t_it);
+    }
+}
+
+// TBD can the relevant extract_container overloads be combined instead with a SFINAE
+//   struct is_array, while not letting CharT[] types decay to CharT*?
+/**
+ * @brief wraps logic for C array and std::array overloads of extract_container
+ */
+template <typename ContainerType, typename StreamType, typename FormatterType>
+static StreamType& array_from_stream(
+    StreamType& istream, ContainerType& container,
+    const FormatterType& formatter)
+{
+    formatter.parse_prefix(istream);
+    if (!istream.good())
+        return istream;
+
+    // wrong-length serializations can be rejected before parsing elements
+    std::size_t count_hint {};
+    if (parse_count_hint(formatter, istream, count_hint) &&
+        count_hint != static_cast<std::size_t>(
+            std::distance(std::begin(container), std::end(container))))
+        istream.setstate(std::ios_base::failbit);
+    if (!istream.good())
+        return istream;
+
+    if (container_stream_io::traits::is_empty(container)) {
+        formatter.parse_suffix(istream);
+        return istream;
+    }
+
+    const std::size_t size { static_cast<std::size_t>(
+        std::distance(std::begin(container), std::end(container))) };
+    ContainerType temp_container;
+    if (extract_block(formatter, istream, temp_container, size)) {
+        formatter.parse_suffix(istream);
+        if (istream.good())
+        {
+            instrumentation::policy::count_elements(size);
+            c_array_compatible_move_assignment(temp_container, container);
+        }
+        return istream;
+    }
+    auto tc_it {std::begin(temp_container)};
+    auto tc_end {std::end(temp_container)};
+
+    std::size_t parsed { extract_numbers(formatter, istream, temp_container, 0) };
+    if (parsed == 0) {
+        formatter.parse_element(istream, *tc_it);
+        if (!istream.good())
+            return istream;
+        parsed = 1;
+    }
+    std::advance(tc_it, parsed);
+
+    while (!istream.eof() && tc_it != tc_end) {
+        formatter.parse_separator(istream);
+        if (!istream.good())
+            return istream;
+
+        formatter.parse_element(istream, *tc_it);
+        if (!istream.good())
+            return istream;
+        ++parsed;
+        // resumes bulk parsing after an element it left, eg across windows
+        const std::size_t run {
+            extract_numbers(formatter, istream, temp_container, parsed) };
+        parsed += run;
+        std::advance(tc_it, run + 1);
+    }
+
+    if (tc_it != tc_end) {  // serialization too short
+        istream.setstate(std::ios_base::failbit);
+        return istream;
+    }
+
+    formatter.parse_suffix(istream);  // fails if serialization too long
+    if (istream.good())
+    {
+        instrumentation::policy::count_elements(size);
+        c_array_compatible_move_assignment(temp_container, container);
+    }
+    return istream;
+}
+
+/**
+ * @brief helper to extract_container(tuple), recursive struct meant to unpack
+ *   and parse std::tuple elements
+ * @notes overloads as follows:
+ *   - default
+ *   - last element in tuple
+ */
+template <typename TupleType, std::size_t Index, std::size_t Last>
+struct tuple_handler
+{
+    template <typename StreamType, typename FormatterType>
+    static void parse(
+        StreamType& istream, TupleType& tuple, const FormatterType& formatter)
+    {
+        if (istream.good())
+            formatter.parse_element(istream, std::get<Index>(tuple));
+        if (istream.good())
+        {
+            instrumentation::policy::count_elements(1);
+            formatter.parse_separator(istream);
+        }
+        if (istream.good())
+            tuple_handler<TupleType, Index + 1, Last>::parse(istream, tuple, formatter);
+    }
+};
+
+template <typename TupleType, std::size_t Index>
+struct tuple_handler<TupleType, Index, Index>
+{
+    template <typename StreamType, typename FormatterType>
+    static void parse(
+        StreamType& istream, TupleType& tuple, const FormatterType& formatter) noexcept
+    {
+        if (istream.good())
+            formatter.parse_element(istream, std::get<Index>(tuple));
+        if (istream.good())
+            instrumentation::policy::count_elements(1);
+    }
+};
+
+/**
+ * @brief type into which container elements are parsed before emplacement
+ * @notes std::pair elements with const .first (used for
+ *   std::(unordered_)(multi)map) are parsed without const, so that the key can
+ *   also be moved into the container
+ */
+template <typename ElementType>
+struct parsed_element
+{
+    using type = ElementType;
+};
+
+template <typename FirstType, typename SecondType>
+struct parsed_element<std::pair<const FirstType, SecondType>>
+{
+    using type = std::pair<FirstType, SecondType>;
+};
+
+/**
+ * @brief uses-allocator construction of parsing temporaries, so that
+ *   allocator-aware elements (eg std::pmr::string) are parsed with the
+ *   allocator of their container instead of a default constructed one
+ * @notes construct() overloads as follows:
+ *   - allocator passed after leading std::allocator_arg (eg std::tuple)
+ *   - allocator passed as only argument (eg STL containers)
+ *   - default: value initialized, as ElementType does not use the allocator
+ *   - std::pair: each member constructed with the allocator, as pairs are not
+ *       allocator-aware themselves
+ */
+template <typename ElementType>
+struct element_constructor
+{
+    template <typename AllocatorType>
+    static auto construct(const AllocatorType& allocator
+        ) -> std::enable_if_t<
+            std::uses_allocator<ElementType, AllocatorType>::value &&
+            std::is_constructible<ElementType, std::allocator_arg_t,
+                                  const AllocatorType&>::value,
+            ElementType>
+    {
+        return ElementType(std::allocator_arg, allocator);
+    }
+
+    template <typename AllocatorType>
+    static auto construct(const AllocatorType& allocator
+        ) -> std::enable_if_t<
+            std::uses_allocator<ElementType, AllocatorType>::value &&
+            !std::is_constructible<ElementType, std::allocator_arg_t,
+                                   const AllocatorType&>::value &&
+            std::is_constructible<ElementType, const AllocatorType&>::value,
+            ElementType>
+    {
+        return ElementType(allocator);
+    }
+
+    template <typename AllocatorType>
+    static auto construct(const AllocatorType& /*allocator*/
+        ) -> std::enable_if_t<
+            !std::uses_allocator<ElementType, AllocatorType>::value ||
+            (!std::is_constructible<ElementType, std::allocator_arg_t,
+                                    const AllocatorType&>::value &&
+             !std::is_constructible<ElementType, const AllocatorType&>::value),
+            ElementType>
+    {
+        return ElementType {};
+    }
+};
+
+template <typename FirstType, typename SecondType>
+struct element_constructor<std::pair<FirstType, SecondType>>
+{
+    template <typename AllocatorType>
+    static std::pair<FirstType, SecondType> construct(
+        const AllocatorType& allocator)
+    {
+        return std::pair<FirstType, SecondType>(
+            element_constructor<typename std::remove_const<FirstType>::type
+                                >::construct(allocator),
+            element_constructor<SecondType>::construct(allocator));
+    }
+};
+
+/**
+ * @brief helper to construct_like and construct_parsed, allocator of container
+ * @notes overloads as follows:
+ *   - get_allocator() available
+ *   - default: std::allocator, as used by default construction
+ */
+template <typename ContainerType>
+static auto allocator_of(const ContainerType& container
+    ) -> std::enable_if_t<
+        traits::has_get_allocator<ContainerType>::value,
+        decltype(container.get_allocator())>
+{
+    return container.get_allocator();
+}
+
+template <typename ContainerType>
+static auto allocator_of(const ContainerType& /*container*/
+    ) -> std::enable_if_t<
+        !traits::has_get_allocator<ContainerType>::value,
+        std::allocator<char>>
+{
+    return std::allocator<char> {};
+}
+
+/**
+ * @brief constructs a temporary to parse the value of element into, with the
+ *   allocator of element
+ * @notes used for temporary containers, which then keep the allocator of
+ *   their target when moved into it, and for std::pair members
+ */
+template <typename ElementType>
+static ElementType construct_like(const ElementType& element)
+{
+    return element_constructor<ElementType>::construct(allocator_of(element));
+}
+
+/**
+ * @brief constructs the temporary into which elements of container are parsed
+ * @notes with a memory resource set for parsing temporaries (see
+ *   from_stream), elements with polymorphic allocators are constructed on that
+ *   resource, otherwise elements are constructed with the allocator of
+ *   container
+ */
+template <typename ElementType, typename StreamType, typename ContainerType>
+static ElementType construct_parsed(
+    StreamType& istream, const ContainerType& container)
+{
+#ifdef CONTAINER_STREAM_IO_PMR
+    if (std::pmr::memory_resource* const resource {
+            detail::parse_resource(istream) }) {
+        return element_constructor<ElementType>::construct(
+            std::pmr::polymorphic_allocator<ElementType>(resource));
+    }
+#else
+    static_cast<void>(istream);
+#endif  // CONTAINER_STREAM_IO_PMR
+    return element_constructor<ElementType>::construct(allocator_of(container));
+}
+
+/**
+ * @brief helper to default extract_container overload, uses appropriate
+ *   emplacement method based on container type to move in a parsed element
+ * @notes overloads as follows:
+ *   - emplace_back (preferred over other emplace methods)
+ *   - ordered associative containers: emplace_hint at end(), which takes
+ *       amortized constant time for elements in container order, as printed
+ *       by to_stream, and falls back on a regular search for any other
+ *   - no emplace_back, but emplace (no const iterator needed) available
+ */
+template<typename ContainerType, typename ElementType>
+static auto emplace_element(ContainerType& container, ElementType&& element
+    ) -> std::enable_if_t<
+        traits::has_emplace_back<ContainerType>::value,
+        void>
+{
+    container.emplace_back(std::move(element));
+}
+
+template <typename ContainerType, typename ElementType>
+static auto emplace_element(ContainerType& container, ElementType&& element
+    ) -> std::enable_if_t<
+        traits::has_key_compare<ContainerType>::value &&
+        !traits::has_emplace_back<ContainerType>::value,
+        void>
+{
+    container.emplace_hint(container.end(), std::move(element));
+}
+
+template <typename ContainerType, typename ElementType>
+static auto emplace_element(ContainerType& container, ElementType&& element
+    ) -> std::enable_if_t<
+        traits::has_iterless_emplace<ContainerType>::value &&
+        !traits::has_key_compare<ContainerType>::value &&
+        !traits::has_emplace_back<ContainerType>::value,
+        void>
+{
+    container.emplace(std::move(element));
+}
+
+/**
+ * @brief helper to sorted_after, key by which an element is ordered
+ * @notes overloads as follows:
+ *   - sets: element itself
+ *   - maps: first of (key, value) pair
+ */
+template <typename ContainerType, typename ElementType>
+static auto ordered_key(const ElementType& element
+    ) -> std::enable_if_t<
+        std::is_same<typename ContainerType::key_type,
+                     typename ContainerType::value_type>::value,
+        const ElementType&>
+{
+    return element;
+}
+
+template <typename ContainerType, typename ElementType>
+static auto ordered_key(const ElementType& element
+    ) -> std::enable_if_t<
+        !std::is_same<typename ContainerType::key_type,
+                      typename ContainerType::value_type>::value,
+        decltype((element.first))>
+{
+    return element.first;
+}
+
+/**
+ * @brief helper to extract_container and extract_container_parallel, tests
+ *   that element is not ordered before the last element of container
+ * @notes overloads as follows:
+ *   - ordered associative containers
+ *   - default: always in order
+ */
+template <typename ContainerType, typename ElementType>
+static auto sorted_after(const ContainerType& container, const ElementType& element
+    ) -> std::enable_if_t<
+        traits::has_key_compare<ContainerType>::value,
+        bool>
+{
+    return container.empty() || !container.key_comp()(
+        ordered_key<ContainerType>(element),
+        ordered_key<ContainerType>(*std::prev(container.end())));
+}
+
+template <typename ContainerType, typename ElementType>
+static auto sorted_after(const ContainerType& /*container*/,
+                         const ElementType& /*element*/
+    ) -> std::enable_if_t<
+        !traits::has_key_compare<ContainerType>::value,
+        bool>
+{
+    return true;
+}
+
+/**
+ * @brief helper to extract_container_parallel, tests that no element of
+ *   pieces is ordered before the one preceding it, by the ordering of
+ *   container
+ * @notes overloads as follows:
+ *   - ordered associative containers
+ *   - default: always in order
+ */
+template <typename ContainerType, typename PieceType>
+static auto sorted_pieces(const ContainerType& container,
+                          const std::vector<PieceType>& pieces
+    ) -> std::enable_if_t<
+        traits::has_key_compare<ContainerType>::value,
+        bool>
+{
+    const auto comp { container.key_comp() };
+    const typename PieceType::value_type* last { nullptr };
+    for (const PieceType& piece : pieces)
+    {
+        for (const auto& element : piece)
+        {
+            if (last != nullptr && comp(ordered_key<ContainerType>(element),
+                                        ordered_key<ContainerType>(*last)))
+                return false;
+            last = &element;
+        }
+    }
+    return true;
+}
+
+template <typename ContainerType, typename PieceType>
+static auto sorted_pieces(const ContainerType& /*container*/,
+                          const std::vector<PieceType>& /*pieces*/
+    ) -> std::enable_if_t<
+        !traits::has_key_compare<ContainerType>::value,
+        bool>
+{
+    return true;
+}
+
+/**
+ * @brief helper to from_stream, extraction of compatible container type
+ * @notes overloads as follows:
+ *   - C array
+ *   - std::array
+ *   - std::tuple<T...>
+ *   - std::tuple<>
+ *   - std::pair
+ *   - std::forward_list: unique overload required due to forward_list not
+ *       having emplace(_back) or an easy way to get an iterator to the last
+ *       element (end(), but no --it)
+ *   - default: intended for "iterable" STL containers (see
+ *       traits::is_parseable_as_container)
+ */
+template <typename ElementType, std::size_t ArraySize,
+          typename StreamType, typename FormatterType>
+static StreamType& extract_container(
+    StreamType& istream, ElementType (&container)[ArraySize],
+    const FormatterType& formatter)
+{
+    return array_from_stream(istream, container, formatter);
+}
+
+template <typename ElementType, std::size_t ArraySize,
+          typename StreamType, typename FormatterType>
+static StreamType& extract_container(
+    StreamType& istream, std::array<ElementType, ArraySize>& container,
+    const FormatterType& formatter)
+{
+    return array_from_stream(istream, container, formatter);
+}
+
+template <typename StreamType, typename FormatterType, typename... TupleArgs>
+static StreamType& extract_container(
+    StreamType& istream, std::tuple<TupleArgs...>& container,
+    const FormatterType& formatter)
+{
+    using ContainerType = std::decay_t<decltype(container)>;
+
+    ContainerType temp;
+    formatter.parse_prefix(istream);
+    tuple_handler<ContainerType, 0, sizeof...(TupleArgs) - 1
+                  >::parse(istream, temp, formatter);
+    formatter.parse_suffix(istream);
+    // C arrays not allowed as STL container members due to non-move-
+    //   constructiblity, so no need for c_array_compatible_move_assignment
+    if (istream.good())
+        container = std::move(temp);
+    return istream;
+}
+
+template <typename StreamType, typename FormatterType>
+static StreamType& extract_container(
+    StreamType& istream, std::tuple<>& /*container*/,
+    const FormatterType& formatter)
+{
+    // no contents to parse, only checks if prefix or suffix properly encoded
+    formatter.parse_prefix(istream);
+    formatter.parse_suffix(istream);
+    return istream;
+}
+
+template <typename FirstType, typename SecondType,
+          typename StreamType, typename FormatterType>
+static StreamType& extract_container(
+    StreamType& istream, std::pair<FirstType, SecondType>& container,
+    const FormatterType& formatter)
+{
+    formatter.parse_prefix(istream);
+    if (!istream.good())
+        return istream;
+
+    // pairs are commonly encountered as elements of std::(unordered_)(multi)(sets|map)s,
+    //   in which case keys are const regardless of key type passed to container template
+    using BaseFirstType = typename std::remove_const<FirstType>::type;
+    BaseFirstType first = construct_like<BaseFirstType>(container.first);
+    SecondType second = construct_like(container.second);
+
+    formatter.parse_element(istream, first);
+    if (!istream.good())
+        return istream;
+
+    formatter.parse_separator(istream);
+    if (!istream.good())
+        return istream;
+
+    formatter.parse_element(istream, second);
+    if (!istream.good())
+        return istream;
+
+    formatter.parse_suffix(istream);
+    if (istream.bad() || istream.fail())
+        return istream;
+    instrumentation::policy::count_elements(2);
+
+    // C arrays not allowed as STL container members due to non-move-
+    //   constructiblity, so no need for c_array_compatible_move_assignment
+    const_cast<BaseFirstType&>(container.first) = std::move(first);
+    container.second = std::move(second);
+
+    return istream;
+}
+
+template <typename StreamType, typename ElementType, typename AllocatorType,
+          typename FormatterType>
+static StreamType& extract_container(
+    StreamType& istream, std::forward_list<ElementType, AllocatorType>& container,
+    const FormatterType& formatter)
+{
+    formatter.parse_prefix(istream);
+    if (!istream.good())
+        return istream;
+
+    // no preallocation possible, but hint still validated
+    std::size_t count_hint {};
+    parse_count_hint(formatter, istream, count_hint);
+    if (!istream.good())
+        return istream;
+
+    const bool in_place { detail::parses_in_place(istream) };
+    std::forward_list<ElementType, AllocatorType> temp_container =
+        construct_like(container);
+    std::forward_list<ElementType, AllocatorType>& new_container {
+        in_place ? container : temp_container };
+    // moved-from temp_elem is reused, as parsing assigns it anew
+    ElementType temp_elem = construct_parsed<ElementType>(istream, container);
+
+    // parse suffix to check for empty container
+    if (extract_suffix(formatter, istream)) {
+        container.clear();
+        return istream;
+    }
+
+    new_container.clear();
+    auto nc_it { new_container.before_begin() };
+    formatter.parse_element(istream, temp_elem);
+    if (!istream.good())
+        return istream;
+    new_container.emplace_after(nc_it, std::move(temp_elem));
+    instrumentation::policy::count_elements(1);
+    // forward_list iterators are not affected by new emplacements, therefore
+    //   nc_it can continue to be used as indicating position before last element
+    ++nc_it;
+
+    while (!istream.eof()) {
+        // parse suffix first to detect end of serialization
+        if (extract_suffix(formatter, istream))
+            break;
+
+        formatter.parse_separator(istream);
+        if (!istream.good())
+            return istream;
+
+        formatter.parse_element(istream, temp_elem);
+        if (!istream.good())
+            return istream;
+        new_container.emplace_after(nc_it, std::move(temp_elem));
+        instrumentation::policy::count_elements(1);
+        ++nc_it;
+    }
+
+    // C arrays not allowed as STL container members due to non-move-
+    //   constructiblity, so no need for c_array_compatible_move_assignment
+    if (istream.good() && !in_place)
+        container = std::move(new_container);
+    return istream;
+}
+
+// TBD use of clear could be avoided with container = ContainerType{}
+template <typename ContainerType, typename StreamType, typename FormatterType>
+static StreamType& extract_container(
+    StreamType& istream, ContainerType& container,
+    const FormatterType& formatter)
+{
+    formatter.parse_prefix(istream);
+    if (!istream.good())
+        return istream;
+
+    const bool in_place { detail::parses_in_place(istream) };
+    ContainerType temp_container = construct_like(container);
+    ContainerType& new_container { in_place ? container : temp_container };
+
+    std::size_t count_hint {};
+    const bool hinted { parse_count_hint(formatter, istream, count_hint) };
+    if (hinted)
+        reserve_elements(new_container,
+                         std::min(count_hint, reserve_limit(istream)));
+    if (!istream.good())
+        return istream;
+    // moved-from temp_elem is reused, as parsing assigns it anew
+    using element_type =
+        typename parsed_element<typename ContainerType::value_type>::type;
+    element_type temp_elem = construct_parsed<element_type>(istream, container);
+    const bool ordered { traits::has_key_compare<ContainerType>::value &&
+                         detail::requires_order(istream) };
+
+    // parse suffix to check for empty container
+    if (extract_suffix(formatter, istream)) {
+        container.clear();
+        return istream;
+    }
+
+    new_container.clear();
+    if (hinted && extract_block(formatter, istream, new_container, count_hint)) {
+        formatter.parse_suffix(istream);
+        if (istream.good())
+            instrumentation::policy::count_elements(count_hint);
+        if (istream.good() && !in_place)
+            container = std::move(new_container);
+        return istream;
+    }
+    std::size_t parsed { extract_numbers(formatter, istream, new_container, 0) };
+    if (parsed == 0) {
+        formatter.parse_element(istream, temp_elem);
+        if (!istream.good())
+            return istream;
+        emplace_element(new_container, std::move(temp_elem));
+        parsed = 1;
+    }
+    instrumentation::policy::count_elements(parsed);
+
+    while (!istream.eof()) {
+        // parse suffix first to detect end of serialization
+        if (extract_suffix(formatter, istream))
+            break;
+
+        formatter.parse_separator(istream);
+        if (!istream.good())
+            return istream;
+
+        formatter.parse_element(istream, temp_elem);
+        if (!istream.good())
+            return istream;
+        if (ordered && !sorted_after(new_container, temp_elem)) {
+            istream.setstate(std::ios_base::failbit);
+            return istream;
+        }
+        emplace_element(new_container, std::move(temp_elem));
+        ++parsed;
+        // resumes bulk parsing after an element it left, eg across windows
+        const std::size_t run {
+            extract_numbers(formatter, istream, new_container, parsed) };
+        parsed += run;
+        instrumentation::policy::count_elements(1 + run);
+    }
+
+    // C arrays not allowed as STL container members due to non-move-
+    //   constructiblity, so no need for c_array_compatible_move_assignment
+    if (istream.good() && !in_place)
+        container = std::move(new_container);
+    return istream;
+}
+
+/**
+ * @brief helper to from_stream, extraction of STL container adaptors, parsed
+ *   as their underlying container, which is then moved (or with
+ *   basicguarantee emplaced) into the adaptor whole instead of pushed to it
+ *   element by element
+ * @notes overloads as follows:
+ *   - std::stack, std::queue: serialized bottom to top and front to back
+ *   - std::priority_queue: heap order restored with a single std::make_heap
+ */
+template <typename ElementType, typename UnderlyingType,
+          typename StreamType, typename FormatterType>
+static StreamType& extract_container(
+    StreamType& istream, std::stack<ElementType, UnderlyingType>& container,
+    const FormatterType& formatter)
+{
+    using access = traits::adaptor_access<std::stack<ElementType, UnderlyingType>>;
+
+    return extract_container(istream, access::container(container), formatter);
+}
+
+template <typename ElementType, typename UnderlyingType,
+          typename StreamType, typename FormatterType>
+static StreamType& extract_container(
+    StreamType& istream, std::queue<ElementType, UnderlyingType>& container,
+    const FormatterType& formatter)
+{
+    using access = traits::adaptor_access<std::queue<ElementType, UnderlyingType>>;
+
+    return extract_container(istream, access::container(container), formatter);
+}
+
+template <typename ElementType, typename UnderlyingType, typename CompareType,
+          typename StreamType, typename FormatterType>
+static StreamType& extract_container(
+    StreamType& istream,
+    std::priority_queue<ElementType, UnderlyingType, CompareType>& container,
+    const FormatterType& formatter)
+{
+    using access = traits::adaptor_access<
+        std::priority_queue<ElementType, UnderlyingType, CompareType>>;
+
+    UnderlyingType& underlying { access::container(container) };
+    extract_container(istream, underlying, formatter);
+    // also needed after failure, with elements emplaced by basicguarantee
+    if (istream.good() || detail::parses_in_place(istream))
+        std::make_heap(underlying.begin(), underlying.end(),
+                       access::compare(container));
+    return istream;
+}
+
+/**
+ * @brief stream extraction of compatible container type
+ * @notes overloads as follows:
+ *   - default: formatter used as given
+ *   - bufferable: default_formatter reading from an istream, rebound to read
+ *       from a buffers::input_buffer wrapping that istream, which is then
+ *       shared by all nested containers
+ */
+template <typename ContainerType, typename StreamType, typename FormatterType>
+static auto from_stream(
+    StreamType& istream, ContainerType& container,
+    const FormatterType& formatter
+    ) -> std::enable_if_t<
+        !is_bufferable_formatter<FormatterType, StreamType>::value,
+        StreamType&>
+{
+    const nesting::detail::depth_guard<StreamType> depth {
+        istream, nesting::detail::carried_level(formatter),
+        nesting::detail::has_opaque_elements<ContainerType>::value };
+    if (depth.exceeded())
+    {
+        istream.setstate(std::ios_base::failbit);
+        return istream;
+    }
+    const instrumentation::input_scope<StreamType> scope { istream };
+    return extract_container(istream, container, formatter);
+}
+
+template <typename ContainerType, typename StreamType, typename FormatterType>
+static auto from_stream(
+    StreamType& istream, ContainerType& container,
+    const FormatterType& formatter
+    ) -> std::enable_if_t<
+        is_bufferable_formatter<FormatterType, StreamType>::value,
+        StreamType&>
+{
+    using buffer_type = buffers::input_buffer<
+        typename StreamType::char_type, typename StreamType::traits_type>;
+
+    const nesting::detail::depth_guard<StreamType> depth {
+        istream, nesting::detail::carried_level(formatter),
+        nesting::detail::has_opaque_elements<ContainerType>::value };
+    if (depth.exceeded())
+    {
+        istream.setstate(std::ios_base::failbit);
+        return istream;
+    }
+    const instrumentation::input_scope<StreamType> scope { istream };
+    buffer_type buffer { istream };
+    if (buffer.good())
+        extract_container(buffer, container, rebind_formatter<buffer_type>(
+            formatter, istream, depth.current()));
+
+    return istream;
+}
+
+#ifdef CONTAINER_STREAM_IO_PMR
+/**
+ * @brief stream extraction of compatible container type, with the
+ *   temporaries of parsing allocated from resource
+ * @notes
+ *   - elements with polymorphic allocators (eg std::pmr::string) of all
+ *       nested containers are parsed into temporaries on resource, eg a
+ *       std::pmr::monotonic_buffer_resource reused between loads, and only
+ *       then moved into their containers
+ *   - containers keep their own allocators, so a container constructed on
+ *       resource also has its elements allocated from it
+ *   - resource is set in the pword of istream for the duration of parsing
+ */
+template <typename ContainerType, typename StreamType, typename FormatterType>
+static StreamType& from_stream(
+    StreamType& istream, ContainerType& container,
+    const FormatterType& formatter, std::pmr::memory_resource* const resource)
+{
+    const detail::resource_setter<StreamType> setter { istream, resource };
+    return from_stream(istream, container, formatter);
+}
+#endif  // CONTAINER_STREAM_IO_PMR
+
+/**
+ * @brief stream extraction of compatible container type, with the formatter
+ *   selected by stream format state: input::binary_formatter if set with
+ *   binary::binaryrepr, otherwise input::default_formatter
+ * @notes overloads as follows:
+ *   - streams of single byte chars
+ *   - default: binary not available, default_formatter used
+ */
+template <typename ContainerType, typename StreamType>
+static auto from_stream_selected(StreamType& istream, ContainerType& container
+    ) -> std::enable_if_t<
+        sizeof(typename StreamType::char_type) == 1,
+        StreamType&>
+{
+    if (binary::detail::binary_enabled(istream))
+        return from_stream(istream, container,
+                           binary_formatter<ContainerType, StreamType>{});
+    return from_stream(istream, container,
+                       default_formatter<ContainerType, StreamType>{});
+}
+
+template <typename ContainerType, typename StreamType>
+static auto from_stream_selected(StreamType& istream, ContainerType& container
+    ) -> std::enable_if_t<
+        sizeof(typename StreamType::char_type) != 1,
+        StreamType&>
+{
+    return from_stream(istream, container,
+                       default_formatter<ContainerType, StreamType>{});
+}
+
+/**
+ * @brief finds the ends of elements in a container serialization without
+ *   parsing them, by tracking nesting of decorators and string encodings
+ * @notes
+ *   - state is kept between calls to find(), so a serialization can be
+ *       scanned in consecutive ranges
+ *   - nesting is tracked with the prefix and suffix chars of the default
+ *       decorators ([{(< and ]})>), and strings with the delims and escape of
+ *       the default quoted/literal encodings (" or ' and \), so any other
+ *       elements must not contain these chars
+ */
+template <typename CharType>
+class structure_scanner
+{
+public:
+    /**
+     * @brief finds first char in [first, last) outside of any string that is
+     *   either stop or an unmatched suffix at the outermost level of nesting
+     * @return last if not found
+     */
+    const CharType* find(const CharType* first, const CharType* last,
+                         const CharType stop)
+    {
+        while (first != last)
+        {
+            if (in_string_)
+            {
+                if (escaped_)
+                {
+                    escaped_ = false;
+                    ++first;
+                    continue;
+                }
+                first = strings::detail::find_quoted_escape(
+                    first, last, delim_, CharType('\\'));
+                if (first == last)
+                    break;
+                if (*first == delim_)
+                    in_string_ = false;
+                else
+                    escaped_ = true;
+                ++first;
+                continue;
+            }
+            const CharType c { *first };
+            if (depth_ == 0 && c == stop)
+                return first;
+            if (c == CharType('"') || c == CharType('\''))
+            {
+                in_string_ = true;
+                delim_ = c;
+            }
+            else if (c == CharType('[') || c == CharType('{') ||
+                     c == CharType('(') || c == CharType('<'))
+            {
+                ++depth_;
+            }
+            else if (c == CharType(']') || c == CharType('}') ||
+                     c == CharType(')') || c == CharType('>'))
+            {
+                if (depth_ == 0)
+                    return first;
+                --depth_;
+            }
+            ++first;
+        }
+        return last;
+    }
+
+    std::size_t depth() const
+    {
+        return depth_;
+    }
+
+    bool in_string() const
+    {
+        return in_string_;
+    }
+
+private:
+    std::size_t depth_ {};
+    CharType delim_ {};
+    bool in_string_ {};
+    bool escaped_ {};
+};
+
+/**
+ * @brief tests for containers and formatters that can be used with
+ *   from_stream_parallel, ie bufferable default_formatter and containers with
+ *   emplacement not requiring a position (excluding arrays, tuples, pairs,
+ *   and std::forward_list)
+ */
+template <typename ContainerType, typename FormatterType, typename StreamType>
+struct is_parallel_extractable : public std::false_type
+{};
+
+template <typename ContainerType, typename FormatterContainerType,
+          typename FormatterStreamType, typename StreamType>
+struct is_parallel_extractable<
+    ContainerType, default_formatter<FormatterContainerType, FormatterStreamType>,
+    StreamType> : public std::integral_constant<
+    bool,
+    is_bufferable_formatter<default_formatter<FormatterContainerType,
+                                              FormatterStreamType>,
+                            StreamType>::value &&
+    !traits::is_container_adaptor<ContainerType>::value &&
+    (traits::has_emplace_back<ContainerType>::value ||
+     traits::has_iterless_emplace<ContainerType>::value)>
+{};
+
+/**
+ * @brief helper to extract_container_parallel, parses the elements of one
+ *   piece of a serialization, which is all of the piece's stream
+ * @notes formatter is rebound to read from a buffers::input_buffer, with
+ *   format state captured, as shared by all pieces
+ * @return true if the whole piece was parsed
+ */
+template <typename ElementType, typename StreamType, typename FormatterType>
+static bool extract_piece(
+    StreamType& istream, std::deque<ElementType>& elements,
+    const bool leading_separator, const FormatterType& formatter)
+{
+    using buffer_type = buffers::input_buffer<
+        typename StreamType::char_type, typename StreamType::traits_type>;
+
+    buffer_type buffer { istream };
+    if (leading_separator && buffer.good())
+        formatter.parse_separator(buffer);
+    // moved-from temp_elem is reused, as parsing assigns it anew
+    ElementType temp_elem;
+    while (buffer.good())
+    {
+        formatter.parse_element(buffer, temp_elem);
+        if (buffer.fail())
+            return false;
+        elements.emplace_back(std::move(temp_elem));
+        instrumentation::policy::count_elements(1);
+        if (!buffer.eof())
+            buffer >> std::ws;
+        if (buffer.eof())
+            return !buffer.fail();
+        formatter.parse_separator(buffer);
+    }
+    return false;
+}
+
+/**
+ * @brief helper to from_stream_parallel, splits the serialization at the
+ *   front of the get area of istream into pieces at separators, parses them
+ *   concurrently, then emplaces the elements in order
+ * @return false if the serialization is not wholly in the get area, is too
+ *   small to split, or fails to parse, with istream and container unchanged
+ */
+template <typename ContainerType, typename StreamType, typename FormatterType>
+static bool extract_container_parallel(
+    StreamType& istream, ContainerType& container,
+    const FormatterType& formatter, const std::size_t thread_count)
+{
+    using char_type = typename StreamType::char_type;
+    using traits_type = typename StreamType::traits_type;
+    using buffer_type = buffers::input_buffer<char_type, traits_type>;
+    using buffered_formatter_type =
+        typename FormatterType::template rebind<buffer_type>;
+    using span_type = buffers::span_streambuf<char_type, traits_type>;
+    using piece_stream_type = std::basic_istream<char_type, traits_type>;
+    using element_type =
+        typename parsed_element<typename ContainerType::value_type>::type;
+
+    // fewer chars per piece are not worth the synchronization
+    static constexpr std::ptrdiff_t min_piece_size { 16384 };
+    // target pieces per thread, to balance uneven elements
+    static constexpr std::size_t pieces_per_thread { 4 };
+
+    const char_type* const separator {
+        buffered_formatter_type::decorators.separator };
+    const char_type* const suffix { buffered_formatter_type::decorators.suffix };
+    if (separator == nullptr || *separator == char_type() ||
+        suffix == nullptr || *suffix == char_type())
+        return false;
+    // counted on istream before piece streams copy its format state, so
+    //   that nested containers count the outermost; past the limit,
+    //   from_stream fails as well
+    const nesting::detail::depth_guard<StreamType> depth { istream };
+    if (depth.exceeded())
+        return false;
+    // format state captured on this thread, as istream is not thread safe
+    const buffered_formatter_type buffered_formatter {
+        rebind_formatter<buffer_type>(formatter, istream, depth.current()) };
+
+    buffer_type buffer { istream };
+    if (!buffer.fill_window())
+        return false;
+    const char_type* const window_first { buffer.window_begin() };
+    const char_type* const window_last { buffer.window_end() };
+
+    // prefix and count hint parsed from a copy of the get area, so that
+    //   istream is only advanced once the whole serialization is parsed
+    // views into pieces are only kept if they could be into istream
+    const bool stable { buffer.stable_source() };
+    span_type header_buf { window_first, window_last, stable };
+    piece_stream_type header_stream { &header_buf };
+    header_stream.copyfmt(istream);
+    header_stream.exceptions(std::ios_base::goodbit);
+    header_stream.tie(nullptr);
+    {
+        buffer_type header_buffer { header_stream };
+        std::size_t count_hint {};
+        buffered_formatter.parse_prefix(header_buffer);
+        if (header_buffer.good())
+            parse_count_hint(buffered_formatter, header_buffer, count_hint);
+        if (!header_buffer.good())
+            return false;
+    }
+
+    const char_type* const body_first { header_buf.current() };
+    const std::ptrdiff_t piece_size { std::max(
+        min_piece_size, static_cast<std::ptrdiff_t>(
+            (window_last - body_first) / static_cast<std::ptrdiff_t>(
+                thread_count * pieces_per_thread))) };
+    // pieces after the first begin with their leading separator
+    std::vector<const char_type*> bounds { body_first };
+    structure_scanner<char_type> scanner;
+    const char_type* p { body_first };
+    for (;;)
+    {
+        p = scanner.find(p, window_last, *separator);
+        if (p == window_last)
+            return false;  // not terminated within the get area
+        if (*p != *separator)
+            break;
+        if (p - bounds.back() >= piece_size)
+            bounds.push_back(p);
+        ++p;
+    }
+    const std::size_t suffix_length {
+        buffered_formatter_type::decorator_tokens::suffix_length };
+    if (static_cast<std::size_t>(window_last - p) < suffix_length ||
+        traits_type::compare(p, suffix, suffix_length) != 0)
+        return false;
+    const char_type* const serialization_last { p + suffix_length };
+    bounds.push_back(p);
+    const std::size_t piece_count { bounds.size() - 1 };
+    if (piece_count < 2)
+        return false;
+
+    // format state copied on this thread, as istream is not thread safe
+    const std::size_t worker_count { std::min(thread_count, piece_count) };
+    std::vector<std::unique_ptr<piece_stream_type>> piece_streams;
+    piece_streams.reserve(worker_count);
+    for (std::size_t i {}; i < worker_count; ++i)
+    {
+        piece_streams.emplace_back(new piece_stream_type { &header_buf });
+        piece_streams.back()->copyfmt(istream);
+        piece_streams.back()->exceptions(std::ios_base::goodbit);
+        piece_streams.back()->tie(nullptr);
+    }
+    std::vector<std::deque<element_type>> pieces (piece_count);
+    std::vector<std::exception_ptr> errors (worker_count);
+    std::atomic<std::size_t> next_piece { 0 };
+    std::atomic<bool> failed { false };
+    // merged once the whole serialization is parsed
+    instrumentation::worker_counters<> worker_counts { worker_count };
+
+    const auto parse_pieces = [&](const std::size_t worker) {
+        piece_stream_type& piece_stream { *piece_streams[worker] };
+        const instrumentation::worker_counters<>::scope counting {
+            worker_counts, worker };
+        try {
+            for (std::size_t i { next_piece++ };
+                 i < piece_count && !failed; i = next_piece++)
+            {
+                span_type piece_buf { bounds[i], bounds[i + 1], stable };
+                piece_stream.rdbuf(&piece_buf);
+                if (!extract_piece(piece_stream, pieces[i], i != 0,
+                                   buffered_formatter))
+                    failed = true;
+                piece_stream.rdbuf(&header_buf);
+            }
+        } catch (...) {
+            errors[worker] = std::current_exception();
+            failed = true;
+        }
+    };
+    {
+        parallel::worker_group workers { worker_count };
+        workers.run(parse_pieces);
+    }
+
+    for (const std::exception_ptr& error : errors)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+    if (failed)
+        return false;
+
+    const bool in_place { detail::parses_in_place(istream) };
+    ContainerType temp_container = construct_like(container);
+    ContainerType& new_container { in_place ? container : temp_container };
+    std::size_t count {};
+    for (const std::deque<element_type>& piece : pieces)
+        count += piece.size();
+    // order checked before any element is moved, as failure falls back on
+    //   parsing with from_stream
+    if (traits::has_key_compare<ContainerType>::value &&
+        detail::requires_order(istream) && !sorted_pieces(container, pieces))
+        return false;
+    new_container.clear();
+    reserve_elements(new_container, count);
+    for (std::deque<element_type>& piece : pieces)
+    {
+        for (element_type& element : piece)
+            emplace_element(new_container, std::move(element));
+        piece.clear();
+    }
+    if (!in_place)
+        container = std::move(new_container);
+    buffer.consume(static_cast<std::size_t>(serialization_last - window_first));
+    worker_counts.merge();
+    return true;
+}
+
+/**
+ * @brief stream extraction of compatible container type, with elements
+ *   parsed concurrently
+ * @notes
+ *   - results are the same as those of from_stream: when the whole
+ *       serialization is already in the get area of the streambuf of istream
+ *       (eg std::basic_istringstream, or buffers::span_streambuf over a
+ *       string or mapped file), it is split at top level separators found by
+ *       a structure_scanner into pieces, which are parsed by worker threads
+ *       (each with a copy of the format state of istream) and then emplaced
+ *       in order
+ *   - otherwise, or if parsing any piece fails (so that stream state and
+ *       container contents on failure match), from_stream is used
+ *   - only for containers and formatters meeting is_parallel_extractable,
+ *       others are extracted with from_stream
+ *   - thread_count of 0 uses std::thread::hardware_concurrency()
+ */
+template <typename ContainerType, typename StreamType, typename FormatterType>
+static auto from_stream_parallel(
+    StreamType& istream, ContainerType& container,
+    const FormatterType& formatter, std::size_t /*thread_count*/ = 0
+    ) -> std::enable_if_t<
+        !is_parallel_extractable<ContainerType, FormatterType, StreamType>::value,
+        StreamType&>
+{
+    return from_stream(istream, container, formatter);
+}
+
+template <typename ContainerType, typename StreamType, typename FormatterType>
+static auto from_stream_parallel(
+    StreamType& istream, ContainerType& container,
+    const FormatterType& formatter, std::size_t thread_count = 0
+    ) -> std::enable_if_t<
+        is_parallel_extractable<ContainerType, FormatterType, StreamType>::value,
+        StreamType&>
+{
+    if (thread_count == 0)
+        thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    if (thread_count == 1)
+        return from_stream(istream, container, formatter);
+    {
+        instrumentation::input_scope<StreamType> scope { istream };
+        if (extract_container_parallel(istream, container, formatter, thread_count))
+            return istream;
+        scope.cancel();  // counted anew by from_stream
+    }
+    return from_stream(istream, container, formatter);
+}
+
+/**
+ * @brief incremental parser of a container serialization fed in chunks as
+ *   they arrive (eg from a non-blocking socket), following the same grammar
+ *   as default_formatter
+ * @notes
+ *   - each element is parsed only once a structure_scanner has found its
+ *       end, with scanner state (nesting depth, string and escape state) kept
+ *       between calls to feed(), so chunks may split the serialization
+ *       anywhere, including inside nested containers, strings and escapes,
+ *       while only the chars of the element being received are kept
+ *   - decorators and count hints are parsed once the chunks fed so far hold
+ *       them in full
+ *   - as with from_stream_parallel, nesting is tracked with the chars of the
+ *       default decorators, and only containers with emplacement not
+ *       requiring a position (excluding arrays, tuples, pairs, and
+ *       std::forward_list) are supported
+ *   - format state (eg strings::quotedrepr, decorator::counthint) is that of
+ *       the stream passed to the constructor, if any
+ *   - instrumentation counts each serialization as one call, exported once
+ *       it is complete or fails, or on reset()
+ */
+template <typename ContainerType, typename CharType = char,
+          typename TraitsType = std::char_traits<CharType>>
+class push_parser
+{
+    static_assert(traits::has_emplace_back<ContainerType>::value ||
+                  traits::has_iterless_emplace<ContainerType>::value,
+                  "push_parser requires emplacement without a position");
+
+    using stream_type = std::basic_istream<CharType, TraitsType>;
+    using span_type = buffers::span_streambuf<CharType, TraitsType>;
+    using buffer_type = buffers::input_buffer<CharType, TraitsType>;
+    using formatter_type = default_formatter<ContainerType, buffer_type>;
+    using element_type =
+        typename parsed_element<typename ContainerType::value_type>::type;
+    using counting_type = instrumentation::stepwise_scope<>;
+
+public:
+    enum class status { need_more, complete, error };
+
+    push_parser() :
+        stream_ { nullptr }
+    {}
+
+    explicit push_parser(const std::basic_ios<CharType, TraitsType>& format_source) :
+        stream_ { nullptr }
+    {
+        stream_.copyfmt(format_source);
+        stream_.exceptions(std::ios_base::goodbit);
+        stream_.tie(nullptr);
+        state_ = format_state::capture(stream_);
+    }
+
+    push_parser(const push_parser&) = delete;
+    push_parser& operator=(const push_parser&) = delete;
+
+    /**
+     * @brief parses as far as possible with chunk [chars, chars + size)
+     *   appended to any chars not yet parsed
+     * @return need_more until the suffix of the container is parsed, or
+     *   error once any part of the serialization fails to parse
+     */
+    status feed(const CharType* const chars, const std::size_t size)
+    {
+        if (stage_ != stage::complete && stage_ != stage::error) {
+            pending_.erase(0, cursor_);
+            scanned_ -= cursor_;
+            cursor_ = 0;
+        }
+        if (size != 0)
+            pending_.append(chars, size);
+        {
+            // held while parsing, so that nested containers count the outermost
+            const nesting::detail::depth_guard<stream_type> depth { stream_ };
+            const counting_type::step step { counting_ };
+            // carried by the formatters of steps to nested containers
+            state_.nesting_level = depth.current();
+            if (depth.exceeded())
+                fail();
+            while (advance()) {}
+        }
+        if (stage_ == stage::complete || stage_ == stage::error)
+            counting_.end();
+        return ended();
+    }
+
+    /**
+     * @brief parsed container, holding the elements parsed so far
+     */
+    ContainerType& container()
+    {
+        return container_;
+    }
+
+    /**
+     * @brief chars fed after the end of the serialization, once complete
+     */
+    const std::basic_string<CharType, TraitsType>& remainder() const
+    {
+        return pending_;
+    }
+
+    /**
+     * @brief readies parser for the next serialization, which begins with
+     *   any remainder of the last
+     */
+    void reset()
+    {
+        counting_.reset();
+        container_.clear();
+        scanner_ = structure_scanner<CharType> {};
+        cursor_ = 0;
+        scanned_ = 0;
+        stage_ = stage::prefix;
+    }
+
+private:
+    enum class stage { prefix, first_element, element, delimiter, complete, error };
+
+    /**
+     * @brief result of parsing from the pending chars
+     */
+    struct attempt
+    {
+        std::size_t consumed;
+        bool failed;
+        bool at_end;  // chars ran out, so more may be needed
+    };
+
+    status ended() const
+    {
+        return stage_ == stage::complete ? status::complete :
+            stage_ == stage::error ? status::error : status::need_more;
+    }
+
+    /**
+     * @return true if progress was made, and parsing can continue
+     */
+    bool advance()
+    {
+        switch (stage_)
+        {
+        case stage::prefix:
+            return parse_header();
+        case stage::first_element:
+        case stage::element:
+            return parse_element();
+        case stage::delimiter:
+            return parse_delimiter();
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * @brief applies parse to a buffer over pending chars from cursor_ up to
+     *   index last
+     * @notes chars are not stable, as pending_ is compacted between chunks,
+     *   so no views into them are kept
+     */
+    template <typename ParseType>
+    attempt parse_pending(const std::size_t last, ParseType parse)
+    {
+        if (cursor_ == last)
+            return attempt { 0, false, true };
+        const CharType* const first { pending_.data() + cursor_ };
+        span_type span { first, pending_.data() + last, false };
+        stream_.rdbuf(&span);
+        {
+            buffer_type buffer { stream_ };
+            if (buffer.good())
+                parse(buffer);
+        }
+        const attempt result {
+            static_cast<std::size_t>(span.current() - first),
+            stream_.fail(), stream_.eof() };
+        stream_.rdbuf(nullptr);
+        return result;
+    }
+
+    bool fail()
+    {
+        stage_ = stage::error;
+        return false;
+    }
+
+    bool parse_header()
+    {
+        const formatter_type formatter { state_ };
+        bool hinted {};
+        std::size_t count_hint {};
+        const attempt result { parse_pending(
+            pending_.size(), [&](buffer_type& buffer) {
+                formatter.parse_prefix(buffer);
+                if (buffer.good())
+                    hinted = parse_count_hint(formatter, buffer, count_hint);
+            }) };
+        if (result.at_end)
+            return false;
+        if (result.failed)
+            return fail();
+        if (hinted)
+            reserve_elements(container_, std::min(count_hint, min_reserve_limit));
+        cursor_ += result.consumed;
+        scanned_ = cursor_;
+        stage_ = stage::first_element;
+        return true;
+    }
+
+    bool parse_element()
+    {
+        const CharType* const data { pending_.data() };
+        const CharType* const last { data + pending_.size() };
+        const CharType* const end { scanner_.find(
+            data + scanned_, last, *formatter_type::decorators.separator) };
+        scanned_ = static_cast<std::size_t>(end - data);
+        if (end == last)
+            return false;
+
+        if (stage_ == stage::first_element &&
+            *end != *formatter_type::decorators.separator) {
+            // suffix found, so empty unless only whitespace precedes it
+            const attempt blank { parse_pending(
+                scanned_, [](buffer_type& buffer) { buffer >> std::ws; }) };
+            if (cursor_ + blank.consumed == scanned_) {
+                stage_ = stage::delimiter;
+                return true;
+            }
+        }
+
+        if (cursor_ == scanned_)
+            return fail();
+        const formatter_type formatter { state_ };
+        element_type element {
+            construct_parsed<element_type>(stream_, container_) };
+        const attempt result { parse_pending(
+            scanned_, [&](buffer_type& buffer) {
+                formatter.parse_element(buffer, element);
+                if (!buffer.fail() && !buffer.eof())
+                    buffer >> std::ws;
+            }) };
+        // whole element must be parsed, as its end is known
+        if (result.failed || cursor_ + result.consumed != scanned_)
+            return fail();
+        emplace_element(container_, std::move(element));
+        instrumentation::policy::count_elements(1);
+        cursor_ = scanned_;
+        stage_ = stage::delimiter;
+        return true;
+    }
+
+    bool parse_delimiter()
+    {
+        const formatter_type formatter { state_ };
+        bool at_suffix {};
+        const attempt result { parse_pending(
+            pending_.size(), [&](buffer_type& buffer) {
+                at_suffix = formatter_type::try_parse_suffix(buffer);
+                if (!at_suffix && !buffer.fail())
+                    formatter.parse_separator(buffer);
+            }) };
+        if (!at_suffix && result.at_end)
+            return false;
+        if (result.failed)
+            return fail();
+        cursor_ += result.consumed;
+        if (at_suffix) {
+            pending_.erase(0, cursor_);
+            cursor_ = 0;
+            scanned_ = 0;
+            stage_ = stage::complete;
+            return false;
+        }
+        scanned_ = cursor_;
+        stage_ = stage::element;
+        return true;
+    }
+
+    ContainerType container_ {};
+    std::basic_string<CharType, TraitsType> pending_;
+    // index of first char not yet parsed, and of first not yet scanned
+    std::size_t cursor_ {};
+    std::size_t scanned_ {};
+    structure_scanner<CharType> scanner_ {};
+    format_state state_ {};
+    stage stage_ { stage::prefix };
+    // holds format state, and reads each attempt through its own span
+    stream_type stream_;
+    // each feed counted as a step of the serialization
+    counting_type counting_ { instrumentation::direction::input };
+};
+
+/**
+ * @brief input range over the elements of a ContainerType serialization,
+ *   parsing one element at a time as the range is iterated
+ * @notes
+ *   - begin() parses the prefix and first element, each increment the next
+ *       separator and element, so elements are processed in constant memory
+ *       and the serialization is read only as far as iteration goes
+ *   - the current element is held by the range, and may be moved from by
+ *       the caller, as each element is parsed anew
+ *   - iteration ends after the suffix, or on failure to parse, with failbit
+ *       set on istream
+ *   - iterators, being single pass, do not outlive their range
+ *   - instrumentation counts the serialization as one call, exported once
+ *       iteration ends, or as the range is destroyed
+ */
+template <typename ContainerType, typename StreamType, typename FormatterType>
+class element_range
+{
+public:
+    using value_type =
+        typename parsed_element<typename ContainerType::value_type>::type;
+
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = element_range::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type*;
+        using reference = value_type&;
+
+        /**
+         * @brief result of postfix increment, holding the element the
+         *   iterator was at (as with std::istream_iterator), so that `*it++`
+         *   is that element
+         */
+        class postfix_proxy
+        {
+        public:
+            explicit postfix_proxy(value_type&& element) :
+                element_ (std::move(element))
+            {}
+
+            reference operator*()
+            {
+                return element_;
+            }
+
+        private:
+            value_type element_;
+        };
+
+        iterator() = default;
+
+        explicit iterator(element_range* const range) :
+            range_ { range }
+        {}
+
+        reference operator*() const
+        {
+            return range_->element_;
+        }
+
+        pointer operator->() const
         {
-            buffer += StringCharType(c);
-            continue;
+            return &range_->element_;
         }
-        istream >> c;
-        if (istream.good())
+
+        iterator& operator++()
         {
-            if (c == StreamCharType(repr.escape) ||
-                c == StreamCharType(repr.delim))
-                buffer += StringCharType(c);
-            else
-               istream.setstate(std::ios_base::failbit);  // invalid quoted encoding
+            if (!range_->advance(false))
+                range_ = nullptr;
+            return *this;
+        }
+
+        // element moved from, as the increment parses the next anew
+        postfix_proxy operator++(int)
+        {
+            postfix_proxy previous { std::move(range_->element_) };
+            ++*this;
+            return previous;
+        }
+
+        friend bool operator==(const iterator& lhs, const iterator& rhs)
+        {
+            return lhs.range_ == rhs.range_;
+        }
+
+        friend bool operator!=(const iterator& lhs, const iterator& rhs)
+        {
+            return lhs.range_ != rhs.range_;
         }
+
+    private:
+        element_range* range_ {};
     };
-    if (c != StreamCharType(repr.delim))
-        istream.setstate(std::ios_base::failbit);
-    istream.setf(orig_flags);
-}
 
-/**
- * @brief helper to extract_string_repr, encapsulates main literal
- *   representation decoding loop
- */
-template<typename StreamCharType, typename StringCharType>
-static void extract_literal_repr(
-    std::basic_istream<StreamCharType>& istream,
-    const string_repr<std::basic_string<StringCharType>&, StringCharType>& repr,
-    std::basic_string<StringCharType>& buffer)
-{
-    StreamCharType c;
-    std::ios_base::fmtflags orig_flags {
-        istream.flags(istream.flags() & ~std::ios_base::skipws) };
-    for (istream >> c;
-         istream.good() && c != StreamCharType(repr.delim); istream >> c)
+    element_range(StreamType& istream, const FormatterType& formatter) :
+        istream_(istream), formatter_(formatter)
+    {}
+
+    iterator begin()
+    {
+        if (!started_) {
+            started_ = true;
+            advance(true);
+        }
+        return active_ ? iterator { this } : iterator {};
+    }
+
+    iterator end()
+    {
+        return iterator {};
+    }
+
+private:
+    using counting_type = instrumentation::stepwise_scope<>;
+
+    /**
+     * @brief parses the first or next element, as a step of the
+     *   serialization, which ends once none is parsed
+     */
+    bool advance(const bool first)
     {
-        if (c < 0x7f && std::isprint(c))
+        active_ = false;
         {
-            if (c != StreamCharType(repr.escape))
-            {
-                buffer += StringCharType(c);
-                continue;
-            }
-            istream >> c;
-            if (c > 0x7f || !std::isprint(c))
-                istream.setstate(std::ios_base::failbit);  // invalid escape
-            if (!istream.good())
-                break;
-            if (c == StreamCharType(repr.escape) ||
-                c == StreamCharType(repr.delim))
-            {
-                buffer += StringCharType(c);
-                continue;
-            }
-            try
-            {
-                buffer += repr.escapes.by_symbol.at(c);
-                continue;
-            }
-            catch (const std::out_of_range& /*oor_ex*/)
+            // held while parsing, so that nested containers count the outermost
+            const nesting::detail::depth_guard<StreamType> depth { istream_ };
+            if (depth.exceeded())
+                istream_.setstate(std::ios_base::failbit);
+            else
             {
-                if (c == StreamCharType('x'))
-                {
-                    // !!? can we pass only StringCharType to template?
-                    buffer += StringCharType(
-                        extract_fixed_width_hex_value<
-                        StreamCharType, StringCharType>(istream));
-                    continue;
-                }
+                const counting_type::step step { counting_ };
+                active_ = first ? parse_first() : parse_next();
+                if (active_)
+                    instrumentation::policy::count_elements(1);
             }
         }
-        istream.setstate(std::ios_base::failbit);  // invalid literal encoding
-    };
-    if (c != StreamCharType(repr.delim))
-        istream.setstate(std::ios_base::failbit);
-    istream.setf(orig_flags);
-}
+        if (!active_)
+            counting_.end();
+        return active_;
+    }
 
-/**
- * @brief helper to operator>>(string_repr), differentiates between quoted and
- *   literal decoding
- */
-template<typename StreamCharType, typename StringCharType>
-static void extract_string_repr(
-    std::basic_istream<StreamCharType>& istream,
-    const string_repr<std::basic_string<StringCharType>&, StringCharType>& repr)
-{
-    // quoted encoding expects full potential range of StreamCharType values,
-    //   and so could create overflow if casting to a smaller StringCharType,
-    //   whereas literal encoding expects only printable 7-bit ASCII values due
-    //   to escapes
-    if (repr.type == repr_type::quoted &&
-        sizeof(StreamCharType) > sizeof(StringCharType))
+    bool parse_first()
     {
-        istream.setstate(std::ios_base::failbit);
-        return;
+        formatter_.parse_prefix(istream_);
+        std::size_t count_hint {};
+        if (istream_.good())
+            parse_count_hint(formatter_, istream_, count_hint);
+        if (!istream_.good() || extract_suffix(formatter_, istream_))
+            return false;
+        formatter_.parse_element(istream_, element_);
+        return !istream_.fail();
     }
-    extract_literal_prefix<StreamCharType, StringCharType>(istream);
-    if (!istream.good())
-        return;
-    // get() returns std::basic_istream<StreamCharType>::int_type
-    if (StreamCharType(istream.get()) != StreamCharType(repr.delim))
-        istream.setstate(std::ios_base::failbit);
-    if (!istream.good())
-        return;
-    std::basic_string<StringCharType> temp;
-    if (repr.type == repr_type::quoted)
-        extract_quoted_repr(istream, repr, temp);
-    else
-        extract_literal_repr(istream, repr, temp);
-    if (istream.good())
-        repr.string = std::move(temp);
-}
-
-/**
- * @brief istream operator for string representations
- * @notes overloads as follows:
- *   - CharT&
- *   - basic_string&
- */
-template<typename StreamCharType, typename StringCharType>
-auto operator>>(
-    std::basic_istream<StreamCharType>& istream,
-    const string_repr<StringCharType&, StringCharType>& repr
-    ) -> std::basic_istream<StreamCharType>&
-{
-    std::basic_string<StringCharType> temp;
-    string_repr<std::basic_string<StringCharType>&, StringCharType> temp_repr {
-        temp, repr.delim, repr.escape, repr.type };
-    extract_string_repr(istream, temp_repr);
-    if (!istream.fail() && temp_repr.string.size() == 1)
-        repr.string = temp_repr.string[0];
-    else
-        istream.setstate(std::ios_base::failbit);
-    return istream;
-}
 
-template<typename StreamCharType, typename StringCharType>
-auto operator>>(
-    std::basic_istream<StreamCharType>& istream,
-    const string_repr<std::basic_string<StringCharType>&, StringCharType>& repr
-    ) -> std::basic_istream<StreamCharType>&
-{
-    extract_string_repr(istream, repr);
-    return istream;
-}
+    bool parse_next()
+    {
+        if (extract_suffix(formatter_, istream_))
+            return false;
+        formatter_.parse_separator(istream_);
+        if (istream_.good())
+            formatter_.parse_element(istream_, element_);
+        return !istream_.fail();
+    }
 
-}  // namespace detail
+    StreamType& istream_;
+    FormatterType formatter_;
+    value_type element_ {};
+    bool started_ {};
+    bool active_ {};
+    counting_type counting_ { instrumentation::direction::input };
+};
 
 /**
- * @brief iomanip to set encoding/decoding of strings/chars in containers to
- *   literal
+ * @brief lazily parsed range over the elements of a ContainerType
+ *   serialization, see element_range
  */
-template<typename CharType, typename TraitsType>
-std::basic_ios<CharType, TraitsType>& literalrepr(
-    std::basic_ios<CharType, TraitsType>& stream)
+template <typename ContainerType, typename StreamType,
+          typename FormatterType = default_formatter<ContainerType, StreamType>>
+static element_range<ContainerType, StreamType, FormatterType> elements(
+    StreamType& istream, const FormatterType& formatter = FormatterType{})
 {
-    stream.iword(detail::get_manip_i()) =
-        static_cast<int>(detail::repr_type::literal);
-    return stream;
+    return element_range<ContainerType, StreamType, FormatterType> {
+        istream, formatter };
 }
 
 /**
- * @brief iomanip to set encoding/decoding of strings/chars in containers to
- *   quoted
+ * @brief helper to visit, walks the serialization of one (nested) container
+ * @notes specializations as follows:
+ *   - default: elements separated until the suffix, as with extract_container
+ *   - std::pair: exactly two elements
+ *   - std::tuple: exactly one element per tuple member
  */
-template<typename CharType, typename TraitsType>
-std::basic_ios<CharType, TraitsType>& quotedrepr(
-    std::basic_ios<CharType, TraitsType>& stream)
-{
-    stream.iword(detail::get_manip_i()) =
-        static_cast<int>(detail::repr_type::quoted);
-    return stream;
-}
+template <typename ContainerType>
+struct container_visitor;
 
 /**
- * @brief generates quoted string represenation intended for use with stream
- *   operators
- * @notes
- *   - overloads need to be supplied for each string type of param `string`,
- *       so that it can both be templated for any char type, and allow the
- *       deduction of the `delim` and `escape` types when they are not given as
- *       params
- *   - overloads should support the following string types: (const) CharT&,
- *       (const) CharT*, (const) basic_string&, (const) basic_string_view&
+ * @brief helper to container_visitor, visits one element
+ * @notes overloads as follows:
+ *   - compatible containers: walked as containers, with a default_formatter
+ *       for their type
+ *   - default: parsed with the formatter of the enclosing container, then
+ *       passed to the visitor
+ * @return false if parsing failed or the visitor stopped traversal
  */
-template<typename CharType>
-inline auto quoted(
-    CharType& string,
-    CharType delim = CharType('\''), CharType escape = CharType('\\')
+template <typename ElementType, typename StreamType, typename VisitorType,
+          typename FormatterType>
+static auto visit_element(
+    StreamType& istream, VisitorType& visitor,
+    const FormatterType& /*formatter*/, const format_state& state
     ) -> std::enable_if_t<
-        traits::is_char_type<CharType>::value,
-        detail::string_repr<CharType&, CharType>>
+        traits::is_parseable_as_container<ElementType>::value,
+        bool>
 {
-    return detail::string_repr<CharType&, CharType>(
-            string, delim, escape, detail::repr_type::quoted);
+    const nesting::detail::depth_guard<StreamType> depth {
+        istream, state.nesting_level.nested(),
+        nesting::detail::has_opaque_elements<ElementType>::value };
+    if (depth.exceeded())
+    {
+        istream.setstate(std::ios_base::failbit);
+        return false;
+    }
+    const instrumentation::input_scope<StreamType> scope { istream };
+    format_state nested_state = state;
+    nested_state.nesting_level = depth.current();
+    return container_visitor<ElementType>::visit(
+        istream, visitor,
+        default_formatter<ElementType, StreamType>{ nested_state }, nested_state);
 }
 
-template<typename CharType>
-inline auto quoted(
-    const CharType& string,
-    CharType delim = CharType('\''), CharType escape = CharType('\\')
+template <typename ElementType, typename StreamType, typename VisitorType,
+          typename FormatterType>
+static auto visit_element(
+    StreamType& istream, VisitorType& visitor,
+    const FormatterType& formatter, const format_state& /*state*/
     ) -> std::enable_if_t<
-        traits::is_char_type<CharType>::value,
-        detail::string_repr<const CharType&, CharType>>
+        !traits::is_parseable_as_container<ElementType>::value,
+        bool>
 {
-    return detail::string_repr<const CharType&, CharType>(
-            string, delim, escape, detail::repr_type::quoted);
+    ElementType element {};
+    formatter.parse_element(istream, element);
+    return !istream.fail() && visitor.element(element);
 }
 
-template<typename CharType>
-inline auto quoted(
-    CharType* string,
-    CharType delim = CharType('"'), CharType escape = CharType('\\')
-    ) -> detail::string_repr<CharType*, CharType>
+template <typename ContainerType>
+struct container_visitor
 {
-    return detail::string_repr<CharType*, CharType>(
-            string, delim, escape, detail::repr_type::quoted);
-}
+    template <typename StreamType, typename VisitorType, typename FormatterType>
+    static bool visit(StreamType& istream, VisitorType& visitor,
+                      const FormatterType& formatter, const format_state& state)
+    {
+        using element_type =
+            typename parsed_element<typename ContainerType::value_type>::type;
 
-template<typename CharType>
-inline auto quoted(
-    const CharType* string,
-    CharType delim = CharType('"'), CharType escape = CharType('\\')
-    ) -> detail::string_repr<const CharType*, CharType>
-{
-    return detail::string_repr<const CharType*, CharType>(
-            string, delim, escape, detail::repr_type::quoted);
-}
+        formatter.parse_prefix(istream);
+        std::size_t count_hint {};
+        if (istream.good())
+            parse_count_hint(formatter, istream, count_hint);
+        if (!istream.good())
+            return false;
+        visitor.begin_container();
+        if (!extract_suffix(formatter, istream)) {
+            if (!visit_element<element_type>(istream, visitor, formatter, state))
+                return false;
+            instrumentation::policy::count_elements(1);
+            while (!extract_suffix(formatter, istream)) {
+                formatter.parse_separator(istream);
+                if (!istream.good() ||
+                    !visit_element<element_type>(istream, visitor, formatter, state))
+                    return false;
+                instrumentation::policy::count_elements(1);
+            }
+        }
+        visitor.end_container();
+        return true;
+    }
+};
 
-template<typename CharType, typename TraitsType, typename AllocType>
-inline auto quoted(
-    std::basic_string<CharType, TraitsType, AllocType>& string,
-    CharType delim = CharType('"'), CharType escape = CharType('\\')
-    ) -> detail::string_repr<
-        std::basic_string<CharType, TraitsType, AllocType>&, CharType>
+template <typename FirstType, typename SecondType>
+struct container_visitor<std::pair<FirstType, SecondType>>
 {
-    return detail::string_repr<
-	std::basic_string<CharType, TraitsType, AllocType>&, CharType>(
-	    string, delim, escape, detail::repr_type::quoted);
-}
+    template <typename StreamType, typename VisitorType, typename FormatterType>
+    static bool visit(StreamType& istream, VisitorType& visitor,
+                      const FormatterType& formatter, const format_state& state)
+    {
+        using BaseFirstType = typename std::remove_const<FirstType>::type;
 
-template<typename CharType, typename TraitsType, typename AllocType>
-inline auto quoted(
-    const std::basic_string<CharType, TraitsType, AllocType>& string,
-    CharType delim = CharType('"'), CharType escape = CharType('\\')
-    ) -> detail::string_repr<
-        const std::basic_string<CharType, TraitsType, AllocType>&, CharType>
-{
-    return detail::string_repr<
-	const std::basic_string<CharType, TraitsType, AllocType>&, CharType>(
-	    string, delim, escape, detail::repr_type::quoted);
-}
+        formatter.parse_prefix(istream);
+        if (!istream.good())
+            return false;
+        visitor.begin_container();
+        if (!visit_element<BaseFirstType>(istream, visitor, formatter, state))
+            return false;
+        formatter.parse_separator(istream);
+        if (!istream.good() ||
+            !visit_element<SecondType>(istream, visitor, formatter, state))
+            return false;
+        instrumentation::policy::count_elements(2);
+        formatter.parse_suffix(istream);
+        if (istream.fail())
+            return false;
+        visitor.end_container();
+        return true;
+    }
+};
 
-#if __cplusplus >= 201703L
-template<typename CharType, typename TraitsType>
-inline auto quoted(
-    std::basic_string_view<CharType, TraitsType>& string_view,
-    CharType delim = CharType('"'), CharType escape = CharType('\\')
-    ) -> detail::string_repr<
-        std::basic_string_view<CharType, TraitsType>&, CharType>
+template <typename... TupleArgs>
+struct container_visitor<std::tuple<TupleArgs...>>
 {
-    return detail::string_repr<
-        std::basic_string_view<CharType, TraitsType>&, CharType>(
-	    string_view, delim, escape, detail::repr_type::quoted);
-}
+    template <typename StreamType, typename VisitorType, typename FormatterType>
+    static bool visit(StreamType& istream, VisitorType& visitor,
+                      const FormatterType& formatter, const format_state& state)
+    {
+        formatter.parse_prefix(istream);
+        if (!istream.good())
+            return false;
+        visitor.begin_container();
+        if (!visit_members(istream, visitor, formatter, state,
+                           std::make_index_sequence<sizeof...(TupleArgs)>{}))
+            return false;
+        instrumentation::policy::count_elements(sizeof...(TupleArgs));
+        formatter.parse_suffix(istream);
+        if (istream.fail())
+            return false;
+        visitor.end_container();
+        return true;
+    }
 
-template<typename CharType, typename TraitsType>
-inline auto quoted(
-    const std::basic_string_view<CharType, TraitsType>& string_view,
-    CharType delim = CharType('"'), CharType escape = CharType('\\')
-    ) -> detail::string_repr<
-        const std::basic_string_view<CharType, TraitsType>&, CharType>
-{
-    return detail::string_repr<
-        const std::basic_string_view<CharType, TraitsType>&, CharType>(
-	    string_view, delim, escape, detail::repr_type::quoted);
-}
-#endif  // C++17
+private:
+    template <std::size_t Index, typename StreamType, typename VisitorType,
+              typename FormatterType>
+    static bool visit_member(StreamType& istream, VisitorType& visitor,
+                             const FormatterType& formatter,
+                             const format_state& state)
+    {
+        using member_type =
+            typename std::tuple_element<Index, std::tuple<TupleArgs...>>::type;
 
-/**
- * @brief generates literal string represenation intended for use with stream
- *   operators
- * @notes
- *   - overloads need to be supplied for each string type of param `string`,
- *       so that it can both be templated for any char type, and allow the
- *       deduction of the `delim` and `escape` types when they are not given as
- *       params
- *   - overloads should support the following string types: (const) CharT&,
- *       (const) CharT*, (const) basic_string&, (const) basic_string_view&
- */
-template<typename CharType>
-inline auto literal(
-    CharType& string,
-    CharType delim = CharType('\''), CharType escape = CharType('\\')
-    ) -> std::enable_if_t<
-        traits::is_char_type<CharType>::value,
-        detail::string_repr<CharType&, CharType>>
-{
-    return detail::string_repr<CharType&, CharType>(
-            string, delim, escape, detail::repr_type::literal);
-}
+        if (Index != 0)
+            formatter.parse_separator(istream);
+        return istream.good() &&
+            visit_element<member_type>(istream, visitor, formatter, state);
+    }
+
+    template <typename StreamType, typename VisitorType, typename FormatterType,
+              std::size_t... Indices>
+    static bool visit_members(StreamType& istream, VisitorType& visitor,
+                              const FormatterType& formatter,
+                              const format_state& state,
+                              std::index_sequence<Indices...> /*indices*/)
+    {
+        bool visiting { true };
+        // pack expansion in braced initializer is evaluated in order
+        const bool results[] { true, (visiting = visiting &&
+            visit_member<Indices>(istream, visitor, formatter, state))... };
+        static_cast<void>(results);
+        return visiting;
+    }
+};
 
-template<typename CharType>
-inline auto literal(
-    const CharType& string,
-    CharType delim = CharType('\''), CharType escape = CharType('\\')
-    ) -> std::enable_if_t<
-        traits::is_char_type<CharType>::value,
-        detail::string_repr<const CharType&, CharType>>
+/**
+ * @brief SAX-style traversal of a ContainerType serialization, without
+ *   materializing any of its containers
+ * @notes
+ *   - visitor provides begin_container() and end_container(), called around
+ *       the elements of each (nested) container, including pairs and tuples
+ *       (eg elements of maps), and element(value), called with each parsed
+ *       element of a type that is not a compatible container, which returns
+ *       false to stop traversal (leaving istream after that element)
+ *   - nested containers are walked with default_formatters sharing the
+ *       format state of istream, and std::array lengths are not checked
+ *   - failbit is set on istream if the serialization fails to parse
+ */
+template <typename ContainerType, typename StreamType, typename VisitorType,
+          typename FormatterType = default_formatter<ContainerType, StreamType>>
+static StreamType& visit(StreamType& istream, VisitorType& visitor,
+                         const FormatterType& formatter = FormatterType{})
 {
-    return detail::string_repr<const CharType&, CharType>(
-            string, delim, escape, detail::repr_type::literal);
+    const nesting::detail::depth_guard<StreamType> depth { istream };
+    if (depth.exceeded())
+    {
+        istream.setstate(std::ios_base::failbit);
+        return istream;
+    }
+    const instrumentation::input_scope<StreamType> scope { istream };
+    format_state state = format_state::capture(istream);
+    state.nesting_level = depth.current();
+    container_visitor<ContainerType>::visit(istream, visitor, formatter, state);
+    return istream;
 }
 
-template<typename CharType>
-inline auto literal(
-    CharType* string,
-    CharType delim = CharType('"'), CharType escape = CharType('\\')
-    ) -> detail::string_repr<CharType*, CharType>
+/**
+ * @brief extraction of compatible container type from the contents of a
+ *   file, parsed in place from a buffers::mapped_file
+ * @notes
+ *   - overloads as follows:
+ *     - path: the file is closed on return, so its chars are not stable, and
+ *         elements such as std::string_view fail to parse rather than view
+ *         them
+ *     - mapped_file: chars are stable, so such elements view the file, and
+ *         must not outlive it
+ *   - formatter reads from a std::istream; to set format state (eg
+ *       strings::quotedrepr), or to parse with from_stream_parallel, stream
+ *       from a std::istream over a buffers::span_streambuf of a
+ *       buffers::mapped_file
+ * @return true if the file was opened and the container parsed
+ */
+template <typename ContainerType,
+          typename FormatterType = default_formatter<ContainerType, std::istream>>
+static bool from_file(
+    const std::string& path, ContainerType& container,
+    const FormatterType& formatter = FormatterType{})
 {
-    return detail::string_repr<CharType*, CharType>(
-            string, delim, escape, detail::repr_type::literal);
+    const buffers::mapped_file file { path };
+    if (!file.is_open())
+        return false;
+    buffers::span_streambuf<char> buf {
+        file.data(), file.data() + file.size(), false };
+    std::istream istream { &buf };
+    from_stream(istream, container, formatter);
+    return !istream.fail();
 }
 
-template<typename CharType>
-inline auto literal(
-    const CharType* string,
-    CharType delim = CharType('"'), CharType escape = CharType('\\')
-    ) -> detail::string_repr<const CharType*, CharType>
+template <typename ContainerType,
+          typename FormatterType = default_formatter<ContainerType, std::istream>>
+static bool from_file(
+    const buffers::mapped_file& file, ContainerType& container,
+    const FormatterType& formatter = FormatterType{})
 {
-    return detail::string_repr<const CharType*, CharType>(
-            string, delim, escape, detail::repr_type::literal);
+    if (!file.is_open())
+        return false;
+    buffers::span_streambuf<char> buf { file.data(), file.data() + file.size() };
+    std::istream istream { &buf };
+    from_stream(istream, container, formatter);
+    return !istream.fail();
 }
 
-template<typename CharType, typename TraitsType, typename AllocType>
-inline auto literal(
-    std::basic_string<CharType, TraitsType, AllocType>& string,
-    CharType delim = CharType('"'), CharType escape = CharType('\\')
-    ) -> detail::string_repr<
-        std::basic_string<CharType, TraitsType, AllocType>&, CharType>
+/**
+ * @brief extraction of compatible container type from a string, parsed in
+ *   place through a buffers::span_streambuf rather than copied into a
+ *   std::istringstream
+ * @notes
+ *   - overloads as follows:
+ *     - chars of data of length size
+ *     - std::string
+ *     - std::string rvalue, whose chars are not viewed
+ *     - std::string_view (C++17)
+ *   - chars, other than those of a std::string rvalue, are taken to outlive
+ *       the container, so that elements such as std::string_view may be
+ *       parsed as views into them
+ *   - formatter reads from a std::istream; to set format state (eg
+ *       strings::quotedrepr), construct it with a format_state
+ * @return true if the container was parsed
+ */
+template <typename ContainerType,
+          typename FormatterType = default_formatter<ContainerType, std::istream>>
+static bool from_string(
+    const char* data, const std::size_t size, ContainerType& container,
+    const FormatterType& formatter = FormatterType{})
 {
-    return detail::string_repr<
-	std::basic_string<CharType, TraitsType, AllocType>&, CharType>(
-	    string, delim, escape, detail::repr_type::literal);
+    buffers::span_streambuf<char> buf { data, data + size };
+    std::istream istream { &buf };
+    from_stream(istream, container, formatter);
+    return !istream.fail();
 }
 
-template<typename CharType, typename TraitsType, typename AllocType>
-inline auto literal(
-    const std::basic_string<CharType, TraitsType, AllocType>& string,
-    CharType delim = CharType('"'), CharType escape = CharType('\\')
-    ) -> detail::string_repr<
-        const std::basic_string<CharType, TraitsType, AllocType>&, CharType>
+template <typename ContainerType,
+          typename FormatterType = default_formatter<ContainerType, std::istream>>
+static bool from_string(
+    const std::string& string, ContainerType& container,
+    const FormatterType& formatter = FormatterType{})
 {
-    return detail::string_repr<
-	const std::basic_string<CharType, TraitsType, AllocType>&, CharType>(
-	    string, delim, escape, detail::repr_type::literal);
+    return from_string(string.data(), string.size(), container, formatter);
 }
 
-#if __cplusplus >= 201703L
-template<typename CharType, typename TraitsType>
-inline auto literal(
-    std::basic_string_view<CharType, TraitsType>& string_view,
-    CharType delim = CharType('"'), CharType escape = CharType('\\')
-    ) -> detail::string_repr<
-        std::basic_string_view<CharType, TraitsType>&, CharType>
+/**
+ * @brief a temporary string is destroyed before the container is used, so
+ *   its chars are parsed as unstable, and elements such as std::string_view
+ *   fail to parse rather than dangle
+ */
+template <typename ContainerType,
+          typename FormatterType = default_formatter<ContainerType, std::istream>>
+static bool from_string(
+    std::string&& string, ContainerType& container,
+    const FormatterType& formatter = FormatterType{})
 {
-    return detail::string_repr<
-        std::basic_string_view<CharType, TraitsType>&, CharType>(
-	    string_view, delim, escape, detail::repr_type::literal);
+    buffers::span_streambuf<char> buf {
+        string.data(), string.data() + string.size(), false };
+    std::istream istream { &buf };
+    from_stream(istream, container, formatter);
+    return !istream.fail();
 }
 
-template<typename CharType, typename TraitsType>
-inline auto literal(
-    const std::basic_string_view<CharType, TraitsType>& string_view,
-    CharType delim = CharType('"'), CharType escape = CharType('\\')
-    ) -> detail::string_repr<
-        const std::basic_string_view<CharType, TraitsType>&, CharType>
+#if (__cplusplus >= 201703L)
+template <typename ContainerType,
+          typename FormatterType = default_formatter<ContainerType, std::istream>>
+static bool from_string(
+    const std::string_view string, ContainerType& container,
+    const FormatterType& formatter = FormatterType{})
 {
-    return detail::string_repr<
-        const std::basic_string_view<CharType, TraitsType>&, CharType>(
-	    string_view, delim, escape, detail::repr_type::literal);
+    return from_string(string.data(), string.size(), container, formatter);
 }
+
 #endif  // C++17
 
-}  // namespace strings
+}  // namespace input
 
 /**
- * @brief contains structures which provide tokens used around and between
- *   elements in conatiner serializations
+ * @brief contains functions to govern output streaming/insertion of compatible
+ *   containers
  */
-namespace decorator {
+namespace output {
 
 /**
- * @brief wraps tokens used around and between elements in serialization of a
- *   given set of container types
+ * @brief default formatter for the printing of decorators and elements in a
+ *   container serialization
  */
-template <typename CharType>
-struct delim_wrapper
+template <typename ContainerType, typename StreamType>
+struct default_formatter
 {
-    const CharType* prefix;
-    const CharType* separator;
-    const CharType* whitespace;
-    const CharType* suffix;
-};
+    static constexpr auto decorators {
+        decorator::delimiters<ContainerType, typename StreamType::char_type>::values };
+    static constexpr auto count_hint_decorators {
+        decorator::count_hint_delimiters<typename StreamType::char_type>::values };
+    using decorator_tokens =
+        decorator::tokens<ContainerType, typename StreamType::char_type>;
 
-using namespace strings::compile_time;  // char_literal, string_literal
+    using repr_type = strings::detail::repr_type;
 
-// TBD consider making map/multimap curly braced, as they are essentially sets of pairs
-/**
- * @brief wraps delim_wrapper, allowing templating by both char and container
- *   types
- * @notes overloads as follows:
- *   - default (eg std::array, C array, vector, list, forward_list, queue,
- *       unordered(multi)(map|set))
- *   - set/multiset
- *   - pair
- *   - tuple
- */
-template <typename ContainerType,
-          typename CharType>
-struct delimiters
-{
-    static constexpr delim_wrapper<CharType> values {
-        STRING_LITERAL(CharType, "["),
-        STRING_LITERAL(CharType, ","),
-        STRING_LITERAL(CharType, " "),
-        STRING_LITERAL(CharType, "]") };
-};
+    /**
+     * @brief same formatter for use with another stream type, eg
+     *   buffers::output_buffer
+     */
+    template <typename OtherStreamType>
+    using rebind = default_formatter<ContainerType, OtherStreamType>;
 
-template <typename DataType, typename CompareType, typename AllocType,
-          typename CharType>
-struct delimiters<std::set<DataType, CompareType, AllocType>, CharType>
-{
-    static constexpr delim_wrapper<CharType> values {
-        STRING_LITERAL(CharType, "{"),
-        STRING_LITERAL(CharType, ","),
-        STRING_LITERAL(CharType, " "),
-        STRING_LITERAL(CharType, "}") };
-};
+    /**
+     * @brief constructors
+     * @notes overloads as follows:
+     *   - default: format state read from the stream on each use
+     *   - format_state: state captured beforehand, eg by to_stream
+     */
+    default_formatter() = default;
 
-template <typename DataType, typename CompareType, typename AllocType,
-          typename CharType>
-struct delimiters<std::multiset<DataType, CompareType, AllocType>, CharType>
-{
-    static constexpr delim_wrapper<CharType> values {
-        STRING_LITERAL(CharType, "{"),
-        STRING_LITERAL(CharType, ","),
-        STRING_LITERAL(CharType, " "),
-        STRING_LITERAL(CharType, "}") };
-};
+    explicit default_formatter(const format_state& state) noexcept :
+        state_ { state }, captured_ { true }
+    {}
 
-template <typename FirstType, typename SecondType,
-          typename CharType>
-struct delimiters<std::pair<FirstType, SecondType>, CharType>
-{
-    static constexpr delim_wrapper<CharType> values {
-        STRING_LITERAL(CharType, "("),
-        STRING_LITERAL(CharType, ","),
-        STRING_LITERAL(CharType, " "),
-        STRING_LITERAL(CharType, ")") };
-};
+    /**
+     * @brief format state used with ostream, as captured or read anew
+     */
+    template <typename OtherStreamType>
+    format_state state(OtherStreamType& ostream) const
+    {
+        return captured_ ? state_ : format_state::capture(ostream);
+    }
 
-template <typename... DataType,
-          typename CharType>
-struct delimiters<std::tuple<DataType...>, CharType>
-{
-    static constexpr delim_wrapper<CharType> values {
-        STRING_LITERAL(CharType, "<"),
-        STRING_LITERAL(CharType, ","),
-        STRING_LITERAL(CharType, " "),
-        STRING_LITERAL(CharType, ">") };
-};
+    /**
+     * @brief level of the container, if carried (see nesting::detail::level)
+     */
+    nesting::detail::level nesting_level() const noexcept
+    {
+        return state_.nesting_level;
+    }
+
+    /**
+     * @brief inserts prefix decorator in stream
+     */
+    static void print_prefix(StreamType& ostream) noexcept
+    {
+        ostream.write(decorators.prefix, decorator_tokens::prefix_length);
+    }
+
+    /**
+     * @brief inserts element count hint in stream, if enabled with
+     *   decorator::counthint
+     * @notes empty containers are printed without a hint
+     */
+    void print_count_hint(StreamType& ostream, std::size_t count) const
+    {
+        using char_type = typename StreamType::char_type;
+
+        if (count == 0 || !count_hints(ostream))
+            return;
+        // digits formatted locally, as locale grouping does not apply
+        char_type digits[std::numeric_limits<std::size_t>::digits10 + 1];
+        char_type* const end { digits + sizeof(digits) / sizeof(char_type) };
+        char_type* first { end };
+        do {
+            *--first = char_type('0' + count % 10);
+            count /= 10;
+        } while (count != 0);
+        ostream.write(count_hint_decorators.marker,
+                      decorator_tokens::marker_length);
+        ostream.write(first, end - first);
+        ostream.write(decorator_tokens::spaced_terminator(),
+                      decorator_tokens::spaced_terminator_length);
+    }
+
+    /**
+     * @brief inserts element in stream
+     * @notes overloads as follows:
+     *   - default
+     *   - compatible containers: printed with a formatter sharing this
+     *       formatter's format state
+     *   - numbers, in their C locale representation if set with
+     *       numeric::clocalerepr
+     *   - char or string types (C or STL)
+     */
+    template <typename ElementType>
+    static auto print_element(StreamType& ostream, const ElementType& element
+        ) noexcept -> std::enable_if_t<
+            !traits::is_char_type<ElementType>::value &&
+            !traits::is_string_type<ElementType>::value &&
+            !traits::is_printable_as_container<ElementType>::value &&
+            !numeric::detail::is_charconv_number<ElementType>::value,
+            void>
+    {
+        ostream << element;
+    }
+
+    template <typename ElementType>
+    auto print_element(StreamType& ostream, const ElementType& element
+        ) const noexcept -> std::enable_if_t<
+            numeric::detail::is_charconv_number<ElementType>::value,
+            void>
+    {
+        if (c_locale_numbers(ostream))
+            ostream << numeric::detail::number(element);
+        else
+            ostream << element;
+    }
+
+    template <typename ElementType>
+    auto print_element(StreamType& ostream, const ElementType& element
+        ) const -> std::enable_if_t<
+            !traits::is_string_type<ElementType>::value &&
+            traits::is_printable_as_container<ElementType>::value,
+            void>
+    {
+        to_stream(ostream, element, default_formatter<ElementType, StreamType>{
+            state(ostream).nested() });
+    }
+
+    template<typename ElementType>
+    auto print_element(StreamType& ostream, const ElementType& element
+        ) const noexcept -> std::enable_if_t<
+            traits::is_char_type<ElementType>::value ||
+            traits::is_string_type<ElementType>::value,
+            void>
+    {
+        const repr_type type { repr(ostream) };
+        if (type == repr_type::quoted)
+            ostream << strings::quoted(element);
+        else
+            ostream << strings::detail::unquoted(element, type);
+    }
+
+    /**
+     * @brief inserts separator and whitespace decorators in stream, as one token
+     */
+    static void print_separator(StreamType& ostream) noexcept
+    {
+        ostream.write(decorator_tokens::spaced_separator(),
+                      decorator_tokens::spaced_separator_length);
+    }
+
+    /**
+     * @brief inserts suffix decorator in stream
+     */
+    static void print_suffix(StreamType& ostream) noexcept
+    {
+        ostream.write(decorators.suffix, decorator_tokens::suffix_length);
+    }
+
+private:
+    repr_type repr(StreamType& ostream) const
+    {
+        return captured_ ? state_.repr : static_cast<repr_type>(
+            ostream.iword(strings::detail::get_manip_i()));
+    }
+
+    bool count_hints(StreamType& ostream) const
+    {
+        return captured_ ? state_.count_hints :
+            decorator::detail::count_hints_enabled(ostream);
+    }
+
+    bool c_locale_numbers(StreamType& ostream) const
+    {
+        return captured_ ? state_.c_locale_numbers :
+            numeric::detail::c_locale_enabled(ostream);
+    }
 
-}  // namespace decorator
+    format_state state_ {};
+    bool captured_ {};
+};
 
 /**
- * @brief contains functions to govern input streaming/extraction of compatible
- *   containers
+ * @brief tests for formatters that can be run against a buffers::output_buffer
+ *   in place of the ostream passed to to_stream
+ * @notes only default_formatter and binary_formatter qualify, as custom
+ *   formatters may insert types or use members of StreamType not provided by
+ *   output_buffer
  */
-namespace input {
+template <typename FormatterType, typename StreamType, typename = void>
+struct is_bufferable_formatter : public std::false_type
+{};
+
+template <typename ContainerType, typename FormatterStreamType, typename StreamType>
+struct is_bufferable_formatter<
+    default_formatter<ContainerType, FormatterStreamType>, StreamType,
+    std::void_t<typename StreamType::char_type, typename StreamType::traits_type>>
+    : public std::is_base_of<std::basic_ostream<typename StreamType::char_type,
+                                                typename StreamType::traits_type>,
+                             StreamType>
+{};
 
 /**
- * @brief default formatter for the parsing of decorators and elements in a
- *   container serialization
+ * @brief formatter for the printing of elements of a container in binary
+ *   (see namespace binary), eg to be parsed by input::binary_formatter
+ * @notes only for streams of single byte chars
  */
 template <typename ContainerType, typename StreamType>
-struct default_formatter
+struct binary_formatter
 {
-    using repr_type = strings::detail::repr_type;
-    using stream_char_type = typename StreamType::char_type;
+    static_assert(sizeof(typename StreamType::char_type) == 1,
+                  "binary_formatter requires a stream of single byte chars");
 
-    static constexpr auto decorators {
-        decorator::delimiters<ContainerType, stream_char_type>::values };
+    /**
+     * @brief same formatter for use with another stream type, eg
+     *   buffers::output_buffer
+     */
+    template <typename OtherStreamType>
+    using rebind = binary_formatter<ContainerType, OtherStreamType>;
 
     /**
-     * @brief attempts stream extraction of an exact token
+     * @brief constructors
+     * @notes overloads as follows:
+     *   - default: level not carried
+     *   - level: carried from the container enclosing this one, eg by to_stream
      */
-    static void extract_token(StreamType& istream, const stream_char_type* token)
+    binary_formatter() = default;
+
+    explicit binary_formatter(const nesting::detail::level level) noexcept :
+        level_ ( level )
+    {}
+
+    nesting::detail::level nesting_level() const noexcept
     {
-        if (token == nullptr)
-        {
-            istream.setstate(std::ios_base::failbit);
-            return;
-        }
-        auto token_s {
-#if (__cplusplus >= 201703L)
-            std::basic_string_view<stream_char_type> { token }
-#else
-            std::basic_string<stream_char_type> { token }
-#endif
-        };
-        istream >> std::ws;
-        auto it_1 { token_s.begin() };
-        while (istream.good() && it_1 != token_s.end() &&
-               stream_char_type(istream.peek()) == *it_1)
-        {
-            istream.get();
-            ++it_1;
-        }
-        if (it_1 != token_s.end())
-            istream.setstate(std::ios_base::failbit);
+        return level_;
     }
 
+    static void print_prefix(StreamType& /*ostream*/) noexcept
+    {}
+
     /**
-     * @brief extracts prefix decorator from stream
+     * @brief inserts element count, which is required in binary
      */
-    static void parse_prefix(StreamType& istream) noexcept
+    static void print_count_hint(StreamType& ostream, const std::size_t count)
     {
-        extract_token(istream, decorators.prefix);
+        binary::detail::write_size(ostream, count);
     }
 
     /**
-     * @brief extracts element from stream
+     * @brief inserts element in stream
      * @notes overloads as follows:
-     *   - default
-     *   - CharT&
-     *   - (CharT&)[] (invoked in case of nested C arrays, eg CharT[][])
-     *   - basic_string&
+     *   - arithmetic and enum types
+     *   - basic_string, basic_string_view, and C strings (as basic_string,
+     *       failing if null)
+     *   - compatible containers
+     *   - other trivially copyable types, excluding pointers
+     *   - default: fails
      */
-    template<typename ElementType>
-    static auto parse_element(StreamType& istream, ElementType& element
-        ) noexcept -> std::enable_if_t<
-            !traits::is_char_type<ElementType>::value,
+    template <typename ElementType>
+    static auto print_element(StreamType& ostream, const ElementType& element
+        ) -> std::enable_if_t<
+            binary::detail::is_value<ElementType>::value,
             void>
     {
-        istream >> std::ws >> element;
+        binary::detail::write_value(ostream, element);
     }
 
-    template<typename ElementType>
-    static auto parse_element(StreamType& istream, ElementType& element
-        ) noexcept -> std::enable_if_t<
-            traits::is_char_type<ElementType>::value,
-            void>
+    template <typename CharType, typename TraitsType, typename AllocType>
+    static void print_element(
+        StreamType& ostream,
+        const std::basic_string<CharType, TraitsType, AllocType>& element)
     {
-        if (static_cast<repr_type>(
-                istream.iword(strings::detail::get_manip_i())) == repr_type::quoted)
-            istream >> std::ws >> strings::quoted(element);
-        else
-            istream >> std::ws >> strings::literal(element);
+        binary::detail::write_string(ostream, element.data(), element.size());
     }
 
-    template <typename CharType, std::size_t ArraySize>
-    static auto parse_element(
-        StreamType& istream, CharType (&element)[ArraySize]
-        ) noexcept -> std::enable_if_t<
-            traits::is_char_type<CharType>::value,
+#if (__cplusplus >= 201703L)
+    template <typename CharType>
+    static void print_element(StreamType& ostream,
+                              const std::basic_string_view<CharType>& element)
+    {
+        binary::detail::write_string(ostream, element.data(), element.size());
+    }
+
+#endif  // C++17
+    template <typename ElementType>
+    static auto print_element(StreamType& ostream, const ElementType& element
+        ) -> std::enable_if_t<
+            binary::detail::is_c_string<ElementType>::value,
             void>
     {
-        std::basic_string<CharType> s;
-        if (static_cast<repr_type>(
-                istream.iword(strings::detail::get_manip_i())) == repr_type::quoted)
-            istream >> std::ws >> strings::quoted(s);
-        else
-            istream >> std::ws >> strings::literal(s);
-        if (s.size() < ArraySize)
-        {
-            auto it {std::copy(s.begin(), s.end(), std::begin(element))};
-            std::fill(it, std::end(element), CharType('\0'));
-        }
-        else
+        using char_type =
+            std::remove_const_t<typename std::remove_pointer<ElementType>::type>;
+
+        if (element == nullptr)
         {
-            istream.setstate(std::ios_base::failbit);
+            ostream.setstate(std::ios_base::failbit);
+            return;
         }
+        binary::detail::write_string(
+            ostream, element, std::char_traits<char_type>::length(element));
     }
 
-    template<typename CharType>
-    static void parse_element(StreamType& istream,
-                              std::basic_string<CharType>& element)
+    template <typename ElementType>
+    auto print_element(StreamType& ostream, const ElementType& element
+        ) const -> std::enable_if_t<
+            traits::is_printable_as_container<ElementType>::value,
+            void>
     {
-        if (static_cast<repr_type>(
-                istream.iword(strings::detail::get_manip_i())) == repr_type::quoted)
-            istream >> std::ws >> strings::quoted(element);
-        else
-            istream >> std::ws >> strings::literal(element);
+        to_stream(ostream, element,
+                  binary_formatter<ElementType, StreamType>{ level_.nested() });
     }
 
-    /**
-     * @brief extracts separator decorator from stream
-     */
-    static void parse_separator(StreamType& istream) noexcept
+    template <typename ElementType>
+    static auto print_element(StreamType& ostream, const ElementType& element
+        ) -> std::enable_if_t<
+            binary::detail::is_raw<ElementType>::value,
+            void>
+    {
+        binary::detail::write_bytes(ostream, &element, sizeof(ElementType));
+    }
+
+    template <typename ElementType>
+    static auto print_element(StreamType& ostream, const ElementType& /*element*/
+        ) -> std::enable_if_t<
+            !binary::detail::is_value<ElementType>::value &&
+            !traits::is_printable_as_container<ElementType>::value &&
+            !binary::detail::is_raw<ElementType>::value &&
+            !binary::detail::is_c_string<ElementType>::value &&
+            !traits::is_stl_string_type<ElementType>::value,
+            void>
     {
-        extract_token(istream, decorators.separator);
+        ostream.setstate(std::ios_base::failbit);
     }
 
     /**
-     * @brief extracts suffix decorator from stream
+     * @brief inserts the elements of a contiguous container at once
      */
-    static void parse_suffix(StreamType& istream) noexcept
+    template <typename ElementType>
+    static auto print_block(StreamType& ostream, const ElementType* elements,
+                            const std::size_t count
+        ) -> std::enable_if_t<
+            binary::detail::is_value<ElementType>::value &&
+            !std::is_same<ElementType, bool>::value,
+            void>
     {
-        extract_token(istream, decorators.suffix);
+        binary::detail::write_block(ostream, elements, count);
     }
+
+    static void print_separator(StreamType& /*ostream*/) noexcept
+    {}
+
+    static void print_suffix(StreamType& /*ostream*/) noexcept
+    {}
+
+private:
+    nesting::detail::level level_ {};
 };
 
+template <typename ContainerType, typename FormatterStreamType, typename StreamType>
+struct is_bufferable_formatter<
+    binary_formatter<ContainerType, FormatterStreamType>, StreamType,
+    std::void_t<typename StreamType::char_type, typename StreamType::traits_type>>
+    : public std::is_base_of<std::basic_ostream<typename StreamType::char_type,
+                                                typename StreamType::traits_type>,
+                             StreamType>
+{};
+
 /**
- * @brief helper to array_from_stream and from_stream overloads, used to move
- *   elements which themselves may be nested containers with C arrays at some
- *   level of nesting
+ * @brief helper to to_stream and to_stream_parallel overloads, formatter rebound to
+ *   write to another stream type (eg a buffers::output_buffer wrapping ostream)
+ * @notes
+ *   - overloads as follows:
+ *     - default_formatter: carries over format state, as captured or read
+ *         from ostream, so that it is read once for the whole call
+ *     - binary_formatter
+ *     - default: rebound formatter default constructed
+ *   - level of the container (see nesting::detail::depth_guard) is carried
+ *       by default_formatter and binary_formatter to those of nested
+ *       containers
  */
-template<typename ContainerType>
-static auto c_array_compatible_move_assignment(ContainerType& source,
-                                               ContainerType& target
+template <typename OtherStreamType, typename ContainerType,
+          typename FormatterStreamType, typename StreamType>
+static default_formatter<ContainerType, OtherStreamType> rebind_formatter(
+    const default_formatter<ContainerType, FormatterStreamType>& formatter,
+    StreamType& ostream, const nesting::detail::level level = {})
+{
+    format_state state { formatter.state(ostream) };
+    state.nesting_level = level;
+    return default_formatter<ContainerType, OtherStreamType> { state };
+}
+
+template <typename OtherStreamType, typename ContainerType,
+          typename FormatterStreamType, typename StreamType>
+static binary_formatter<ContainerType, OtherStreamType> rebind_formatter(
+    const binary_formatter<ContainerType, FormatterStreamType>& /*formatter*/,
+    StreamType& /*ostream*/, const nesting::detail::level level = {})
+{
+    return binary_formatter<ContainerType, OtherStreamType> { level };
+}
+
+template <typename OtherStreamType, typename FormatterType, typename StreamType>
+static typename FormatterType::template rebind<OtherStreamType> rebind_formatter(
+    const FormatterType& /*formatter*/, StreamType& /*ostream*/,
+    const nesting::detail::level /*level*/ = {})
+{
+    return typename FormatterType::template rebind<OtherStreamType> {};
+}
+
+/**
+ * @brief helper to insert_container, counts elements for count hints
+ * @notes overloads as follows:
+ *   - size() available
+ *   - default: counted by iteration (eg std::forward_list, C arrays)
+ */
+template <typename ContainerType>
+static auto element_count(const ContainerType& container
     ) -> std::enable_if_t<
-        std::is_move_assignable<ContainerType>::value,
+        traits::has_size<ContainerType>::value,
+        std::size_t>
+{
+    return container.size();
+}
+
+template <typename ContainerType>
+static auto element_count(const ContainerType& container
+    ) -> std::enable_if_t<
+        !traits::has_size<ContainerType>::value,
+        std::size_t>
+{
+    return static_cast<std::size_t>(
+        std::distance(std::begin(container), std::end(container)));
+}
+
+/**
+ * @brief helper to insert_container, calls formatter print_count_hint hook
+ *   if provided (see traits::has_print_count_hint)
+ */
+template <typename FormatterType, typename StreamType>
+static auto print_count_hint(
+    const FormatterType& formatter, StreamType& ostream, const std::size_t count
+    ) -> std::enable_if_t<
+        traits::has_print_count_hint<FormatterType, StreamType>::value,
         void>
 {
-    target = std::move(source);
+    formatter.print_count_hint(ostream, count);
 }
 
-// TBD can this be improved with std::make_move_iterator?
-template<typename ElementType, std::size_t ArraySize>
-static void c_array_compatible_move_assignment(ElementType (&source)[ArraySize],
-                                               ElementType (&target)[ArraySize])
+template <typename FormatterType, typename StreamType>
+static auto print_count_hint(
+    const FormatterType& /*formatter*/, StreamType& /*ostream*/,
+    const std::size_t /*count*/
+    ) -> std::enable_if_t<
+        !traits::has_print_count_hint<FormatterType, StreamType>::value,
+        void>
+{}
+
+/**
+ * @brief helper to insert_container, calls formatter print_block hook if
+ *   provided for the elements of a contiguous container (see
+ *   traits::has_print_block)
+ * @return true if the elements were printed by the hook
+ */
+template <typename FormatterType, typename StreamType, typename ContainerType>
+static auto insert_block(
+    const FormatterType& formatter, StreamType& ostream,
+    const ContainerType& container
+    ) -> std::enable_if_t<
+        traits::has_print_block<FormatterType, StreamType, ContainerType>::value,
+        bool>
 {
-    auto t_end {std::end(target)};
-    for (auto s_it {std::begin(source)}, t_it {std::begin(target)};
-         t_it != t_end; ++s_it, ++t_it)
-    {
-        c_array_compatible_move_assignment(*s_it, *t_it);
-    }
+    formatter.print_block(ostream, &*std::begin(container),
+                          element_count(container));
+    return true;
+}
+
+template <typename FormatterType, typename StreamType, typename ContainerType>
+static auto insert_block(
+    const FormatterType& /*formatter*/, StreamType& /*ostream*/,
+    const ContainerType& /*container*/
+    ) -> std::enable_if_t<
+        !traits::has_print_block<FormatterType, StreamType, ContainerType>::value,
+        bool>
+{
+    return false;
 }
 
-// TBD can the relevant from_stream overloads be combined instead with a SFINAE
-//   struct is_array, while not letting CharT[] types decay to CharT*?
 /**
- * @brief wraps logic for C array and std::array overloads of from_stream
+ * @brief helper to to_stream(tuple), recursive struct meant to unpack and
+ *   parse std::tuple elements
+ * @notes overloads as follows:
+ *   - default
+ *   - last element in tuple
  */
-template <typename ContainerType, typename StreamType, typename FormatterType>
-static StreamType& array_from_stream(
-    StreamType& istream, ContainerType& container,
-    const FormatterType& formatter)
+template <typename TupleType, std::size_t Index, std::size_t Last>
+struct tuple_handler
 {
-    formatter.parse_prefix(istream);
-    if (!istream.good())
-        return istream;
+    template <typename StreamType, typename FormatterType>
+    static void print(
+        StreamType& ostream, const TupleType& tuple, const FormatterType& formatter)
+    {
+        formatter.print_element(ostream, std::get<Index>(tuple));
+        instrumentation::policy::count_elements(1);
+        formatter.print_separator(ostream);
+        tuple_handler<TupleType, Index + 1, Last>::print(ostream, tuple, formatter);
+    }
+};
 
-    if (container_stream_io::traits::is_empty(container)) {
-        formatter.parse_suffix(istream);
-        return istream;
+template <typename TupleType, std::size_t Index>
+struct tuple_handler<TupleType, Index, Index>
+{
+    template <typename StreamType, typename FormatterType>
+    static void print(
+        StreamType& ostream, const TupleType& tuple, const FormatterType& formatter) noexcept
+    {
+        formatter.print_element(ostream, std::get<Index>(tuple));
+        instrumentation::policy::count_elements(1);
     }
+};
 
-    ContainerType temp_container;
-    auto tc_it {std::begin(temp_container)};
-    auto tc_end {std::end(temp_container)};
+/**
+ * @brief helper to to_stream, stream insertion of compatible container type
+ * @notes overloads as follows:
+ *   - std::tuple<T...>
+ *   - std::tuple<>
+ *   - std::pair
+ *   - iterator_range, range_holder: elements printed as they are produced
+ *   - default: intended for "iterable" STL containers (see
+ *       traits::is_printable_as_container)
+ */
+template <typename StreamType, typename FormatterType, typename... TupleArgs>
+static StreamType& insert_container(
+    StreamType& ostream, const std::tuple<TupleArgs...>& tuple,
+    const FormatterType& formatter)
+{
+    using TupleType = std::decay_t<decltype(tuple)>;
 
-    formatter.parse_element(istream, *tc_it);
-    if (!istream.good())
-        return istream;
-    ++tc_it;
+    formatter.print_prefix(ostream);
+    container_stream_io::output::tuple_handler<
+        TupleType, 0, sizeof...(TupleArgs) - 1>::print(ostream, tuple, formatter);
+    formatter.print_suffix(ostream);
 
-    for (; !istream.eof() && tc_it != tc_end; ++tc_it) {
-        formatter.parse_separator(istream);
-        if (!istream.good())
-            return istream;
+    return ostream;
+}
 
-        formatter.parse_element(istream, *tc_it);
-        if (!istream.good())
-            return istream;
-    }
+template <typename StreamType, typename FormatterType, typename... TupleArgs>
+static StreamType& insert_container(
+    StreamType& ostream, const std::tuple<>& /*tuple*/,
+    const FormatterType& formatter)
+{
+    formatter.print_prefix(ostream);
+    formatter.print_suffix(ostream);
+    return ostream;
+}
 
-    if (tc_it != tc_end) {  // serialization too short
-        istream.setstate(std::ios_base::failbit);
-        return istream;
-    }
+template <typename FirstType, typename SecondType, typename StreamType, typename FormatterType>
+static StreamType& insert_container(
+    StreamType& ostream, const std::pair<FirstType, SecondType>& container,
+    const FormatterType& formatter)
+{
+    formatter.print_prefix(ostream);
+    formatter.print_element(ostream, container.first);
+    formatter.print_separator(ostream);
+    formatter.print_element(ostream, container.second);
+    formatter.print_suffix(ostream);
+    instrumentation::policy::count_elements(2);
 
-    formatter.parse_suffix(istream);  // fails if serialization too long
-    if (istream.good())
-        c_array_compatible_move_assignment(temp_container, container);
-    return istream;
+    return ostream;
 }
 
 /**
- * @brief helper to from_stream(tuple), recursive struct meant to unpack and
- *   parse std::tuple elements
- * @notes overloads as follows:
- *   - default
- *   - last element in tuple
+ * @brief sequence of elements produced by iteration from first until last,
+ *   printed as a container without being materialized (see range)
+ * @notes IteratorType may be single pass, eg std::istream_iterator, and
+ *   SentinelType any type comparable with it
+ */
+template <typename IteratorType, typename SentinelType = IteratorType>
+struct iterator_range
+{
+    IteratorType first;
+    SentinelType last;
+};
+
+#ifdef CONTAINER_STREAM_IO_RANGES
+/**
+ * @brief C++20 range printed as a container without being materialized (see
+ *   range), held by value if an rvalue, otherwise by pointer
+ * @notes
+ *   - specializations as follows:
+ *     - default: rvalue, held by value
+ *     - lvalue reference: held by pointer, as a reference member can't be
+ *         mutable
+ *   - get() is non-const as views need not be const-iterable (eg
+ *       std::ranges::filter_view), and single pass ranges (eg
+ *       std::generator) are iterated only once, when printed
  */
-template <typename TupleType, std::size_t Index, std::size_t Last>
-struct tuple_handler
+template <typename RangeType>
+struct range_holder
 {
-    template <typename StreamType, typename FormatterType>
-    static void parse(
-        StreamType& istream, TupleType& tuple, const FormatterType& formatter)
+    RangeType& get() const
     {
-        if (istream.good())
-            formatter.parse_element(istream, std::get<Index>(tuple));
-        if (istream.good())
-            formatter.parse_separator(istream);
-        if (istream.good())
-            tuple_handler<TupleType, Index + 1, Last>::parse(istream, tuple, formatter);
+        return range;
     }
+
+    mutable RangeType range;
 };
 
-template <typename TupleType, std::size_t Index>
-struct tuple_handler<TupleType, Index, Index>
+template <typename RangeType>
+struct range_holder<RangeType&>
 {
-    template <typename StreamType, typename FormatterType>
-    static void parse(
-        StreamType& istream, TupleType& tuple, const FormatterType& formatter) noexcept
+    explicit range_holder(RangeType& range) :
+        range_ { std::addressof(range) }
+    {}
+
+    RangeType& get() const
     {
-        if (istream.good())
-            formatter.parse_element(istream, std::get<Index>(tuple));
+        return *range_;
     }
+
+private:
+    RangeType* range_;
 };
 
+#endif  // CONTAINER_STREAM_IO_RANGES
+/**
+ * @brief tests for formatters that cannot print containers without a count
+ *   hint, eg binary_formatter
+ */
+template <typename FormatterType>
+struct requires_count_hint : public std::false_type
+{};
+
+template <typename ContainerType, typename StreamType>
+struct requires_count_hint<binary_formatter<ContainerType, StreamType>>
+    : public std::true_type
+{};
+
 /**
- * @brief helper to default from_stream overload, uses appropriate emplacement
- *   method based on container type
+ * @brief tests for ranges delimited by two multi-pass (forward) iterators,
+ *   which can be counted without consuming them
+ */
+template <typename IteratorType, typename SentinelType, typename = void>
+struct is_multipass_range : public std::false_type
+{};
+
+template <typename IteratorType>
+struct is_multipass_range<
+    IteratorType, IteratorType, std::void_t<
+    typename std::iterator_traits<IteratorType>::iterator_category>>
+    : public std::is_base_of<
+    std::forward_iterator_tag,
+    typename std::iterator_traits<IteratorType>::iterator_category>
+{};
+
+/**
+ * @brief helper to insert_container(iterator_range), counts elements for
+ *   count hints when that does not consume them
  * @notes overloads as follows:
- *   - emplace_back (preferred over other emplace methods)
- *   - no emplace_back, but emplace (no const iterator needed) available
- *   - emplace (no const iterator needed) available, elements are std::pair with
- *       const .first (used for std::(unordered_)(multi)(set|map), where const
- *       pair.first makes elements non-move-assignable)
+ *   - multi-pass range (see is_multipass_range)
+ *   - default: not counted
+ * @return true if counted
  */
-template<typename ContainerType, typename ElementType>
-static auto emplace_element(ContainerType& container, const ElementType& element
-    ) noexcept -> std::enable_if_t<
-        traits::has_emplace_back<ContainerType>::value,
-        void>
+template <typename IteratorType, typename SentinelType>
+static auto range_count(
+    const IteratorType& first, const SentinelType& last, std::size_t& count
+    ) -> std::enable_if_t<
+        is_multipass_range<IteratorType, SentinelType>::value,
+        bool>
 {
-    container.emplace_back(element);
+    count = static_cast<std::size_t>(std::distance(first, last));
+    return true;
 }
 
-template <typename ContainerType, typename ElementType>
-static auto emplace_element(ContainerType& container, const ElementType& element
-    ) noexcept -> std::enable_if_t<
-        traits::has_iterless_emplace<ContainerType>::value &&
-        !traits::has_emplace_back<ContainerType>::value,
-        void>
+template <typename IteratorType, typename SentinelType>
+static auto range_count(
+    const IteratorType& /*first*/, const SentinelType& /*last*/,
+    std::size_t& /*count*/
+    ) -> std::enable_if_t<
+        !is_multipass_range<IteratorType, SentinelType>::value,
+        bool>
 {
-    container.emplace(element);
+    return false;
 }
 
-template <typename ContainerType, typename KeyType, typename ValueType>
-static auto emplace_element(ContainerType& container,
-                            const std::pair<const KeyType, ValueType>& element
-    ) noexcept -> std::enable_if_t<
-        traits::has_iterless_emplace<ContainerType>::value,
-        void>
+/**
+ * @brief helper to insert_container(iterator_range) and
+ *   insert_container(range_holder), prints the count hint and the elements
+ *   as they are produced, then the suffix
+ * @notes
+ *   - with a bufferable formatter, output is written on to the ostream
+ *       whenever the output_buffer fills, so memory use is bounded
+ *       regardless of the number of elements
+ *   - sets failbit if the formatter requires a count hint that cannot be
+ *       given without consuming the range
+ */
+template <typename StreamType, typename IteratorType, typename SentinelType,
+          typename FormatterType>
+static StreamType& insert_elements(
+    StreamType& ostream, IteratorType first, const SentinelType last,
+    const FormatterType& formatter, const bool counted, const std::size_t count)
 {
-    container.emplace(element.first, element.second);
+    if (!counted && requires_count_hint<FormatterType>::value) {
+        ostream.setstate(std::ios_base::failbit);
+        return ostream;
+    }
+    formatter.print_prefix(ostream);
+    if (counted)
+        print_count_hint(formatter, ostream, count);
+
+    if (first != last) {
+        formatter.print_element(ostream, *first);
+        instrumentation::policy::count_elements(1);
+        for (++first; first != last; ++first)
+        {
+            formatter.print_separator(ostream);
+            formatter.print_element(ostream, *first);
+            instrumentation::policy::count_elements(1);
+        }
+    }
+
+    formatter.print_suffix(ostream);
+
+    return ostream;
 }
 
-/**
- * @brief stream extraction of compatible container type
- * @notes overloads as follows:
- *   - C array
- *   - std::array
- *   - std::tuple<T...>
- *   - std::tuple<>
- *   - std::pair
- *   - std::forward_list: unique overload required due to forward_list not
- *       having emplace(_back) or an easy way to get an iterator to the last
- *       element (end(), but no --it)
- *   - default: intended for "iterable" STL containers (see
- *       traits::is_parseable_as_container)
- */
-template <typename ElementType, std::size_t ArraySize,
+template <typename IteratorType, typename SentinelType,
           typename StreamType, typename FormatterType>
-static StreamType& from_stream(
-    StreamType& istream, ElementType (&container)[ArraySize],
+static StreamType& insert_container(
+    StreamType& ostream, const iterator_range<IteratorType, SentinelType>& range,
     const FormatterType& formatter)
 {
-    return array_from_stream(istream, container, formatter);
+    std::size_t count {};
+    const bool counted { range_count(range.first, range.last, count) };
+    return insert_elements(
+        ostream, range.first, range.last, formatter, counted, count);
 }
 
-template <typename ElementType, std::size_t ArraySize,
-          typename StreamType, typename FormatterType>
-static StreamType& from_stream(
-    StreamType& istream, std::array<ElementType, ArraySize>& container,
-    const FormatterType& formatter)
+#ifdef CONTAINER_STREAM_IO_RANGES
+template <typename RangeType, typename StreamType, typename FormatterType>
+static auto insert_container(
+    StreamType& ostream, const range_holder<RangeType>& holder,
+    const FormatterType& formatter
+    ) -> std::enable_if_t<
+        std::ranges::sized_range<RangeType>,
+        StreamType&>
 {
-    return array_from_stream(istream, container, formatter);
+    return insert_elements(
+        ostream, std::ranges::begin(holder.get()), std::ranges::end(holder.get()),
+        formatter, true, static_cast<std::size_t>(std::ranges::size(holder.get())));
 }
 
-template <typename StreamType, typename FormatterType, typename... TupleArgs>
-static StreamType& from_stream(
-    StreamType& istream, std::tuple<TupleArgs...>& container,
+template <typename RangeType, typename StreamType, typename FormatterType>
+static auto insert_container(
+    StreamType& ostream, const range_holder<RangeType>& holder,
+    const FormatterType& formatter
+    ) -> std::enable_if_t<
+        !std::ranges::sized_range<RangeType>,
+        StreamType&>
+{
+    return insert_elements(
+        ostream, std::ranges::begin(holder.get()), std::ranges::end(holder.get()),
+        formatter, false, 0);
+}
+
+#endif  // CONTAINER_STREAM_IO_RANGES
+template <typename ContainerType, typename StreamType, typename FormatterType>
+static StreamType& insert_container(
+    StreamType& ostream, const ContainerType& container,
     const FormatterType& formatter)
 {
-    using ContainerType = std::decay_t<decltype(container)>;
+    const std::size_t count { element_count(container) };
+    formatter.print_prefix(ostream);
+    print_count_hint(formatter, ostream, count);
+    instrumentation::policy::count_elements(count);
 
-    ContainerType temp;
-    formatter.parse_prefix(istream);
-    tuple_handler<ContainerType, 0, sizeof...(TupleArgs) - 1
-                  >::parse(istream, temp, formatter);
-    formatter.parse_suffix(istream);
-    // C arrays not allowed as STL container members due to non-move-
-    //   constructiblity, so no need for c_array_compatible_move_assignment
-    if (istream.good())
-        container = std::move(temp);
-    return istream;
+    if (container_stream_io::traits::is_empty(container) ||
+        insert_block(formatter, ostream, container)) {
+        formatter.print_suffix(ostream);
+
+        return ostream;
+    }
+
+    auto begin = std::begin(container);
+    formatter.print_element(ostream, *begin);
+
+    std::advance(begin, 1);
+
+    std::for_each(begin, std::end(container),
+#ifdef __cpp_generic_lambdas
+                  [&ostream, &formatter](const auto& element) {
+#else
+                  [&ostream, &formatter](const decltype(*begin)& element) {
+#endif
+        formatter.print_separator(ostream);
+        formatter.print_element(ostream, element);
+    });
+
+    formatter.print_suffix(ostream);
+
+    return ostream;
 }
 
-template <typename StreamType, typename FormatterType>
-static StreamType& from_stream(
-    StreamType& istream, std::tuple<>& /*container*/,
+/**
+ * @brief helper to to_stream, insertion of STL container adaptors, printed
+ *   as their underlying container, read in place
+ * @notes overloads as follows:
+ *   - std::stack: bottom to top
+ *   - std::queue: front to back
+ *   - std::priority_queue: heap order, top first
+ */
+template <typename ElementType, typename UnderlyingType,
+          typename StreamType, typename FormatterType>
+static StreamType& insert_container(
+    StreamType& ostream, const std::stack<ElementType, UnderlyingType>& container,
     const FormatterType& formatter)
 {
-    // no contents to parse, only checks if prefix or suffix properly encoded
-    formatter.parse_prefix(istream);
-    formatter.parse_suffix(istream);
-    return istream;
+    using access = traits::adaptor_access<std::stack<ElementType, UnderlyingType>>;
+
+    return insert_container(ostream, access::container(container), formatter);
 }
 
-template <typename FirstType, typename SecondType,
+template <typename ElementType, typename UnderlyingType,
           typename StreamType, typename FormatterType>
-static StreamType& from_stream(
-    StreamType& istream, std::pair<FirstType, SecondType>& container,
+static StreamType& insert_container(
+    StreamType& ostream, const std::queue<ElementType, UnderlyingType>& container,
     const FormatterType& formatter)
 {
-    formatter.parse_prefix(istream);
-    if (!istream.good())
-        return istream;
+    using access = traits::adaptor_access<std::queue<ElementType, UnderlyingType>>;
 
-    // pairs are commonly encountered as elements of std::(unordered_)(multi)(sets|map)s,
-    //   in which case keys are const regardless of key type passed to container template
-    using BaseFirstType = typename std::remove_const<FirstType>::type;
-    BaseFirstType first;
-    SecondType second;
+    return insert_container(ostream, access::container(container), formatter);
+}
 
-    formatter.parse_element(istream, first);
-    if (!istream.good())
-        return istream;
+template <typename ElementType, typename UnderlyingType, typename CompareType,
+          typename StreamType, typename FormatterType>
+static StreamType& insert_container(
+    StreamType& ostream,
+    const std::priority_queue<ElementType, UnderlyingType, CompareType>& container,
+    const FormatterType& formatter)
+{
+    using access = traits::adaptor_access<
+        std::priority_queue<ElementType, UnderlyingType, CompareType>>;
 
-    formatter.parse_separator(istream);
-    if (!istream.good())
-        return istream;
+    return insert_container(ostream, access::container(container), formatter);
+}
 
-    formatter.parse_element(istream, second);
-    if (!istream.good())
-        return istream;
+/**
+ * @brief stream insertion of compatible container type
+ * @notes overloads as follows:
+ *   - default: formatter used as given
+ *   - bufferable: default_formatter writing to an ostream, rebound to write to
+ *       a buffers::output_buffer wrapping that ostream, which is then shared by
+ *       all nested containers
+ */
+template <typename ContainerType, typename StreamType, typename FormatterType>
+static auto to_stream(
+    StreamType& ostream, const ContainerType& container,
+    const FormatterType& formatter
+    ) -> std::enable_if_t<
+        !is_bufferable_formatter<FormatterType, StreamType>::value,
+        StreamType&>
+{
+    const nesting::detail::depth_guard<StreamType> depth {
+        ostream, nesting::detail::carried_level(formatter),
+        nesting::detail::has_opaque_elements<ContainerType>::value };
+    if (depth.exceeded())
+    {
+        ostream.setstate(std::ios_base::failbit);
+        return ostream;
+    }
+    const instrumentation::output_scope<StreamType> scope { ostream };
+    return insert_container(ostream, container, formatter);
+}
 
-    formatter.parse_suffix(istream);
-    if (istream.bad() || istream.fail())
-        return istream;
+template <typename ContainerType, typename StreamType, typename FormatterType>
+static auto to_stream(
+    StreamType& ostream, const ContainerType& container,
+    const FormatterType& formatter
+    ) -> std::enable_if_t<
+        is_bufferable_formatter<FormatterType, StreamType>::value,
+        StreamType&>
+{
+    using buffer_type = buffers::output_buffer<
+        typename StreamType::char_type, typename StreamType::traits_type>;
 
-    // C arrays not allowed as STL container members due to non-move-
-    //   constructiblity, so no need for c_array_compatible_move_assignment
-    const_cast<BaseFirstType&>(container.first) = std::move(first);
-    container.second = std::move(second);
+    const nesting::detail::depth_guard<StreamType> depth {
+        ostream, nesting::detail::carried_level(formatter),
+        nesting::detail::has_opaque_elements<ContainerType>::value };
+    if (depth.exceeded())
+    {
+        ostream.setstate(std::ios_base::failbit);
+        return ostream;
+    }
+    // counts chars once flushed by buffer
+    const instrumentation::output_scope<StreamType> scope { ostream };
+    buffer_type buffer { ostream };
+    if (buffer.good())
+        insert_container(buffer, container, rebind_formatter<buffer_type>(
+            formatter, ostream, depth.current()));
+    buffer.flush();
 
-    return istream;
+    return ostream;
 }
 
-template <typename StreamType, typename ElementType, typename FormatterType>
-static StreamType& from_stream(
-    StreamType& istream, std::forward_list<ElementType>& container,
-    const FormatterType& formatter)
+/**
+ * @brief wraps a sequence of elements to be printed as a container, eg
+ *   `ostream << output::range(first, last)`, with the elements printed as
+ *   they are produced instead of first being copied into a container
+ * @notes overloads as follows:
+ *   - iterator and sentinel (see iterator_range)
+ *   - C++20 range, eg a view or std::generator (see range_holder)
+ */
+template <typename IteratorType, typename SentinelType>
+inline iterator_range<IteratorType, SentinelType> range(
+    IteratorType first, SentinelType last)
 {
-    formatter.parse_prefix(istream);
-    if (!istream.good())
-        return istream;
-
-    std::forward_list<ElementType> new_container;
-    ElementType temp_elem;
-
-    // parse suffix to check for empty container
-    formatter.parse_suffix(istream);
-    if (!istream.bad()) {
-        if (!istream.fail()) {
-            container.clear();
-            return istream;
-        } else {
-            istream.clear();
-        }
-    }
+    return iterator_range<IteratorType, SentinelType> {
+        std::move(first), std::move(last) };
+}
 
-    auto nc_it { new_container.before_begin() };
-    formatter.parse_element(istream, temp_elem);
-    if (!istream.good())
-        return istream;
-    new_container.emplace_after(nc_it, temp_elem);
-    // forward_list iterators are not affected by new emplacements, therefore
-    //   nc_it can continue to be used as indicating position before last element
-    ++nc_it;
+#ifdef CONTAINER_STREAM_IO_RANGES
+template <std::ranges::input_range RangeType>
+inline range_holder<RangeType> range(RangeType&& range)
+{
+    return range_holder<RangeType> { std::forward<RangeType>(range) };
+}
 
-    while (!istream.eof()) {
-        // parse suffix first to detect end of serialization
-        formatter.parse_suffix(istream);
-        if (!istream.bad()) {
-            if (!istream.fail())
-                break;
-            else
-                istream.clear();
-        }
+#endif  // CONTAINER_STREAM_IO_RANGES
+/**
+ * @brief stream insertion of the elements from first until last as a
+ *   container, without materializing them (see range)
+ */
+template <typename IteratorType, typename SentinelType,
+          typename StreamType, typename FormatterType>
+static StreamType& to_stream(
+    StreamType& ostream, IteratorType first, SentinelType last,
+    const FormatterType& formatter)
+{
+    return to_stream(ostream, range(std::move(first), std::move(last)), formatter);
+}
 
-        formatter.parse_separator(istream);
-        if (!istream.good())
-            return istream;
+/**
+ * @brief stream insertion of compatible container type, with the formatter
+ *   selected by stream format state: output::binary_formatter if set with
+ *   binary::binaryrepr, otherwise output::default_formatter
+ * @notes overloads as follows:
+ *   - streams of single byte chars
+ *   - default: binary not available, default_formatter used
+ */
+template <typename ContainerType, typename StreamType>
+static auto to_stream_selected(StreamType& ostream, const ContainerType& container
+    ) -> std::enable_if_t<
+        sizeof(typename StreamType::char_type) == 1,
+        StreamType&>
+{
+    if (binary::detail::binary_enabled(ostream))
+        return to_stream(ostream, container,
+                         binary_formatter<ContainerType, StreamType>{});
+    return to_stream(ostream, container,
+                     default_formatter<ContainerType, StreamType>{});
+}
 
-        formatter.parse_element(istream, temp_elem);
-        if (!istream.good())
-            return istream;
-        new_container.emplace_after(nc_it, temp_elem);
-        ++nc_it;
+template <typename ContainerType, typename StreamType>
+static auto to_stream_selected(StreamType& ostream, const ContainerType& container
+    ) -> std::enable_if_t<
+        sizeof(typename StreamType::char_type) != 1,
+        StreamType&>
+{
+    return to_stream(ostream, container,
+                     default_formatter<ContainerType, StreamType>{});
+}
+
+/**
+ * @brief helper to to_stream_parallel, inserts a chunk of elements, each
+ *   preceded by a separator unless it is the first element of the container
+ * @notes
+ *   - overloads as follows:
+ *     - default: formatter used as given
+ *     - bufferable: rebound to write to a buffers::output_buffer, as in
+ *         to_stream
+ *   - level is that of the container, as counted by to_stream_parallel
+ */
+template <typename IteratorType, typename StreamType, typename FormatterType>
+static auto insert_chunk(
+    StreamType& ostream, IteratorType first, const IteratorType last,
+    const bool leading_separator, const FormatterType& formatter,
+    const nesting::detail::level /*level*/
+    ) -> std::enable_if_t<
+        !is_bufferable_formatter<FormatterType, StreamType>::value,
+        void>
+{
+    for (bool separate { leading_separator }; first != last; ++first)
+    {
+        if (separate)
+            formatter.print_separator(ostream);
+        formatter.print_element(ostream, *first);
+        instrumentation::policy::count_elements(1);
+        separate = true;
     }
+}
 
-    // C arrays not allowed as STL container members due to non-move-
-    //   constructiblity, so no need for c_array_compatible_move_assignment
-    if (istream.good())
-        container = std::move(new_container);
-    return istream;
+template <typename IteratorType, typename StreamType, typename FormatterType>
+static auto insert_chunk(
+    StreamType& ostream, IteratorType first, const IteratorType last,
+    const bool leading_separator, const FormatterType& formatter,
+    const nesting::detail::level level
+    ) -> std::enable_if_t<
+        is_bufferable_formatter<FormatterType, StreamType>::value,
+        void>
+{
+    using buffer_type = buffers::output_buffer<
+        typename StreamType::char_type, typename StreamType::traits_type>;
+
+    buffer_type buffer { ostream };
+    if (buffer.good())
+        insert_chunk(buffer, first, last, leading_separator,
+                     rebind_formatter<buffer_type>(formatter, ostream, level),
+                     level);
+    buffer.flush();
 }
 
-// TBD use of clear could be avoided with container = ContainerType{}
+/**
+ * @brief stream insertion of compatible random access container type (eg
+ *   std::vector, std::deque, std::array, C arrays), with elements formatted
+ *   concurrently
+ * @notes
+ *   - output is the same as that of to_stream: elements are split into
+ *       chunks, each formatted by a worker thread into its own
+ *       basic_ostringstream (with the format state of ostream, see
+ *       std::basic_ios::copyfmt), and chunks are then written in order
+ *   - chunks are formatted in rounds of one per thread, so that at most one
+ *       round of output is held in memory at a time, by a
+ *       parallel::worker_group started once per call
+ *   - formatter must accept a basic_ostringstream of the same char type as
+ *       ostream (eg by taking basic_ostream&); default_formatter is rebound to
+ *       it, and takes each chunk through a buffers::output_buffer
+ *   - thread_count of 0 uses std::thread::hardware_concurrency(); containers
+ *       too small to split are inserted with to_stream
+ *   - if formatting a chunk fails, the stream state of that chunk is set on
+ *       ostream, and no further chunks are written
+ */
 template <typename ContainerType, typename StreamType, typename FormatterType>
-static StreamType& from_stream(
-    StreamType& istream, ContainerType& container,
-    const FormatterType& formatter)
+static StreamType& to_stream_parallel(
+    StreamType& ostream, const ContainerType& container,
+    const FormatterType& formatter, std::size_t thread_count = 0)
 {
-    formatter.parse_prefix(istream);
-    if (!istream.good())
-        return istream;
+    using iterator_type = decltype(std::begin(container));
+    using difference_type =
+        typename std::iterator_traits<iterator_type>::difference_type;
+    using char_type = typename StreamType::char_type;
+    using traits_type = typename StreamType::traits_type;
+    using chunk_stream_type = std::basic_ostringstream<char_type, traits_type>;
+
+    static_assert(std::is_base_of<
+                  std::random_access_iterator_tag,
+                  typename std::iterator_traits<iterator_type>::iterator_category
+                  >::value, "to_stream_parallel requires random access iterators");
+    // fewer elements per thread are not worth the thread
+    static constexpr std::size_t min_chunk_size { 1024 };
+    // target chunks per thread, to bound the output held in memory
+    static constexpr std::size_t rounds { 16 };
+
+    if (thread_count == 0)
+        thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    const std::size_t size { element_count(container) };
+    if (thread_count == 1 || size < min_chunk_size * 2)
+        return to_stream(ostream, container, formatter);
+    const std::size_t chunk_size { std::max(
+        min_chunk_size, (size + thread_count * rounds - 1) / (thread_count * rounds)) };
+
+    // counted on ostream before chunk streams copy its format state, so
+    //   that nested containers count the outermost
+    const nesting::detail::depth_guard<StreamType> depth { ostream };
+    if (depth.exceeded())
+    {
+        ostream.setstate(std::ios_base::failbit);
+        return ostream;
+    }
+    const instrumentation::output_scope<StreamType> scope { ostream };
+    instrumentation::worker_counters<> worker_counts { thread_count };
 
-    ContainerType new_container;
-    typename ContainerType::value_type temp_elem;
+    // as with output_buffer in to_stream
+    if (is_bufferable_formatter<FormatterType, StreamType>::value)
+        ostream.width(0);
+    formatter.print_prefix(ostream);
+    print_count_hint(formatter, ostream, size);
 
-    // parse suffix to check for empty container
-    formatter.parse_suffix(istream);
-    if (!istream.bad()) {
-        if (!istream.fail()) {
-            container.clear();
-            return istream;
-        } else {
-            istream.clear();
+    const iterator_type begin { std::begin(container) };
+    std::vector<chunk_stream_type> chunks (thread_count);
+    std::vector<std::exception_ptr> errors (thread_count);
+    std::size_t round_first {};
+
+    const auto format_chunk = [&](const std::size_t i) {
+        const std::size_t first { round_first + i * chunk_size };
+        if (first >= size)
+            return;
+        const std::size_t last { std::min(size, first + chunk_size) };
+        const instrumentation::worker_counters<>::scope counting {
+            worker_counts, i };
+        try {
+            insert_chunk(chunks[i],
+                         begin + static_cast<difference_type>(first),
+                         begin + static_cast<difference_type>(last),
+                         first != 0, formatter, depth.current());
+        } catch (...) {
+            errors[i] = std::current_exception();
         }
-    }
+    };
+    // started once, and idle while chunks are written between rounds
+    parallel::worker_group workers { thread_count };
 
-    formatter.parse_element(istream, temp_elem);
-    if (!istream.good())
-        return istream;
-    emplace_element(new_container, temp_elem);
+    for (; round_first < size && ostream.good();
+         round_first += chunk_size * thread_count)
+    {
+        // format state copied on this thread, as ostream is not thread safe
+        for (chunk_stream_type& chunk : chunks)
+        {
+            chunk.str(std::basic_string<char_type, traits_type>());
+            chunk.clear();
+            chunk.copyfmt(ostream);
+            chunk.tie(nullptr);
+        }
+        workers.run(format_chunk);
+        worker_counts.merge();
 
-    while (!istream.eof()) {
-        // parse suffix first to detect end of serialization
-        formatter.parse_suffix(istream);
-        if (!istream.bad()) {
-            if (!istream.fail())
+        for (std::size_t i {}; i < thread_count && ostream.good(); ++i)
+        {
+            if (errors[i])
+                std::rethrow_exception(errors[i]);
+            if (!chunks[i].good())
+            {
+                ostream.setstate(chunks[i].rdstate());
                 break;
-            else
-                istream.clear();
+            }
+            const auto& text (chunks[i].str());
+            ostream.write(text.data(), static_cast<std::streamsize>(text.size()));
         }
-
-        formatter.parse_separator(istream);
-        if (!istream.good())
-            return istream;
-
-        formatter.parse_element(istream, temp_elem);
-        if (!istream.good())
-            return istream;
-        emplace_element(new_container, temp_elem);
     }
 
-    // C arrays not allowed as STL container members due to non-move-
-    //   constructiblity, so no need for c_array_compatible_move_assignment
-    if (istream.good())
-        container = std::move(new_container);
-    return istream;
+    if (ostream.good())
+        formatter.print_suffix(ostream);
+    return ostream;
 }
 
-}  // namespace input
+/**
+ * @brief contains implementation details of to_stream_committed
+ */
+namespace detail {
 
 /**
- * @brief contains functions to govern output streaming/insertion of compatible
- *   containers
+ * @brief stream formatting into a growable_streambuf, one pooled per thread
+ *   and char type (see local_emission)
  */
-namespace output {
+template <typename CharType, typename TraitsType>
+struct emission_buffer
+{
+    buffers::growable_streambuf<CharType, TraitsType> streambuf;
+    std::basic_ostream<CharType, TraitsType> stream { &streambuf };
+    bool in_use {};
+};
+
+template <typename CharType, typename TraitsType>
+static emission_buffer<CharType, TraitsType>& local_emission()
+{
+    static thread_local emission_buffer<CharType, TraitsType> buffer;
+    return buffer;
+}
 
 /**
- * @brief default formatter for the printing of decorators and elements in a
- *   container serialization
+ * @brief stand-in for a mutex where the streambuf of the destination
+ *   serializes writes itself
  */
-template <typename ContainerType, typename StreamType>
-struct default_formatter
+struct unlocked
 {
-    static constexpr auto decorators {
-        decorator::delimiters<ContainerType, typename StreamType::char_type>::values };
+    void lock() noexcept
+    {}
 
-    using repr_type = strings::detail::repr_type;
+    void unlock() noexcept
+    {}
+};
 
-    /**
-     * @brief inserts prefix decorator in stream
-     */
-    static void print_prefix(StreamType& ostream) noexcept
+/**
+ * @brief formats container into buffer, then writes it to ostream whole
+ *   under a lock of mutex
+ */
+template <typename ContainerType, typename StreamType, typename FormatterType,
+          typename MutexType, typename CharType, typename TraitsType>
+static void emit(
+    StreamType& ostream, const ContainerType& container,
+    const FormatterType& formatter, MutexType& mutex,
+    emission_buffer<CharType, TraitsType>& buffer)
+{
+    // format state copied on this thread; not tied, so that formatting does
+    //   not flush the shared destination
+    buffer.streambuf.clear();
+    buffer.stream.copyfmt(ostream);
+    buffer.stream.clear();
+    buffer.stream.tie(nullptr);
+    to_stream(buffer.stream, container, formatter);
+
+    const std::lock_guard<MutexType> lock { mutex };
+    if (!buffer.stream.good())
     {
-        ostream << decorators.prefix;
+        ostream.setstate(buffer.stream.rdstate());
+        return;
     }
+    ostream.write(buffer.streambuf.data(),
+                  static_cast<std::streamsize>(buffer.streambuf.size()));
+}
 
-    /**
-     * @brief inserts element in stream
-     * @notes overloads as follows:
-     *   - default
-     *   - char or string types (C or STL)
-     */
-    template <typename ElementType>
-    static auto print_element(StreamType& ostream, const ElementType& element
-        ) noexcept -> std::enable_if_t<
-            !traits::is_char_type<ElementType>::value &&
-            !traits::is_string_type<ElementType>::value,
-            void>
+/**
+ * @brief marks the pooled buffer of this thread as in use for its lifetime
+ */
+template <typename CharType, typename TraitsType>
+class emission_lease
+{
+public:
+    emission_lease() : buffer_ ( local_emission<CharType, TraitsType>() )
     {
-        ostream << element;
+        pooled_ = !buffer_.in_use;
+        buffer_.in_use = true;
     }
 
-    template<typename ElementType>
-    static auto print_element(StreamType& ostream, const ElementType& element
-        ) noexcept -> std::enable_if_t<
-            traits::is_char_type<ElementType>::value ||
-            traits::is_string_type<ElementType>::value,
-            void>
+    emission_lease(const emission_lease&) = delete;
+    emission_lease& operator=(const emission_lease&) = delete;
+
+    ~emission_lease()
     {
-        if (static_cast<repr_type>(
-                ostream.iword(strings::detail::get_manip_i())) == repr_type::quoted)
-            ostream << strings::quoted(element);
-        else
-            ostream << strings::literal(element);
+        if (pooled_)
+            buffer_.in_use = false;
     }
 
     /**
-     * @brief inserts separator and whitespace decorators in stream
+     * @return false if the pooled buffer is already in use on this thread,
+     *   eg by an element printed with to_stream_committed
      */
-    static void print_separator(StreamType& ostream) noexcept
+    bool pooled() const noexcept
     {
-        ostream << decorators.separator << decorators.whitespace;
+        return pooled_;
     }
 
-    /**
-     * @brief inserts suffix decorator in stream
-     */
-    static void print_suffix(StreamType& ostream) noexcept
+    emission_buffer<CharType, TraitsType>& buffer() noexcept
     {
-        ostream << decorators.suffix;
+        return buffer_;
     }
+
+private:
+    emission_buffer<CharType, TraitsType>& buffer_;
+    bool pooled_;
 };
 
 /**
- * @brief helper to to_stream(tuple), recursive struct meant to unpack and
- *   parse std::tuple elements
- * @notes overloads as follows:
- *   - default
- *   - last element in tuple
+ * @brief helper to to_stream_committed, emits with the pooled buffer of this
+ *   thread, or if that is in use, with a new one
  */
-template <typename TupleType, std::size_t Index, std::size_t Last>
-struct tuple_handler
+template <typename ContainerType, typename StreamType, typename FormatterType,
+          typename MutexType>
+static StreamType& emit_committed(
+    StreamType& ostream, const ContainerType& container,
+    const FormatterType& formatter, MutexType& mutex)
 {
-    template <typename StreamType, typename FormatterType>
-    static void print(
-        StreamType& ostream, const TupleType& tuple, const FormatterType& formatter)
-    {
-        formatter.print_element(ostream, std::get<Index>(tuple));
-        formatter.print_separator(ostream);
-        tuple_handler<TupleType, Index + 1, Last>::print(ostream, tuple, formatter);
-    }
-};
+    using char_type = typename StreamType::char_type;
+    using traits_type = typename StreamType::traits_type;
 
-template <typename TupleType, std::size_t Index>
-struct tuple_handler<TupleType, Index, Index>
-{
-    template <typename StreamType, typename FormatterType>
-    static void print(
-        StreamType& ostream, const TupleType& tuple, const FormatterType& formatter) noexcept
+    emission_lease<char_type, traits_type> lease;
+    if (lease.pooled())
     {
-        formatter.print_element(ostream, std::get<Index>(tuple));
+        emit(ostream, container, formatter, mutex, lease.buffer());
+        return ostream;
     }
-};
+    emission_buffer<char_type, traits_type> buffer;
+    emit(ostream, container, formatter, mutex, buffer);
+    return ostream;
+}
+
+}  // namespace detail
 
 /**
- * @brief stream insertion of compatible container type
- * @notes overloads as follows:
- *   - std::tuple<T...>
- *   - std::tuple<>
- *   - std::pair
- *   - default: intended for "iterable" STL containers (see
- *       traits::is_printable_as_container)
+ * @brief stream insertion of compatible container type as a single write,
+ *   eg for many threads printing to the same std::cout or log file
+ * @notes
+ *   - the whole serialization is first formatted through formatter into a
+ *       buffer pooled per thread (with the format state of ostream, see
+ *       std::basic_ios::copyfmt), so output of concurrent writers is not
+ *       interleaved within a container, and ostream sees one write rather
+ *       than many small insertions
+ *   - pooled buffers keep their storage between calls, so once grown to fit
+ *       the serializations of a thread no further allocation is needed for
+ *       them
+ *   - formatter must accept a basic_ostream of the same char type as ostream
+ *       (eg by taking basic_ostream&); default_formatter is rebound to it
+ *   - overloads as follows:
+ *     - default: writes serialized by the destination alone, eg when ostream
+ *         is a std::basic_osyncstream, or only one thread writes at a time
+ *     - mutex: write (or on failure, setting of stream state) made under a
+ *         std::lock_guard of mutex, which is not held during formatting
+ *   - if formatting fails, its stream state is set on ostream and nothing is
+ *       written
  */
-template <typename StreamType, typename FormatterType, typename... TupleArgs>
-static StreamType& to_stream(
-    StreamType& ostream, const std::tuple<TupleArgs...>& tuple,
-    const FormatterType& formatter)
+template <typename ContainerType, typename StreamType,
+          typename FormatterType = default_formatter<ContainerType, StreamType>>
+static StreamType& to_stream_committed(
+    StreamType& ostream, const ContainerType& container,
+    const FormatterType& formatter = FormatterType{})
 {
-    using TupleType = std::decay_t<decltype(tuple)>;
-
-    formatter.print_prefix(ostream);
-    container_stream_io::output::tuple_handler<
-        TupleType, 0, sizeof...(TupleArgs) - 1>::print(ostream, tuple, formatter);
-    formatter.print_suffix(ostream);
-
-    return ostream;
+    detail::unlocked mutex;
+    return detail::emit_committed(ostream, container, formatter, mutex);
 }
 
-template <typename StreamType, typename FormatterType, typename... TupleArgs>
-static StreamType& to_stream(
-    StreamType& ostream, const std::tuple<>& /*tuple*/,
-    const FormatterType& formatter)
+template <typename ContainerType, typename StreamType, typename FormatterType,
+          typename MutexType>
+static StreamType& to_stream_committed(
+    StreamType& ostream, const ContainerType& container,
+    const FormatterType& formatter, MutexType& mutex)
 {
-    formatter.print_prefix(ostream);
-    formatter.print_suffix(ostream);
-    return ostream;
+    return detail::emit_committed(ostream, container, formatter, mutex);
 }
 
-template <typename FirstType, typename SecondType, typename StreamType, typename FormatterType>
-static StreamType& to_stream(
-    StreamType& ostream, const std::pair<FirstType, SecondType>& container,
-    const FormatterType& formatter)
+/**
+ * @brief insertion of compatible container type into a file, which is
+ *   created or truncated
+ * @notes
+ *   - written through a std::ofstream with a large buffer, so that the output
+ *       blocks of to_stream are passed to the OS in few writes
+ *   - formatter writes to a std::ostream; to set format state (eg
+ *       strings::quotedrepr), stream to a std::ofstream directly
+ * @return true if the file was opened and the whole serialization written
+ */
+template <typename ContainerType,
+          typename FormatterType = default_formatter<ContainerType, std::ostream>>
+static bool to_file(
+    const std::string& path, const ContainerType& container,
+    const FormatterType& formatter = FormatterType{})
 {
-    formatter.print_prefix(ostream);
-    formatter.print_element(ostream, container.first);
-    formatter.print_separator(ostream);
-    formatter.print_element(ostream, container.second);
-    formatter.print_suffix(ostream);
-
-    return ostream;
+    static constexpr std::size_t file_buffer_size { 1 << 20 };
+
+    // outlives ofs, and set before open as required by some implementations
+    std::unique_ptr<char[]> file_buffer { new char[file_buffer_size] };
+    std::ofstream ofs;
+    ofs.rdbuf()->pubsetbuf(file_buffer.get(), file_buffer_size);
+    ofs.open(path, std::ios_base::out | std::ios_base::trunc |
+             std::ios_base::binary);
+    if (!ofs.is_open())
+        return false;
+    to_stream(static_cast<std::ostream&>(ofs), container, formatter);
+    ofs.close();
+    return !ofs.fail();
 }
 
-template <typename ContainerType, typename StreamType, typename FormatterType>
-static StreamType& to_stream(
-    StreamType& ostream, const ContainerType& container,
-    const FormatterType& formatter)
+/**
+ * @brief length in chars of the serialization of compatible container type,
+ *   as printed with formatter, measured through a buffers::span_ostreambuf
+ *   that stores nothing
+ * @notes
+ *   - container is formatted exactly as by to_stream (decorators, escapes
+ *       and numbers alike), with only the writes to the streambuf skipped
+ *   - formatter writes to a std::ostream; to set format state (eg
+ *       strings::quotedrepr), construct it with a format_state
+ * @return 0 if printing fails
+ */
+template <typename ContainerType,
+          typename FormatterType = default_formatter<ContainerType, std::ostream>>
+static std::size_t serialized_size(
+    const ContainerType& container,
+    const FormatterType& formatter = FormatterType{})
 {
-    formatter.print_prefix(ostream);
-
-    if (container_stream_io::traits::is_empty(container)) {
-        formatter.print_suffix(ostream);
+    buffers::span_ostreambuf<char> buf;
+    std::ostream ostream { &buf };
+    to_stream(ostream, container, formatter);
+    return ostream.fail() ? 0 : buf.size();
+}
 
-        return ostream;
-    }
+/**
+ * @brief insertion of compatible container type into a caller-owned buffer
+ *   of size chars at data, without allocating
+ * @notes as with std::snprintf, a serialization longer than size is cut off,
+ *   and its full length is still returned, eg to size a new buffer with
+ * @return length of the serialization, or 0 if printing fails
+ */
+template <typename ContainerType,
+          typename FormatterType = default_formatter<ContainerType, std::ostream>>
+static std::size_t to_buffer(
+    const ContainerType& container, char* const data, const std::size_t size,
+    const FormatterType& formatter = FormatterType{})
+{
+    buffers::span_ostreambuf<char> buf { data, data + size };
+    std::ostream ostream { &buf };
+    to_stream(ostream, container, formatter);
+    return ostream.fail() ? 0 : buf.size();
+}
 
-    auto begin = std::begin(container);
-    formatter.print_element(ostream, *begin);
+/**
+ * @brief insertion of compatible container type into a new std::string
+ * @notes the container is formatted once, into a buffers::string_ostreambuf
+ *   whose string is then moved out, so that it grows as a std::string would
+ *   under appends, with no second pass and no copy
+ * @return serialization, or an empty string if printing fails
+ */
+template <typename ContainerType,
+          typename FormatterType = default_formatter<ContainerType, std::ostream>>
+static std::string to_string(
+    const ContainerType& container,
+    const FormatterType& formatter = FormatterType{})
+{
+    buffers::string_ostreambuf<char> buf;
+    std::ostream ostream { &buf };
+    to_stream(ostream, container, formatter);
+    return ostream.fail() ? std::string {} : buf.release();
+}
 
-    std::advance(begin, 1);
+}  // namespace output
 
-    std::for_each(begin, std::end(container),
-#ifdef __cpp_generic_lambdas
-                  [&ostream, &formatter](const auto& element) {
-#else
-                  [&ostream, &formatter](const decltype(*begin)& element) {
-#endif
-        formatter.print_separator(ostream);
-        formatter.print_element(ostream, element);
-    });
+namespace traits {
 
-    formatter.print_suffix(ostream);
+/**
+ * @brief output::range wrappers are printed as containers, though they
+ *   provide neither iterator types nor empty()
+ */
+template <typename IteratorType, typename SentinelType>
+struct is_printable_as_container<
+    output::iterator_range<IteratorType, SentinelType>> : public std::true_type
+{};
 
-    return ostream;
-}
+#ifdef CONTAINER_STREAM_IO_RANGES
+template <typename RangeType>
+struct is_printable_as_container<output::range_holder<RangeType>>
+    : public std::true_type
+{};
 
-}  // namespace output
+#endif  // CONTAINER_STREAM_IO_RANGES
+}  // namespace traits
 
 }  // namespace container_stream_io
 
 /**
  * @brief istream operator overload for compatible containers
+ * @notes parses binary if set with binary::binaryrepr
  */
 template <typename ContainerType, typename StreamType>
 auto operator>>(StreamType& istream, ContainerType& container
@@ -2091,15 +10177,14 @@ auto operator>>(StreamType& istream, ContainerType& container
     container_stream_io::traits::is_parseable_as_container<ContainerType>::value,
     StreamType&>
 {
-    using formatter_type =
-        container_stream_io::input::default_formatter<ContainerType, StreamType>;
-    container_stream_io::input::from_stream(istream, container, formatter_type{});
+    container_stream_io::input::from_stream_selected(istream, container);
 
     return istream;
 }
 
 /**
  * @brief ostream operator overload for compatible containers
+ * @notes prints binary if set with binary::binaryrepr
  */
 template <typename ContainerType, typename StreamType>
 auto operator<<(StreamType& ostream, const ContainerType& container
@@ -2107,9 +10192,13 @@ auto operator<<(StreamType& ostream, const ContainerType& container
     container_stream_io::traits::is_printable_as_container<ContainerType>::value,
     StreamType&>
 {
-    using formatter_type =
-        container_stream_io::output::default_formatter<ContainerType, StreamType>;
-    container_stream_io::output::to_stream(ostream, container, formatter_type{});
+    container_stream_io::output::to_stream_selected(ostream, container);
 
     return ostream;
 }
+
+// extern declarations of common operator instantiations, compiled instead by
+//   target container_stream_io_precompiled
+#ifdef CONTAINER_STREAM_IO_PRECOMPILED
+#  include "container_stream_io_instantiations.hh"
+#endif  // CONTAINER_STREAM_IO_PRECOMPILED
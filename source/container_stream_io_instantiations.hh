@@ -0,0 +1,84 @@
+#pragma once
+
+/*
+ * @file explicit instantiations of the container stream operators for common
+ *   container and stream types, declared extern (and so not instantiated in
+ *   each translation unit) when included at the end of container_stream_io.hh
+ *   with CONTAINER_STREAM_IO_PRECOMPILED defined, and defined by
+ *   container_stream_io_precompiled.cpp (see target
+ *   container_stream_io_precompiled in CMakeLists.txt)
+ * @notes
+ *   - the operators instantiate all of to_stream/from_stream and string_repr
+ *       for the container, so only streaming through other functions (eg
+ *       output::to_string, input::from_file) is still instantiated per
+ *       translation unit
+ *   - the stream type must match exactly, eg `std::cout << v` and
+ *       `oss << v` (oss being a std::ostringstream) use two different
+ *       instantiations
+ *   - the library must be built with the same configuration macros (eg
+ *       CONTAINER_STREAM_IO_INSTRUMENTATION, CONTAINER_STREAM_IO_NO_SIMD) and
+ *       C++ standard as the translation units using it
+ */
+
+#include "container_stream_io.hh"
+
+#include <map>
+#include <unordered_map>
+
+// empty when defining the instantiations
+#ifndef CONTAINER_STREAM_IO_EXTERN
+#  define CONTAINER_STREAM_IO_EXTERN extern
+#endif  // CONTAINER_STREAM_IO_EXTERN
+
+namespace container_stream_io {
+
+/**
+ * @brief aliases of instantiated types, as template arguments containing
+ *   commas can't be passed to the instantiation macros
+ */
+namespace precompiled {
+
+using map_string_int = std::map<std::string, int>;
+using map_string_string = std::map<std::string, std::string>;
+using map_string_vector_int = std::map<std::string, std::vector<int>>;
+using unordered_map_string_int = std::unordered_map<std::string, int>;
+using map_wstring_int = std::map<std::wstring, int>;
+
+}  // namespace precompiled
+
+}  // namespace container_stream_io
+
+#define CONTAINER_STREAM_IO_INSTANTIATE_OUTPUT(STREAM_T, CONTAINER_T) \
+    CONTAINER_STREAM_IO_EXTERN template STREAM_T& \
+    operator<< <CONTAINER_T, STREAM_T>(STREAM_T&, const CONTAINER_T&);
+
+#define CONTAINER_STREAM_IO_INSTANTIATE_INPUT(STREAM_T, CONTAINER_T) \
+    CONTAINER_STREAM_IO_EXTERN template STREAM_T& \
+    operator>> <CONTAINER_T, STREAM_T>(STREAM_T&, CONTAINER_T&);
+
+// both operators, with both the base streams (eg std::cout, or a parameter of
+//   type std::ostream&) and the string streams
+#define CONTAINER_STREAM_IO_INSTANTIATE(CHAR_PREFIX, CONTAINER_T) \
+    CONTAINER_STREAM_IO_INSTANTIATE_OUTPUT(std::CHAR_PREFIX##ostream, CONTAINER_T) \
+    CONTAINER_STREAM_IO_INSTANTIATE_OUTPUT(std::CHAR_PREFIX##ostringstream, CONTAINER_T) \
+    CONTAINER_STREAM_IO_INSTANTIATE_INPUT(std::CHAR_PREFIX##istream, CONTAINER_T) \
+    CONTAINER_STREAM_IO_INSTANTIATE_INPUT(std::CHAR_PREFIX##istringstream, CONTAINER_T)
+
+CONTAINER_STREAM_IO_INSTANTIATE(, std::vector<int>)
+CONTAINER_STREAM_IO_INSTANTIATE(, std::vector<double>)
+CONTAINER_STREAM_IO_INSTANTIATE(, std::vector<std::string>)
+CONTAINER_STREAM_IO_INSTANTIATE(, std::set<int>)
+CONTAINER_STREAM_IO_INSTANTIATE(, std::set<std::string>)
+CONTAINER_STREAM_IO_INSTANTIATE(, container_stream_io::precompiled::map_string_int)
+CONTAINER_STREAM_IO_INSTANTIATE(, container_stream_io::precompiled::map_string_string)
+CONTAINER_STREAM_IO_INSTANTIATE(, container_stream_io::precompiled::map_string_vector_int)
+CONTAINER_STREAM_IO_INSTANTIATE(, container_stream_io::precompiled::unordered_map_string_int)
+
+CONTAINER_STREAM_IO_INSTANTIATE(w, std::vector<int>)
+CONTAINER_STREAM_IO_INSTANTIATE(w, std::vector<std::wstring>)
+CONTAINER_STREAM_IO_INSTANTIATE(w, container_stream_io::precompiled::map_wstring_int)
+
+#undef CONTAINER_STREAM_IO_INSTANTIATE
+#undef CONTAINER_STREAM_IO_INSTANTIATE_INPUT
+#undef CONTAINER_STREAM_IO_INSTANTIATE_OUTPUT
+#undef CONTAINER_STREAM_IO_EXTERN
@@ -0,0 +1,8 @@
+/*
+ * @file explicit instantiation definitions of the container stream operators
+ *   declared extern in container_stream_io_instantiations.hh, compiled into
+ *   target container_stream_io_precompiled
+ */
+
+#define CONTAINER_STREAM_IO_EXTERN
+#include "container_stream_io_instantiations.hh"
@@ -47,6 +47,13 @@
 #include <stack>
 #include <queue>
 #include <sstream>
+#include <iomanip>
+#include <fstream>
+#include <cstdio>       // remove
+#include <cmath>        // signbit
+#include <iterator>     // istream_iterator
+#include <thread>
+#include <mutex>
 
 namespace
 {
@@ -167,6 +174,21 @@ TEST_CASE("Traits: detect non-string types",
     REQUIRE(traits::is_string_type<std::vector<int>>::value == false);
 }
 
+/**
+ * @brief minimal allocator, distinct from std::allocator
+ */
+template <typename Type>
+struct std_allocator_wrapper : public std::allocator<Type>
+{
+    template <typename OtherType>
+    struct rebind { using other = std_allocator_wrapper<OtherType>; };
+
+    std_allocator_wrapper() = default;
+
+    template <typename OtherType>
+    std_allocator_wrapper(const std_allocator_wrapper<OtherType>&) noexcept {}
+};
+
 TEST_CASE("Traits: detect string types",
           "[traits][strings]")
 {
@@ -191,6 +213,9 @@ TEST_CASE("Traits: detect string types",
     {
         REQUIRE(traits::is_stl_string_type<std::basic_string<char>>::value == true);
         REQUIRE(traits::is_stl_string_type<const std::basic_string<char>>::value == false);
+        REQUIRE(traits::is_stl_string_type<
+                std::basic_string<char, std::char_traits<char>,
+                                  std_allocator_wrapper<char>>>::value == true);
 #if __cplusplus >= 201703L
         REQUIRE(traits::is_stl_string_type<std::basic_string_view<char>>::value == true);
         REQUIRE(traits::is_stl_string_type<const std::basic_string_view<char>>::value == false);
@@ -254,6 +279,13 @@ TEST_CASE("Traits: detect as parseable (input stream extractable)",
             REQUIRE(traits::is_parseable_as_container<std::unordered_multiset<int>>::value == true);
         }
 
+        SECTION("STL container adaptors")
+        {
+            REQUIRE(traits::is_parseable_as_container<std::stack<int>>::value == true);
+            REQUIRE(traits::is_parseable_as_container<std::queue<int>>::value == true);
+            REQUIRE(traits::is_parseable_as_container<std::priority_queue<int>>::value == true);
+        }
+
         SECTION("custom iterable container class",
                 "(iterable being defiend as having members (typename)iterator, "
                 "begin(), end(), and empty())")
@@ -311,11 +343,9 @@ TEST_CASE("Traits: detect as not parseable (input stream extractable)",
 #endif
     }
 
-    SECTION("STL containers that are not iterable")
+    SECTION("STL container adaptors of incompatible containers")
     {
-        REQUIRE(traits::is_parseable_as_container<std::stack<int>>::value == false);
-        REQUIRE(traits::is_parseable_as_container<std::queue<int>>::value == false);
-        REQUIRE(traits::is_parseable_as_container<std::priority_queue<int>>::value == false);
+        REQUIRE(traits::is_parseable_as_container<std::stack<char, std::string>>::value == false);
     }
 
     SECTION("custom non-iterable container class",
@@ -351,6 +381,13 @@ TEST_CASE("Traits: detect as printable (output stream insertable)",
             REQUIRE(traits::is_printable_as_container<std::unordered_multiset<int>>::value == true);
         }
 
+        SECTION("STL container adaptors")
+        {
+            REQUIRE(traits::is_printable_as_container<std::stack<int>>::value == true);
+            REQUIRE(traits::is_printable_as_container<std::queue<int>>::value == true);
+            REQUIRE(traits::is_printable_as_container<std::priority_queue<int>>::value == true);
+        }
+
         SECTION("custom iterable container class",
                 "(iterable being defiend as having members (typename)iterator, "
                 "begin(), end(), and empty())")
@@ -407,11 +444,9 @@ TEST_CASE("Traits: detect as not printable (output stream insertable)",
 #endif
     }
 
-    SECTION("STL containers that are not iterable")
+    SECTION("STL container adaptors of incompatible containers")
     {
-        REQUIRE(traits::is_printable_as_container<std::stack<int>>::value == false);
-        REQUIRE(traits::is_printable_as_container<std::queue<int>>::value == false);
-        REQUIRE(traits::is_printable_as_container<std::priority_queue<int>>::value == false);
+        REQUIRE(traits::is_printable_as_container<std::stack<char, std::string>>::value == false);
     }
 
     SECTION("custom non-iterable container class",
@@ -422,6 +457,103 @@ TEST_CASE("Traits: detect as not printable (output stream insertable)",
     }
 }
 
+TEST_CASE("Strings: ASCII classification tables used in literal encoding",
+          "[strings]")
+{
+    using namespace strings::detail;
+
+    SECTION("are usable at compile time")
+    {
+        static_assert(is_printable_ascii('a') && !is_printable_ascii('\t'),
+                      "printable classification");
+        static_assert(standard_escape_symbol_of('\n') == 'n',
+                      "escape symbol classification");
+        static_assert(hex_digit_value_of(U'F') == 15, "hex digit classification");
+        REQUIRE(ascii_table::values['0'].escape_value == '\0');
+    }
+
+    SECTION("treat values outside 7-bit ASCII range as unprintable, regardless "
+            "of char type signedness")
+    {
+        REQUIRE(!is_printable_ascii('\xe1'));
+        REQUIRE(!is_printable_ascii(L'\x161'));
+        REQUIRE(!is_printable_ascii(char32_t(0x10061)));
+        REQUIRE(standard_escape_symbol_of(char16_t(0x10a)) == '\0');
+        REQUIRE(standard_escape_value_of(char32_t(0x16e)) == -1);
+        REQUIRE(hex_digit_value_of(wchar_t(0x131)) == -1);
+    }
+}
+
+template <typename CharType>
+static const CharType* naive_find_escape(
+    const CharType* first, const CharType* last,
+    const CharType delim, const CharType escape, const bool literal)
+{
+    for (; first != last; ++first)
+    {
+        if (*first == delim || *first == escape ||
+            (literal && !strings::detail::is_printable_ascii(*first)))
+            break;
+    }
+    return first;
+}
+
+template <typename CharType>
+static void check_find_escape(const CharType special)
+{
+    using namespace strings::detail;
+    const CharType delim { '\'' }, escape { '\\' };
+    // longer than two AVX2 vectors of chars, to cover vector and scalar paths
+    for (std::size_t length { 0 }; length < 72; ++length)
+    {
+        const std::basic_string<CharType> clean (length, CharType('a'));
+        REQUIRE(find_quoted_escape(clean.data(), clean.data() + length,
+                                   delim, escape) == clean.data() + length);
+        REQUIRE(find_literal_escape(clean.data(), clean.data() + length,
+                                    delim, escape) == clean.data() + length);
+        for (std::size_t offset { 0 }; offset < length; ++offset)
+        {
+            std::basic_string<CharType> str (clean);
+            str[offset] = special;
+            const CharType* first { str.data() };
+            const CharType* last { str.data() + length };
+            REQUIRE(find_quoted_escape(first, last, delim, escape) ==
+                    naive_find_escape(first, last, delim, escape, false));
+            REQUIRE(find_literal_escape(first, last, delim, escape) ==
+                    naive_find_escape(first, last, delim, escape, true));
+        }
+    }
+}
+
+TEST_CASE("Strings: vectorized scanning for chars needing escape",
+          "[strings]")
+{
+    SECTION("matches scalar scanning at all offsets, for all char types")
+    {
+        for (const char c : { '\'', '\\', '\n', '\x7f', '\x80', '\xff', ' ', '~' })
+            check_find_escape<char>(c);
+        for (const wchar_t c : { L'\\', L'\t', wchar_t(0x161), wchar_t(0xff61) })
+            check_find_escape<wchar_t>(c);
+        for (const char16_t c : { u'\'', u'\x1f', char16_t(0x7fff), char16_t(0x8000) })
+            check_find_escape<char16_t>(c);
+        for (const char32_t c : { U'\\', U'\0', char32_t(0x10061), char32_t(0x80000027) })
+            check_find_escape<char32_t>(c);
+    }
+
+    SECTION("leaves encoding of long strings unchanged")
+    {
+        const std::string str (std::string(40, 'x') + "\"\\\t" +
+                               std::string(40, 'y') + '\x01');
+        std::ostringstream oss;
+        oss << strings::quoted(str) << ' ' << strings::literal(str);
+        REQUIRE(oss.str() ==
+                '"' + std::string(40, 'x') + "\\\"\\\\\t" +
+                std::string(40, 'y') + "\x01\" " +
+                '"' + std::string(40, 'x') + "\\\"\\\\\\t" +
+                std::string(40, 'y') + "\\x01\"");
+    }
+}
+
 TEST_CASE("strings::literal() printing/output streaming escaped literals",
           "[literal][strings][output]")
 {
@@ -1318,6 +1450,41 @@ TEST_CASE("strings::quoted() parsing/input streaming quoted strings",
     }
 }
 
+TEST_CASE("strings::literal()/quoted() encode directly to the stream",
+          "[literal][quoted][strings][output]")
+{
+    std::ostringstream oss;
+
+    SECTION("copying unescaped runs between escapes intact")
+    {
+        const std::string s { std::string(100, 'a') + "\t\"" + std::string(100, 'b') };
+        oss << strings::literal(s);
+        REQUIRE(oss.str() ==
+                "\"" + std::string(100, 'a') + "\\t\\\"" + std::string(100, 'b') + "\"");
+    }
+
+    SECTION("converting runs when stream and string char types differ")
+    {
+        std::wostringstream woss;
+        woss << strings::quoted(std::string { "te\"st" });
+        REQUIRE(woss.str() == L"\"te\\\"st\"");
+    }
+
+    SECTION("without changing stream formatting flags")
+    {
+        oss << strings::literal("\x01") << 10;
+        REQUIRE(oss.str() == "\"\\x01\"10");
+    }
+
+    SECTION("respecting field width as a whole, as with std::quoted")
+    {
+        oss << std::setw(10) << strings::quoted("te\"st");
+        REQUIRE(oss.str() == "  \"te\\\"st\"");
+        oss << strings::quoted("a");
+        REQUIRE(oss.str() == "  \"te\\\"st\"\"a\"");
+    }
+}
+
 TEST_CASE("Strings: printing/output streaming string types inside compatible "
           "containers uses strings::literal()/quoted()"
           "[literal][quoted][strings][output]")
@@ -1482,6 +1649,94 @@ TEST_CASE("Strings: parsing/input streaming string types inside compatible "
     }
 }
 
+TEST_CASE("Strings: streaming string types inside compatible containers "
+          "with strings::utf8repr", "[strings][input][output]")
+{
+    SECTION("wide strings are transcoded, escaping only ASCII as literal")
+    {
+        const std::vector<std::u32string> vu32s { U"\u00e9t\u00e9\t\U0001f600\"" };
+        const std::vector<std::u16string> vu16s { u"\u6f22\U0001f600" };
+        const std::vector<std::wstring> vws { L"\u00e9" };
+        std::ostringstream oss;
+        oss << strings::utf8repr << vu32s << vu16s << vws;
+        REQUIRE(oss.str() ==
+                "[U\"\xc3\xa9t\xc3\xa9\\t\xf0\x9f\x98\x80\\\"\"]"
+                "[u\"\xe6\xbc\xa2\xf0\x9f\x98\x80\"]"
+                "[L\"\xc3\xa9\"]");
+
+        std::istringstream iss { oss.str() };
+        std::vector<std::u32string> parsed_vu32s;
+        std::vector<std::u16string> parsed_vu16s;
+        std::vector<std::wstring> parsed_vws;
+        iss >> strings::utf8repr >> parsed_vu32s >> parsed_vu16s >> parsed_vws;
+        REQUIRE(!iss.fail());
+        REQUIRE(parsed_vu32s == vu32s);
+        REQUIRE(parsed_vu16s == vu16s);
+        REQUIRE(parsed_vws == vws);
+    }
+
+    SECTION("invalid code points are hex escaped")
+    {
+        const std::vector<std::u16string> vu16s { std::u16string(1, char16_t(0xd800)) };
+        const std::vector<std::u32string> vu32s { std::u32string(1, char32_t(0x110000)) };
+        std::ostringstream oss;
+        oss << strings::utf8repr << vu16s << vu32s;
+        REQUIRE(oss.str() == "[u\"\\xd800\"][U\"\\x00110000\"]");
+
+        std::istringstream iss { oss.str() };
+        std::vector<std::u16string> parsed_vu16s;
+        std::vector<std::u32string> parsed_vu32s;
+        iss >> strings::utf8repr >> parsed_vu16s >> parsed_vu32s;
+        REQUIRE(!iss.fail());
+        REQUIRE(parsed_vu16s == vu16s);
+        REQUIRE(parsed_vu32s == vu32s);
+    }
+
+    SECTION("single byte strings keep their non-ASCII bytes")
+    {
+        const std::vector<std::string> vs { "caf\xc3\xa9\n" };
+        std::ostringstream oss;
+        oss << strings::utf8repr << vs;
+        REQUIRE(oss.str() == "[\"caf\xc3\xa9\\n\"]");
+        std::istringstream iss { oss.str() };
+        std::vector<std::string> parsed;
+        iss >> strings::utf8repr >> parsed;
+        REQUIRE(!iss.fail());
+        REQUIRE(parsed == vs);
+    }
+
+    SECTION("invalid UTF-8 fails to parse")
+    {
+        for (const char* input : { "[U\"\xc0\xaf\"]",          // overlong
+                                   "[U\"\xed\xa0\x80\"]",      // surrogate
+                                   "[U\"\xf4\x90\x80\x80\"]",  // past U+10FFFF
+                                   "[U\"\xe6\xbc\"]",          // truncated
+                                   "[U\"\x80\"]" })            // continuation
+        {
+            std::istringstream iss { input };
+            std::vector<std::u32string> parsed;
+            iss >> strings::utf8repr >> parsed;
+            REQUIRE(iss.fail());
+        }
+    }
+
+    SECTION("literalrepr still hex escapes non-ASCII chars")
+    {
+        const std::vector<std::u32string> vu32s { U"\u00e9" };
+        std::ostringstream oss;
+        oss << strings::utf8repr << strings::literalrepr << vu32s;
+        REQUIRE(oss.str() == "[U\"\\x000000e9\"]");
+    }
+
+    SECTION("same as literalrepr on streams of wider chars")
+    {
+        const std::vector<std::u32string> vu32s { U"\u00e9" };
+        std::wostringstream woss;
+        woss << strings::utf8repr << vu32s;
+        REQUIRE(woss.str() == L"[U\"\\x000000e9\"]");
+    }
+}
+
 TEST_CASE("Delimiters: validate char defaults for", "[decorator]")
 {
     SECTION("non-specialized container type")
@@ -1734,6 +1989,61 @@ TEST_CASE("Delimiters: validate char32_t defaults for", "[decorator]")
     }
 }
 
+struct custom_delimited_vector : public std::vector<int>
+{};
+
+namespace container_stream_io {
+
+namespace decorator {
+
+template <>
+struct delimiters<custom_delimited_vector, char>
+{
+    static constexpr delim_wrapper<char> values { "{{", ";", "  ", "}}" };
+};
+
+}  // namespace decorator
+
+}  // namespace container_stream_io
+
+TEST_CASE("Delimiters: token lengths measured at compile time", "[decorator]")
+{
+    SECTION("for default delimiters")
+    {
+        using tokens = decorator::tokens<std::map<int, int>, char16_t>;
+        static_assert(tokens::prefix_length == 1, "");
+        static_assert(tokens::spaced_separator_length == 2, "");
+        static_assert(tokens::marker_length == 1, "");
+        static_assert(tokens::spaced_terminator_length == 2, "");
+        REQUIRE(idiomatic_strcmp(tokens::spaced_separator(), u", "));
+        REQUIRE(idiomatic_strcmp(tokens::spaced_terminator(), u": "));
+        REQUIRE(decorator::token_length<char>(nullptr) == 0);
+    }
+
+    SECTION("for custom delimiters")
+    {
+        using tokens = decorator::tokens<custom_delimited_vector, char>;
+        static_assert(tokens::prefix_length == 2, "");
+        static_assert(tokens::spaced_separator_length == 3, "");
+        static_assert(tokens::suffix_length == 2, "");
+        REQUIRE(idiomatic_strcmp(tokens::spaced_separator(), ";  "));
+
+        custom_delimited_vector cdv;
+        cdv.assign({ 1, 2, 3 });
+        std::stringstream ss;
+        ss << decorator::counthint << cdv;
+        REQUIRE(ss.str() == "{{#3:  1;  2;  3}}");
+        custom_delimited_vector parsed;
+        ss >> decorator::counthint >> parsed;
+        REQUIRE(!ss.fail());
+        REQUIRE(parsed == cdv);
+
+        std::istringstream iss { "{{1; 2}" };
+        iss >> parsed;
+        REQUIRE(iss.fail());
+    }
+}
+
 TEST_CASE("Printing/output streaming non-nested container types",
           "[output]")
 {
@@ -2653,6 +2963,91 @@ TEST_CASE("Supported container types should not change after being encoded and "
     }
 }
 
+TEST_CASE("Streaming STL container adaptors as their underlying containers",
+          "[input][output]")
+{
+    SECTION("std::stack, bottom to top")
+    {
+        std::stack<int> si;
+        for (int i { 1 }; i <= 3; ++i)
+            si.push(i);
+        std::ostringstream oss;
+        oss << si;
+        REQUIRE(oss.str() == "[1, 2, 3]");
+        std::istringstream iss { oss.str() };
+        std::stack<int> parsed;
+        iss >> parsed;
+        REQUIRE(!iss.fail());
+        REQUIRE(parsed == si);
+        REQUIRE(parsed.top() == 3);
+    }
+
+    SECTION("std::queue, front to back")
+    {
+        std::queue<std::string, std::list<std::string>> qs;
+        qs.push("a");
+        qs.push("b");
+        std::ostringstream oss;
+        oss << qs;
+        REQUIRE(oss.str() == "[\"a\", \"b\"]");
+        std::istringstream iss { oss.str() };
+        std::queue<std::string, std::list<std::string>> parsed;
+        iss >> parsed;
+        REQUIRE(!iss.fail());
+        REQUIRE(parsed == qs);
+        REQUIRE(parsed.front() == "a");
+    }
+
+    SECTION("std::priority_queue, restoring heap order")
+    {
+        std::istringstream iss { "[1, 5, 3, 4] [2, 1, 3]" };
+        std::priority_queue<int> pqi;
+        iss >> pqi;
+        REQUIRE(!iss.fail());
+        std::vector<int> popped;
+        for (; !pqi.empty(); pqi.pop())
+            popped.push_back(pqi.top());
+        REQUIRE(popped == std::vector<int> { 5, 4, 3, 1 });
+
+        std::priority_queue<int, std::vector<int>, std::greater<int>> min_pqi;
+        iss >> min_pqi;
+        REQUIRE(!iss.fail());
+        REQUIRE(min_pqi.top() == 1);
+        std::ostringstream oss;
+        oss << min_pqi;
+        std::istringstream reparse { oss.str() };
+        std::priority_queue<int, std::vector<int>, std::greater<int>> reparsed;
+        reparse >> reparsed;
+        REQUIRE(!reparse.fail());
+        REQUIRE(reparsed.size() == 3);
+        REQUIRE(reparsed.top() == 1);
+    }
+
+    SECTION("nested, and left unmodified on failure")
+    {
+        std::vector<std::stack<int>> vsi (2);
+        vsi[0].push(1);
+        vsi[1].push(2);
+        vsi[1].push(3);
+        std::ostringstream oss;
+        oss << vsi;
+        REQUIRE(oss.str() == "[[1], [2, 3]]");
+        std::istringstream iss { oss.str() };
+        std::vector<std::stack<int>> parsed;
+        iss >> parsed;
+        REQUIRE(!iss.fail());
+        REQUIRE(parsed == vsi);
+
+        std::istringstream bad { "[4, x]" };
+        std::stack<int> si;
+        si.push(0);
+        bad >> si;
+        REQUIRE(bad.fail());
+        REQUIRE(si.size() == 1);
+        REQUIRE(si.top() == 0);
+    }
+}
+
 TEST_CASE("Printing with custom formatter",
           "[output]")
 {
@@ -2686,6 +3081,2498 @@ TEST_CASE("Printing with custom formatter",
     }
 }
 
+/**
+ * @brief single pass iterator producing the ints from 0, until reaching the
+ *   end of a count_sentinel
+ */
+struct counting_iterator
+{
+    using iterator_category = std::input_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int*;
+    using reference = const int&;
+
+    int value;
+
+    const int& operator*() const { return value; }
+    counting_iterator& operator++() { ++value; return *this; }
+};
+
+struct count_sentinel
+{
+    int end;
+};
+
+inline bool operator!=(const counting_iterator& it, const count_sentinel& s)
+{
+    return it.value != s.end;
+}
+
+TEST_CASE("Printing with output::range",
+          "[output]")
+{
+    const std::list<int> li { 1, 2, 3 };
+
+    SECTION("iterator pairs print as containers")
+    {
+        std::ostringstream oss;
+        oss << output::range(li.begin(), li.end()) << ' '
+            << output::range(li.end(), li.end());
+        REQUIRE(oss.str() == "[1, 2, 3] []");
+    }
+
+    SECTION("with single pass iterators and sentinels, printed as produced")
+    {
+        std::istringstream iss { "1 2 3" };
+        std::ostringstream oss;
+        oss << output::range(std::istream_iterator<int>(iss),
+                             std::istream_iterator<int>());
+        REQUIRE(oss.str() == "[1, 2, 3]");
+
+        const count_sentinel last { 100000 };
+        std::vector<int> vi (static_cast<std::size_t>(last.end));
+        for (std::size_t i {}; i < vi.size(); ++i)
+            vi[i] = static_cast<int>(i);
+        std::ostringstream expected;
+        expected << vi;
+        std::ostringstream produced;
+        produced << output::range(counting_iterator { 0 }, last);
+        REQUIRE(produced.str() == expected.str());
+    }
+
+    SECTION("with count hints only if counting does not consume the range")
+    {
+        std::istringstream iss { "1 2" };
+        std::ostringstream oss;
+        oss << decorator::counthint << output::range(li.begin(), li.end())
+            << output::range(std::istream_iterator<int>(iss),
+                             std::istream_iterator<int>());
+        REQUIRE(oss.str() == "[#3: 1, 2, 3][1, 2]");
+    }
+
+    SECTION("with output::to_stream and a given formatter")
+    {
+        std::ostringstream oss;
+        output::to_stream(oss, counting_iterator { 1 }, count_sentinel { 4 },
+                          output::default_formatter<std::set<int>, std::ostream>{});
+        REQUIRE(oss.str() == "{1, 2, 3}");
+    }
+
+    SECTION("in binary, only if counted")
+    {
+        std::stringstream ss;
+        ss << binary::binaryrepr << output::range(li.begin(), li.end());
+        REQUIRE(!ss.fail());
+        std::vector<int> vi;
+        ss >> binary::binaryrepr >> vi;
+        REQUIRE(vi == std::vector<int> { 1, 2, 3 });
+
+        std::ostringstream oss;
+        oss << binary::binaryrepr
+            << output::range(counting_iterator { 0 }, count_sentinel { 2 });
+        REQUIRE(oss.fail());
+        REQUIRE(oss.str().empty());
+    }
+
+#ifdef CONTAINER_STREAM_IO_RANGES
+    SECTION("C++20 ranges and views")
+    {
+        const std::vector<int> vi { 1, 2, 3, 4, 5, 6 };
+        std::ostringstream oss;
+        oss << output::range(vi | std::views::filter([](int i) { return i % 2 == 0; }))
+            << output::range(std::views::iota(0) |
+                             std::views::take_while([](int i) { return i < 3; }))
+            << decorator::counthint << output::range(std::views::iota(1, 3));
+        REQUIRE(oss.str() == "[2, 4, 6][0, 1, 2][#2: 1, 2]");
+    }
+
+    SECTION("C++20 ranges and views passed as lvalues")
+    {
+        std::vector<int> vi { 1, 2, 3, 4 };
+        auto evens = vi | std::views::filter([](int i) { return i % 2 == 0; });
+        const std::list<int> li { 5, 6 };
+        std::ostringstream oss;
+        oss << output::range(evens) << output::range(li)
+            << decorator::counthint << output::range(vi);
+        REQUIRE(oss.str() == "[2, 4][5, 6][#4: 1, 2, 3, 4]");
+
+        // held by reference, so later changes are printed
+        std::list<int> growing { 1 };
+        const auto holder = output::range(growing);
+        growing.push_back(2);
+        oss.str("");
+        oss << decorator::nocounthint << holder;
+        REQUIRE(oss.str() == "[1, 2]");
+    }
+#endif
+}
+
+TEST_CASE("Printing through buffers::output_buffer",
+          "[output][buffers]")
+{
+    SECTION("is used by default_formatter when called directly with to_stream")
+    {
+        std::ostringstream oss;
+        const std::vector<int> v { 1, 2, 3, 4 };
+        output::to_stream(
+            oss, v, output::default_formatter<std::vector<int>, std::ostringstream>{});
+        REQUIRE(oss.str() == "[1, 2, 3, 4]");
+    }
+
+    SECTION("preserves order when mixing buffered and unbuffered insertions")
+    {
+        std::ostringstream oss;
+        const std::vector<std::pair<std::string, std::vector<double>>> vpsv {
+            { "a", { 1.5, 2.5 } }, { "b", {} } };
+        oss << vpsv;
+        REQUIRE(oss.str() == "[(\"a\", [1.5, 2.5]), (\"b\", [])]");
+    }
+
+    SECTION("flushes serializations larger than its capacity")
+    {
+        std::ostringstream oss;
+        std::ostringstream expected;
+        const std::vector<int> v (
+            buffers::output_buffer<char>::capacity * 2, 7 );
+        expected << '[';
+        for (std::size_t i {}; i < v.size(); ++i)
+            expected << (i == 0 ? "" : ", ") << v[i];
+        expected << ']';
+        oss << v;
+        REQUIRE(oss.str() == expected.str());
+    }
+
+    SECTION("writes nothing to a stream that is not good")
+    {
+        std::ostringstream oss;
+        oss.setstate(std::ios_base::failbit);
+        oss << std::vector<int> { 1, 2, 3 };
+        REQUIRE(oss.str().empty());
+    }
+
+    SECTION("sets badbit if streambuf cannot accept output")
+    {
+        std::stringbuf read_only { std::ios_base::in };
+        std::ostream os { &read_only };
+        buffers::output_buffer<char> buffer { os };
+        buffer << "[]";
+        buffer.flush();
+        REQUIRE(os.bad());
+    }
+
+    SECTION("is not used with custom formatters")
+    {
+        std::wostringstream woss;
+        const std::vector<std::vector<int>> vv { { 1, 2 }, { 3 } };
+        container_stream_io::output::to_stream(
+            woss, vv, custom_formatter{}) << std::flush;
+        REQUIRE(woss.str() == L"$$ [1, 2] | [3] $$");
+    }
+}
+
+/**
+ * @brief read-only streambuf over a string, refilling its get area with at
+ *   most chunk_size chars at a time
+ */
+class chunked_stringbuf : public std::streambuf
+{
+public:
+    chunked_stringbuf(const std::string& str, const std::size_t chunk_size) :
+        str_{str}, pos_{}, chunk_size_{chunk_size}
+    {}
+
+protected:
+    int_type underflow() override
+    {
+        if (gptr() != egptr())
+            return traits_type::to_int_type(*gptr());
+        if (pos_ == str_.size())
+            return traits_type::eof();
+        char* const first { &str_[pos_] };
+        const std::size_t n { std::min(chunk_size_, str_.size() - pos_) };
+        setg(first, first, first + n);
+        pos_ += n;
+        return traits_type::to_int_type(*first);
+    }
+
+private:
+    std::string str_;
+    std::size_t pos_;
+    std::size_t chunk_size_;
+};
+
+/**
+ * @brief read-only streambuf over a string, with no get area
+ */
+class unbuffered_stringbuf : public std::streambuf
+{
+public:
+    explicit unbuffered_stringbuf(const std::string& str) :
+        str_{str}, pos_{}
+    {}
+
+protected:
+    int_type underflow() override
+    {
+        return pos_ == str_.size() ?
+            traits_type::eof() : traits_type::to_int_type(str_[pos_]);
+    }
+
+    int_type uflow() override
+    {
+        return pos_ == str_.size() ?
+            traits_type::eof() : traits_type::to_int_type(str_[pos_++]);
+    }
+
+private:
+    std::string str_;
+    std::size_t pos_;
+};
+
+TEST_CASE("Parsing through buffers::input_buffer",
+          "[input][buffers]")
+{
+    const std::string serialization {
+        "[(\"a\\\"b\", [1.5, 2.5]),   (\"\", []) ,(\"long string \\\\\", [-3])]" };
+    const std::vector<std::pair<std::string, std::vector<double>>> expected {
+        { "a\"b", { 1.5, 2.5 } }, { "", {} }, { "long string \\", { -3 } } };
+
+    SECTION("is used by default_formatter when called directly with from_stream")
+    {
+        std::istringstream iss { "[1, 2, 3, 4]" };
+        std::vector<int> v;
+        input::from_stream(
+            iss, v, input::default_formatter<std::vector<int>, std::istringstream>{});
+        REQUIRE(iss.good());
+        REQUIRE(v == std::vector<int> { 1, 2, 3, 4 });
+    }
+
+    SECTION("refills its window when tokens and strings span get areas")
+    {
+        for (std::size_t chunk_size { 1 }; chunk_size < 8; ++chunk_size)
+        {
+            chunked_stringbuf buf { serialization, chunk_size };
+            std::istream is { &buf };
+            std::vector<std::pair<std::string, std::vector<double>>> vpsv;
+            is >> vpsv;
+            REQUIRE(!is.fail());
+            REQUIRE(vpsv == expected);
+        }
+    }
+
+    SECTION("reads streambufs without a get area one char at a time")
+    {
+        unbuffered_stringbuf buf { serialization };
+        std::istream is { &buf };
+        std::vector<std::pair<std::string, std::vector<double>>> vpsv;
+        is >> vpsv;
+        REQUIRE(!is.fail());
+        REQUIRE(vpsv == expected);
+    }
+
+    SECTION("decodes literal escapes spanning get areas")
+    {
+        chunked_stringbuf buf { "{'\\x01', '\\t', 'a'}", 3 };
+        std::istream is { &buf };
+        is >> strings::literalrepr;
+        std::set<char> sc;
+        is >> sc;
+        REQUIRE(!is.fail());
+        REQUIRE(sc == std::set<char> { '\x01', '\t', 'a' });
+    }
+
+    SECTION("leaves stream positioned after the serialization")
+    {
+        std::istringstream iss { "  [1, 2]  [3]x" };
+        std::vector<int> v1, v2;
+        iss >> v1 >> v2;
+        REQUIRE(v1 == std::vector<int> { 1, 2 });
+        REQUIRE(v2 == std::vector<int> { 3 });
+        REQUIRE(char(iss.get()) == 'x');
+    }
+
+    SECTION("fails on malformed serializations without modifying container")
+    {
+        std::vector<std::string> vs { "unchanged" };
+        for (const char* s : { "[\"a\", \"b\"", "[\"a\" \"b\"]", "[\"a\\x\"]",
+                               "(\"a\")", "" })
+        {
+            std::istringstream iss { s };
+            iss >> vs;
+            REQUIRE(iss.fail());
+            REQUIRE(vs == std::vector<std::string> { "unchanged" });
+        }
+    }
+
+    SECTION("reads nothing from a stream that is not good")
+    {
+        std::istringstream iss { "[1]" };
+        iss.setstate(std::ios_base::failbit);
+        std::vector<int> v;
+        iss >> v;
+        iss.clear();
+        REQUIRE(char(iss.get()) == '[');
+    }
+
+    SECTION("matches tokens as with per-char matching")
+    {
+        std::istringstream iss { "  ab" };
+        buffers::input_buffer<char> buffer { iss };
+        buffer >> std::ws;
+        REQUIRE(!buffer.match("ac", 2));
+        REQUIRE(iss.fail());
+        iss.clear();
+        REQUIRE(char(iss.get()) == 'b');
+    }
+}
+
+/**
+ * @brief parseable element type counting its copies
+ */
+struct copy_counter
+{
+    static int copies;
+
+    int value {};
+
+    copy_counter() = default;
+    copy_counter(const copy_counter& other) : value{other.value} { ++copies; }
+    copy_counter(copy_counter&&) = default;
+    copy_counter& operator=(const copy_counter& other)
+    {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+    copy_counter& operator=(copy_counter&&) = default;
+
+    bool operator<(const copy_counter& other) const { return value < other.value; }
+};
+
+int copy_counter::copies {};
+
+std::istream& operator>>(std::istream& istream, copy_counter& cc)
+{
+    return istream >> cc.value;
+}
+
+TEST_CASE("Parsing moves elements into containers",
+          "[input]")
+{
+    copy_counter::copies = 0;
+
+    SECTION("with emplace_back")
+    {
+        std::istringstream iss { "[[1, 2], [3]]" };
+        std::vector<std::vector<copy_counter>> vvc;
+        iss >> vvc;
+        REQUIRE(!iss.fail());
+        REQUIRE(vvc.size() == 2);
+        REQUIRE(vvc[1][0].value == 3);
+        REQUIRE(copy_counter::copies == 0);
+    }
+
+    SECTION("with emplace, including keys of maps")
+    {
+        std::istringstream iss { "[({1, 2}, {3}), ({4}, {})]" };
+        std::map<std::set<copy_counter>, std::set<copy_counter>> msc;
+        iss >> msc;
+        REQUIRE(!iss.fail());
+        REQUIRE(msc.size() == 2);
+        REQUIRE(msc.begin()->second.begin()->value == 3);
+        REQUIRE(copy_counter::copies == 0);
+    }
+
+    SECTION("with emplace_after")
+    {
+        std::istringstream iss { "[1, 2, 3]" };
+        std::forward_list<copy_counter> flc;
+        iss >> flc;
+        REQUIRE(!iss.fail());
+        REQUIRE(std::distance(flc.begin(), flc.end()) == 3);
+        REQUIRE(copy_counter::copies == 0);
+    }
+}
+
+#ifdef CONTAINER_STREAM_IO_PMR
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocations {};
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(
+        void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+TEST_CASE("Parsing allocator-aware containers",
+          "[input]")
+{
+    // strings long enough to be allocated rather than stored inline
+    const std::string first { "first string too long for inline storage" };
+    const std::string second { "second string too long for inline storage" };
+    counting_resource target;
+
+    SECTION("elements are constructed with the allocator of their container")
+    {
+        std::istringstream iss {
+            "[[\"" + first + "\"], [\"" + second + "\", \"" + first + "\"]]" };
+        std::pmr::vector<std::pmr::vector<std::pmr::string>> vvs { &target };
+        iss >> vvs;
+        REQUIRE(!iss.fail());
+        REQUIRE(vvs.size() == 2);
+        REQUIRE(vvs[1][0] == second.c_str());
+        for (const std::pmr::vector<std::pmr::string>& vs : vvs)
+        {
+            REQUIRE(vs.get_allocator().resource() == &target);
+            for (const std::pmr::string& s : vs)
+                REQUIRE(s.get_allocator().resource() == &target);
+        }
+    }
+
+    SECTION("including both members of map pairs")
+    {
+        std::istringstream iss { "[(\"" + first + "\", [1, 2])]" };
+        std::pmr::map<std::pmr::string, std::pmr::vector<int>> msvi { &target };
+        iss >> msvi;
+        REQUIRE(!iss.fail());
+        REQUIRE(msvi.size() == 1);
+        REQUIRE(msvi.begin()->first == first.c_str());
+        REQUIRE(msvi.begin()->first.get_allocator().resource() == &target);
+        REQUIRE(msvi.begin()->second.get_allocator().resource() == &target);
+        REQUIRE(msvi.begin()->second == std::pmr::vector<int> { 1, 2 });
+    }
+
+    SECTION("with input::basicguarantee")
+    {
+        std::istringstream iss { "[\"" + first + "\"]" };
+        iss >> input::basicguarantee;
+        std::forward_list<std::pmr::string,
+                          std::pmr::polymorphic_allocator<std::pmr::string>>
+            fls { &target };
+        iss >> fls;
+        REQUIRE(!iss.fail());
+        REQUIRE(fls.front() == first.c_str());
+        REQUIRE(fls.front().get_allocator().resource() == &target);
+    }
+
+    SECTION("with parsing temporaries allocated from a given memory resource")
+    {
+        std::istringstream iss { "[\"" + first + "\", \"" + second + "\"]" };
+        std::pmr::vector<std::pmr::string> vs { &target };
+        counting_resource scratch;
+        std::pmr::monotonic_buffer_resource arena { &scratch };
+        input::from_stream(
+            iss, vs,
+            input::default_formatter<std::pmr::vector<std::pmr::string>,
+                                     std::istream>{},
+            &arena);
+        REQUIRE(!iss.fail());
+        REQUIRE(vs.size() == 2);
+        REQUIRE(vs[0] == first.c_str());
+        REQUIRE(vs[1] == second.c_str());
+        REQUIRE(vs[0].get_allocator().resource() == &target);
+        REQUIRE(scratch.allocations > 0);
+        REQUIRE(iss.pword(input::detail::get_resource_i()) == nullptr);
+    }
+}
+#endif  // CONTAINER_STREAM_IO_PMR
+
+TEST_CASE("Parsing with formatter try_parse_suffix hook", "[input]")
+{
+    using formatter_type =
+        input::default_formatter<std::vector<int>, std::istream>;
+
+    SECTION("is detected for the default and binary formatters")
+    {
+        REQUIRE(traits::has_try_parse_suffix<formatter_type, std::istream>::value);
+        REQUIRE(traits::has_try_parse_suffix<
+                input::binary_formatter<std::vector<int>, std::istream>,
+                std::istream>::value);
+        REQUIRE(!traits::has_try_parse_suffix<
+                custom_formatter, std::istream>::value);
+    }
+
+    SECTION("extracts the suffix only if next, without setting failbit")
+    {
+        std::istringstream iss { ", 1  ]x" };
+        REQUIRE(!formatter_type::try_parse_suffix(iss));
+        REQUIRE(iss.good());
+        REQUIRE(iss.peek() == ',');
+        iss.ignore(3);
+        REQUIRE(formatter_type::try_parse_suffix(iss));
+        REQUIRE(iss.peek() == 'x');
+    }
+
+    SECTION("parses streams with failbit exceptions enabled")
+    {
+        std::istringstream iss { "[1, 2] [] {(1, 'a'), (2, 'b')} ['c', 'd']" };
+        iss.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+        std::vector<int> vi;
+        std::list<int> li { 1 };
+        std::set<std::pair<int, char>> spic;
+        std::forward_list<char> flc;
+        REQUIRE_NOTHROW(iss >> vi >> li >> spic >> flc);
+        REQUIRE(vi == std::vector<int> { 1, 2 });
+        REQUIRE(li.empty());
+        REQUIRE(spic == std::set<std::pair<int, char>> { { 1, 'a' }, { 2, 'b' } });
+        REQUIRE(flc == std::forward_list<char> { 'c', 'd' });
+
+        std::istringstream malformed { "[1; 2]" };
+        malformed.exceptions(std::ios_base::failbit);
+        REQUIRE_THROWS_AS(malformed >> vi, std::ios_base::failure);
+        REQUIRE(vi == std::vector<int> { 1, 2 });
+    }
+}
+
+TEST_CASE("Parsing with input::basicguarantee/strongguarantee",
+          "[input]")
+{
+    SECTION("basicguarantee parses valid serializations as strongguarantee")
+    {
+        std::istringstream iss { "[(\"a\", [1, 2]), (\"b\", [])]" };
+        iss >> input::basicguarantee;
+        std::map<std::string, std::vector<int>> msv { { "old", { 0 } } };
+        iss >> msv;
+        REQUIRE(!iss.fail());
+        REQUIRE(msv == std::map<std::string, std::vector<int>> {
+                { "a", { 1, 2 } }, { "b", {} } });
+    }
+
+    SECTION("basicguarantee leaves elements parsed before failure")
+    {
+        std::istringstream iss { "[[1, 2], [3, x]]" };
+        iss >> input::basicguarantee;
+        std::vector<std::vector<int>> vv { { 0 } };
+        iss >> vv;
+        REQUIRE(iss.fail());
+        REQUIRE(vv.size() == 1);
+        REQUIRE(vv[0] == std::vector<int> { 1, 2 });
+    }
+
+    SECTION("strongguarantee (default) leaves target unmodified on failure")
+    {
+        std::istringstream iss { "[1, 2, x]" };
+        std::forward_list<int> fl { 0 };
+        iss >> input::basicguarantee >> input::strongguarantee >> fl;
+        REQUIRE(iss.fail());
+        REQUIRE(fl == std::forward_list<int> { 0 });
+    }
+}
+
+TEST_CASE("Parsing ordered associative containers with input::sortedonly/"
+          "anyorder", "[input]")
+{
+    SECTION("sorted serializations are parsed as before")
+    {
+        std::istringstream iss { "[(1, \"a\"), (2, \"b\"), (3, \"c\")]" };
+        std::map<int, std::string> mis;
+        iss >> input::sortedonly >> mis;
+        REQUIRE(!iss.fail());
+        REQUIRE(mis == std::map<int, std::string> {
+                { 1, "a" }, { 2, "b" }, { 3, "c" } });
+    }
+
+    SECTION("anyorder (default) accepts unsorted serializations")
+    {
+        std::istringstream iss { "{3, 1, 2}" };
+        std::set<int> si;
+        iss >> si;
+        REQUIRE(!iss.fail());
+        REQUIRE(si == std::set<int> { 1, 2, 3 });
+    }
+
+    SECTION("sortedonly rejects unsorted serializations")
+    {
+        std::istringstream iss { "{1, 3, 2}" };
+        std::set<int> si { 0 };
+        iss >> input::sortedonly >> si;
+        REQUIRE(iss.fail());
+        REQUIRE(si == std::set<int> { 0 });
+    }
+
+    SECTION("sortedonly accepts equivalent keys of multi containers")
+    {
+        std::istringstream iss { "{1, 1, 2}" };
+        std::multiset<int> msi;
+        iss >> input::sortedonly >> msi;
+        REQUIRE(!iss.fail());
+        REQUIRE(msi == std::multiset<int> { 1, 1, 2 });
+    }
+
+    SECTION("sortedonly follows the ordering of the container")
+    {
+        std::istringstream iss { "{3, 2, 1} {1, 2, 3}" };
+        std::set<int, std::greater<int>> si;
+        iss >> input::sortedonly >> si;
+        REQUIRE(!iss.fail());
+        REQUIRE(si == std::set<int, std::greater<int>> { 1, 2, 3 });
+        iss >> si;
+        REQUIRE(iss.fail());
+    }
+
+    SECTION("sortedonly is ignored by unordered containers")
+    {
+        std::istringstream iss { "[3, 1, 2]" };
+        std::vector<int> vi;
+        iss >> input::sortedonly >> vi;
+        REQUIRE(!iss.fail());
+        REQUIRE(vi == std::vector<int> { 3, 1, 2 });
+    }
+
+    SECTION("anyorder restores the default")
+    {
+        std::istringstream iss { "{2, 1}" };
+        std::set<int> si;
+        iss >> input::sortedonly >> input::anyorder >> si;
+        REQUIRE(!iss.fail());
+        REQUIRE(si == std::set<int> { 1, 2 });
+    }
+}
+
+TEST_CASE("Streaming with decorator::counthint",
+          "[output][input]")
+{
+    SECTION("inserts count hints after prefixes of non-empty containers")
+    {
+        std::ostringstream oss;
+        const std::vector<std::set<int>> vs { { 1, 2 }, {} };
+        const std::pair<int, int> p { 1, 2 };
+        const std::forward_list<int> fl { 3, 4, 5 };
+        const int a[2] { 6, 7 };
+        oss << decorator::counthint << vs << ' ' << p << ' ' << fl << ' ' << a;
+        REQUIRE(oss.str() == "[#2: {#2: 1, 2}, {}] (1, 2) [#3: 3, 4, 5] [#2: 6, 7]");
+        oss.str("");
+        oss << decorator::nocounthint << vs;
+        REQUIRE(oss.str() == "[{1, 2}, {}]");
+    }
+
+    SECTION("inserts count hints in wide char streams")
+    {
+        std::wostringstream woss;
+        woss << decorator::counthint << std::vector<int> { 1, 2 };
+        REQUIRE(woss.str() == L"[#2: 1, 2]");
+    }
+
+    SECTION("accepts serializations with or without count hints")
+    {
+        std::istringstream iss { "[#2: {#2: 1, 2}, {}] [{3}]" };
+        iss >> decorator::counthint;
+        std::vector<std::set<int>> vs1, vs2;
+        iss >> vs1 >> vs2;
+        REQUIRE(!iss.fail());
+        REQUIRE(vs1 == std::vector<std::set<int>> { { 1, 2 }, {} });
+        REQUIRE(vs2 == std::vector<std::set<int>> { { 3 } });
+    }
+
+    SECTION("round trips containers")
+    {
+        const std::map<std::string, std::vector<int>> msv {
+            { "a", { 1, 2 } }, { "b", {} } };
+        std::stringstream ss;
+        ss << decorator::counthint << msv;
+        std::map<std::string, std::vector<int>> parsed;
+        ss >> parsed;
+        REQUIRE(!ss.fail());
+        REQUIRE(parsed == msv);
+    }
+
+    SECTION("preallocates containers with reserve()")
+    {
+        std::ostringstream oss;
+        const std::vector<int> v (1000, 1);
+        oss << decorator::counthint << v;
+        std::istringstream iss { oss.str() };
+        iss >> decorator::counthint;
+        std::vector<int> parsed;
+        iss >> parsed;
+        REQUIRE(!iss.fail());
+        REQUIRE(parsed == v);
+        REQUIRE(parsed.capacity() == 1000);
+    }
+
+    SECTION("does not trust preallocation to hints much larger than input")
+    {
+        std::istringstream iss { "[#999999999999: 1]" };
+        iss >> decorator::counthint;
+        std::vector<int> v;
+        iss >> v;
+        REQUIRE(!iss.fail());
+        REQUIRE(v == std::vector<int> { 1 });
+        REQUIRE(v.capacity() < 999999999999);
+    }
+
+    SECTION("rejects arrays with hints not matching their length")
+    {
+        std::istringstream iss { "[#2: 1, 2, 3]" };
+        iss >> decorator::counthint;
+        std::array<int, 3> a3 { { 0, 0, 0 } };
+        iss >> a3;
+        REQUIRE(iss.fail());
+        REQUIRE(a3 == std::array<int, 3> { { 0, 0, 0 } });
+        // failed before elements
+        iss.clear();
+        REQUIRE(char(iss.get()) == ' ');
+    }
+
+    SECTION("fails on malformed hints")
+    {
+        for (const char* s : { "[#: 1]", "[#1 1]", "[#x: 1]",
+                               "[#99999999999999999999999: 1]" })
+        {
+            std::istringstream iss { s };
+            iss >> decorator::counthint;
+            std::vector<int> v;
+            iss >> v;
+            REQUIRE(iss.fail());
+        }
+    }
+
+    SECTION("hints are not accepted unless enabled")
+    {
+        std::istringstream iss { "[#1: 1]" };
+        std::vector<int> v;
+        iss >> v;
+        REQUIRE(iss.fail());
+    }
+}
+
+TEST_CASE("Printing with output::to_stream_parallel",
+          "[output]")
+{
+    std::vector<std::string> vs (10000);
+    for (std::size_t i {}; i < vs.size(); ++i)
+        vs[i] = "element \"" + std::to_string(i) + '"';
+    std::ostringstream expected;
+    expected << vs;
+
+    SECTION("matches to_stream output for any thread count")
+    {
+        for (const std::size_t thread_count : { 0, 1, 2, 3, 8 })
+        {
+            std::ostringstream oss;
+            output::to_stream_parallel(
+                oss, vs, output::default_formatter<std::vector<std::string>,
+                                                   std::ostringstream>{},
+                thread_count);
+            REQUIRE(oss.good());
+            REQUIRE(oss.str() == expected.str());
+        }
+    }
+
+    SECTION("matches to_stream output for random access containers")
+    {
+        const std::deque<std::vector<int>> dvi (5000, { 1, 2 });
+        std::ostringstream oss, expected_dvi;
+        output::to_stream_parallel(
+            oss, dvi, output::default_formatter<std::deque<std::vector<int>>,
+                                                std::ostringstream>{}, 4);
+        expected_dvi << dvi;
+        REQUIRE(oss.str() == expected_dvi.str());
+
+        static int a[3000] {};
+        std::wostringstream woss, expected_a;
+        output::to_stream_parallel(
+            woss, a, output::default_formatter<int[3000], std::wostringstream>{}, 4);
+        expected_a << a;
+        REQUIRE(woss.str() == expected_a.str());
+    }
+
+    SECTION("copies format state of the stream to each chunk")
+    {
+        std::ostringstream oss, expected_quoted;
+        oss << strings::quotedrepr << decorator::counthint;
+        expected_quoted << strings::quotedrepr << decorator::counthint << vs;
+        output::to_stream_parallel(
+            oss, vs, output::default_formatter<std::vector<std::string>,
+                                               std::ostringstream>{}, 4);
+        REQUIRE(oss.str() == expected_quoted.str());
+    }
+
+    SECTION("uses custom formatters as given")
+    {
+        const std::vector<int> vi (4000, 5);
+        std::wostringstream woss, expected_custom;
+        output::to_stream_parallel(woss, vi, custom_formatter{}, 4);
+        output::to_stream(expected_custom, vi, custom_formatter{});
+        REQUIRE(woss.str() == expected_custom.str());
+    }
+
+    SECTION("stops writing when a chunk fails")
+    {
+        const std::vector<std::u32string> vu32s (4000, U"a");
+        std::ostringstream oss;
+        oss << strings::quotedrepr;
+        output::to_stream_parallel(
+            oss, vu32s, output::default_formatter<std::vector<std::u32string>,
+                                                  std::ostringstream>{}, 4);
+        REQUIRE(oss.fail());
+        REQUIRE(oss.str() == "[");
+    }
+
+    SECTION("worker threads are started once and reused by each round")
+    {
+        static constexpr std::size_t worker_count { 4 };
+        std::vector<std::vector<std::thread::id>> ids (worker_count);
+        {
+            parallel::worker_group workers { worker_count };
+            for (std::size_t round {}; round < 16; ++round)
+            {
+                workers.run([&ids](const std::size_t i) {
+                    ids[i].push_back(std::this_thread::get_id()); });
+            }
+        }
+        REQUIRE(ids[0] == std::vector<std::thread::id> (
+                    16, std::this_thread::get_id()));
+        for (const std::vector<std::thread::id>& worker_ids : ids)
+        {
+            REQUIRE(worker_ids.size() == 16);
+            REQUIRE(std::count(worker_ids.begin(), worker_ids.end(),
+                               worker_ids.front()) == 16);
+        }
+    }
+}
+
+TEST_CASE("Printing with output::to_stream_committed",
+          "[output]")
+{
+    using vs_formatter =
+        output::default_formatter<std::vector<std::string>, std::ostream>;
+
+    SECTION("matches to_stream output, with the format state of the stream")
+    {
+        const std::vector<std::string> vs { "a", "b'c" };
+        std::ostringstream expected;
+        expected << strings::literalrepr << vs;
+        std::ostringstream oss;
+        oss << strings::literalrepr;
+        output::to_stream_committed(oss, vs, vs_formatter{});
+        output::to_stream_committed(oss, vs, vs_formatter{});
+        REQUIRE(oss.str() == expected.str() + expected.str());
+    }
+
+    SECTION("writes each container whole under the mutex")
+    {
+        static constexpr std::size_t thread_count { 4 };
+        static constexpr std::size_t line_count { 200 };
+        std::ostringstream oss;
+        std::mutex mutex;
+        const auto print_lines = [&](const std::size_t t) {
+            const std::vector<std::string> vs (
+                64, std::string(16, static_cast<char>('a' + t)));
+            for (std::size_t i {}; i < line_count; ++i)
+                output::to_stream_committed(oss, vs, vs_formatter{}, mutex);
+        };
+        std::vector<std::thread> threads;
+        for (std::size_t t {}; t < thread_count; ++t)
+            threads.emplace_back(print_lines, t);
+        for (std::thread& thread : threads)
+            thread.join();
+
+        std::istringstream iss { oss.str() };
+        std::size_t parsed_count {};
+        for (std::vector<std::string> parsed; iss >> parsed; ++parsed_count)
+        {
+            REQUIRE(parsed.size() == 64);
+            REQUIRE(std::all_of(parsed.begin(), parsed.end(),
+                                [&parsed](const std::string& s) {
+                                    return s == parsed.front(); }));
+        }
+        REQUIRE(parsed_count == thread_count * line_count);
+    }
+
+    SECTION("grows its buffer to fit large containers")
+    {
+        const std::vector<std::string> vs (4096, std::string(64, 'x'));
+        std::ostringstream expected;
+        expected << vs;
+        std::ostringstream oss;
+        output::to_stream_committed(oss, vs, vs_formatter{});
+        REQUIRE(oss.str() == expected.str());
+    }
+
+    SECTION("sets failure of formatting on the stream, writing nothing")
+    {
+        const std::vector<int> vi { 1, 2 };
+        std::ostringstream oss;
+        oss << binary::binaryrepr;
+        output::to_stream_committed(
+            oss, output::range(vi.begin(), vi.end()),
+            output::binary_formatter<std::vector<int>, std::ostream>{});
+        REQUIRE(!oss.fail());
+
+        std::ostringstream failing;
+        std::istringstream iss { "1 2" };
+        output::to_stream_committed(
+            failing, output::range(std::istream_iterator<int>(iss),
+                                   std::istream_iterator<int>()),
+            output::binary_formatter<std::vector<int>, std::ostream>{});
+        REQUIRE(failing.fail());
+        REQUIRE(failing.str().empty());
+    }
+}
+
+TEST_CASE("Parsing with input::from_stream_parallel",
+          "[input]")
+{
+    std::vector<std::string> vs (10000);
+    for (std::size_t i {}; i < vs.size(); ++i)
+        vs[i] = "element [\"" + std::to_string(i) + "\", {'}'}>";
+    std::ostringstream oss;
+    oss << vs << " 42";
+    const std::string serialization { oss.str() };
+    using vs_formatter =
+        input::default_formatter<std::vector<std::string>, std::istringstream>;
+
+    SECTION("matches from_stream results for any thread count")
+    {
+        for (const std::size_t thread_count : { 0, 1, 2, 3, 8 })
+        {
+            std::istringstream iss { serialization };
+            std::vector<std::string> parsed;
+            input::from_stream_parallel(iss, parsed, vs_formatter{}, thread_count);
+            REQUIRE(iss.good());
+            REQUIRE(parsed == vs);
+            int trailing {};
+            iss >> trailing;
+            REQUIRE(trailing == 42);
+        }
+    }
+
+    SECTION("splits serializations held in the get area")
+    {
+        std::istringstream iss { serialization };
+        std::vector<std::string> parsed;
+        REQUIRE(input::extract_container_parallel(iss, parsed, vs_formatter{}, 4));
+        REQUIRE(parsed == vs);
+
+        chunked_stringbuf buf { serialization, 4096 };
+        std::istream is { &buf };
+        REQUIRE(!input::extract_container_parallel(
+                    is, parsed, input::default_formatter<
+                    std::vector<std::string>, std::istream>{}, 4));
+        REQUIRE(is.peek() == '[');
+    }
+
+    SECTION("falls back to from_stream when not wholly in the get area")
+    {
+        chunked_stringbuf buf { serialization, 4096 };
+        std::istream is { &buf };
+        std::vector<std::string> parsed;
+        input::from_stream_parallel(
+            is, parsed, input::default_formatter<std::vector<std::string>,
+                                                  std::istream>{}, 4);
+        REQUIRE(!is.fail());
+        REQUIRE(parsed == vs);
+    }
+
+    SECTION("emplaces elements in order")
+    {
+        std::multimap<int, std::vector<int>> mmivi;
+        std::deque<double> dd;
+        for (int i {}; i < 5000; ++i)
+        {
+            mmivi.emplace(i % 7, std::vector<int> { i, -i });
+            dd.push_back(i * 0.5);
+        }
+        std::ostringstream expected;
+        expected << mmivi << dd;
+        std::istringstream iss { expected.str() };
+        std::multimap<int, std::vector<int>> parsed_mmivi;
+        std::deque<double> parsed_dd;
+        input::from_stream_parallel(
+            iss, parsed_mmivi, input::default_formatter<
+            std::multimap<int, std::vector<int>>, std::istringstream>{}, 4);
+        input::from_stream_parallel(
+            iss, parsed_dd, input::default_formatter<
+            std::deque<double>, std::istringstream>{}, 4);
+        REQUIRE(!iss.fail());
+        REQUIRE(parsed_mmivi == mmivi);
+        REQUIRE(parsed_dd == dd);
+    }
+
+    SECTION("checks order of elements across pieces with input::sortedonly")
+    {
+        std::set<int> si;
+        for (int i {}; i < 20000; ++i)
+            si.insert(i);
+        std::ostringstream sorted;
+        sorted << si;
+        std::string unsorted { sorted.str() };
+        unsorted.replace(unsorted.rfind("19999"), 5, "00000");
+        using si_formatter =
+            input::default_formatter<std::set<int>, std::istringstream>;
+
+        std::istringstream iss { sorted.str() };
+        iss >> input::sortedonly;
+        std::set<int> parsed;
+        REQUIRE(input::extract_container_parallel(iss, parsed, si_formatter{}, 4));
+        REQUIRE(parsed == si);
+
+        iss.str(unsorted);
+        iss.clear();
+        REQUIRE(!input::extract_container_parallel(iss, parsed, si_formatter{}, 4));
+        input::from_stream_parallel(iss, parsed, si_formatter{}, 4);
+        REQUIRE(iss.fail());
+        REQUIRE(parsed == si);
+    }
+
+    SECTION("copies format state of the stream to each piece")
+    {
+        std::ostringstream expected;
+        expected << strings::quotedrepr << decorator::counthint << vs;
+        std::istringstream iss { expected.str() };
+        iss >> strings::quotedrepr >> decorator::counthint;
+        std::vector<std::string> parsed;
+        REQUIRE(input::extract_container_parallel(iss, parsed, vs_formatter{}, 4));
+        REQUIRE(parsed == vs);
+    }
+
+    SECTION("fails as from_stream does on malformed elements")
+    {
+        std::string malformed { serialization };
+        malformed.insert(malformed.find("\"element [\\\"5000"), "x");
+        std::istringstream iss { malformed }, expected_iss { malformed };
+        std::vector<std::string> parsed { "unchanged" }, expected;
+        input::from_stream_parallel(iss, parsed, vs_formatter{}, 4);
+        expected_iss >> expected;
+        REQUIRE(iss.fail());
+        REQUIRE(parsed == std::vector<std::string> { "unchanged" });
+        REQUIRE(iss.tellg() == expected_iss.tellg());
+    }
+
+    SECTION("parses from caller-owned chars with buffers::span_streambuf")
+    {
+        buffers::span_streambuf<char> buf {
+            serialization.data(), serialization.data() + serialization.size() };
+        std::istream is { &buf };
+        std::vector<std::string> parsed;
+        input::from_stream_parallel(
+            is, parsed, input::default_formatter<std::vector<std::string>,
+                                                  std::istream>{}, 4);
+        REQUIRE(parsed == vs);
+        REQUIRE(buf.current() ==
+                serialization.data() + serialization.size() - 3);
+        REQUIRE(is.seekg(0).tellg() == 0);
+    }
+}
+
+/**
+ * @brief feeds serialization to a push_parser in chunks of chunk_size chars,
+ *   until it completes or fails
+ */
+template <typename ContainerType>
+static typename input::push_parser<ContainerType>::status push_in_chunks(
+    input::push_parser<ContainerType>& parser, const std::string& serialization,
+    const std::size_t chunk_size)
+{
+    using status = typename input::push_parser<ContainerType>::status;
+
+    status result { status::need_more };
+    for (std::size_t i {};
+         i < serialization.size() && result == status::need_more;
+         i += chunk_size)
+    {
+        result = parser.feed(serialization.data() + i,
+                             std::min(chunk_size, serialization.size() - i));
+    }
+    return result;
+}
+
+TEST_CASE("Parsing with input::push_parser",
+          "[input]")
+{
+    using vs_parser = input::push_parser<std::vector<std::string>>;
+    using status = vs_parser::status;
+
+    SECTION("matches from_stream results for any chunk size")
+    {
+        const std::vector<std::string> vs {
+            "plain", "with, [nested] <decorators>", "\"quoted\"", "\x01\x7f\n",
+            "", "'" };
+        std::ostringstream oss;
+        oss << vs;
+        const std::string serialization { oss.str() };
+        for (std::size_t chunk_size {1}; chunk_size <= serialization.size();
+             ++chunk_size)
+        {
+            vs_parser parser;
+            REQUIRE(push_in_chunks(parser, serialization, chunk_size) ==
+                    status::complete);
+            REQUIRE(parser.container() == vs);
+        }
+    }
+
+    SECTION("with nested containers")
+    {
+        const std::map<std::string, std::vector<std::set<int>>> msvsi {
+            { "a", { { 1, 2 }, {}, { 3 } } }, { "b]", {} } };
+        std::ostringstream oss;
+        oss << msvsi;
+        for (std::size_t chunk_size : { 1, 2, 3, 7 })
+        {
+            using msvsi_parser = input::push_parser<
+                std::map<std::string, std::vector<std::set<int>>>>;
+            msvsi_parser parser;
+            REQUIRE(push_in_chunks(parser, oss.str(), chunk_size) ==
+                    msvsi_parser::status::complete);
+            REQUIRE(parser.container() == msvsi);
+        }
+    }
+
+    SECTION("with format state of a stream")
+    {
+        std::ostringstream oss;
+        oss << strings::quotedrepr << decorator::counthint;
+        const std::vector<std::string> vs { "a\\b", "" };
+        oss << vs << std::vector<std::string> {};
+        REQUIRE(oss.str() == "[#2: \"a\\\\b\", \"\"][]");
+
+        std::istringstream iss;
+        iss >> strings::quotedrepr >> decorator::counthint;
+        vs_parser parser { iss };
+        const std::string serializations { oss.str() };
+        REQUIRE(parser.feed(serializations.data(), serializations.size()) ==
+                status::complete);
+        REQUIRE(parser.container() == vs);
+        REQUIRE(parser.remainder() == "[]");
+    }
+
+    SECTION("keeps chars after the serialization for the next")
+    {
+        const std::string serializations { "[\"a\"]  [\"b\", \"c\"] x" };
+        vs_parser parser;
+        REQUIRE(parser.feed(serializations.data(), serializations.size()) ==
+                status::complete);
+        REQUIRE(parser.container() == std::vector<std::string> { "a" });
+        REQUIRE(parser.remainder() == "  [\"b\", \"c\"] x");
+
+        parser.reset();
+        REQUIRE(parser.feed(nullptr, 0) == status::complete);
+        REQUIRE(parser.container() == std::vector<std::string> { "b", "c" });
+        REQUIRE(parser.remainder() == " x");
+    }
+
+    SECTION("reports errors once malformed input is seen")
+    {
+        for (const std::string malformed :
+                 { "(\"a\"]", "[\"a\" \"b\"]", "[, \"a\"]", "[\"a\"; \"b\"]", "[1]" })
+        {
+            vs_parser parser;
+            REQUIRE(push_in_chunks(parser, malformed, 1) == status::error);
+        }
+
+        using vi_parser = input::push_parser<std::vector<int>>;
+        vi_parser parser;
+        REQUIRE(parser.feed(nullptr, 0) == vi_parser::status::need_more);
+        const std::string partial { "[1, 23" };
+        REQUIRE(parser.feed(partial.data(), partial.size()) ==
+                vi_parser::status::need_more);
+        REQUIRE(parser.container() == std::vector<int> { 1 });
+        const std::string rest { "4, 5]" };
+        REQUIRE(parser.feed(rest.data(), rest.size()) ==
+                vi_parser::status::complete);
+        REQUIRE(parser.container() == std::vector<int> { 1, 234, 5 });
+    }
+}
+
+/**
+ * @brief records visited serialization structure as a flat string
+ */
+struct structure_recorder
+{
+    std::ostringstream record;
+    std::size_t stop_after { std::size_t(-1) };
+
+    void begin_container() { record << '<'; }
+    void end_container() { record << '>'; }
+
+    template <typename ElementType>
+    bool element(const ElementType& element)
+    {
+        record << element << ' ';
+        return --stop_after != 0;
+    }
+};
+
+TEST_CASE("Parsing with input::elements/input::visit",
+          "[input]")
+{
+    SECTION("elements parses one element per increment")
+    {
+        std::istringstream iss { "[\"a\", \"b\", \"c\"] 42" };
+        auto range = input::elements<std::vector<std::string>>(iss);
+        auto it = range.begin();
+        REQUIRE(*it == "a");
+        REQUIRE(iss.peek() == ',');
+        std::vector<std::string> rest;
+        for (++it; it != range.end(); ++it)
+            rest.emplace_back(std::move(*it));
+        REQUIRE(rest == std::vector<std::string> { "b", "c" });
+        int trailing {};
+        iss >> trailing;
+        REQUIRE(trailing == 42);
+    }
+
+    SECTION("postfix increment yields the element it was at")
+    {
+        std::istringstream iss { "[\"a\", \"b\", \"c\"]" };
+        auto range = input::elements<std::vector<std::string>>(iss);
+        auto it = range.begin();
+        const std::string first { *it++ };
+        REQUIRE(first == "a");
+        REQUIRE(*it == "b");
+        it++;
+        REQUIRE(*it++ == "c");
+        REQUIRE(it == range.end());
+        REQUIRE(!iss.fail());
+    }
+
+    SECTION("elements of maps are non-const key pairs")
+    {
+        std::istringstream iss { "[(1, [2, 3]), (4, [])]" };
+        std::vector<int> keys;
+        std::size_t values {};
+        for (std::pair<int, std::vector<int>>& element :
+                 input::elements<std::map<int, std::vector<int>>>(iss))
+        {
+            keys.push_back(element.first);
+            values += element.second.size();
+        }
+        REQUIRE(!iss.fail());
+        REQUIRE(keys == std::vector<int> { 1, 4 });
+        REQUIRE(values == 2);
+    }
+
+    SECTION("elements stops reading on early termination, or at failure")
+    {
+        std::istringstream iss { "[1, 2, 3]" };
+        for (const int i : input::elements<std::vector<int>>(iss))
+        {
+            if (i == 2)
+                break;
+        }
+        REQUIRE(iss.peek() == ',');
+
+        std::istringstream empty { "[]" };
+        auto range = input::elements<std::vector<int>>(empty);
+        REQUIRE(range.begin() == range.end());
+        REQUIRE(!empty.fail());
+
+        std::istringstream malformed { "[1, 2; 3]" };
+        std::size_t count {};
+        for (const int i : input::elements<std::vector<int>>(malformed))
+            count += static_cast<std::size_t>(i);
+        REQUIRE(count == 3);
+        REQUIRE(malformed.fail());
+    }
+
+    SECTION("visit walks nested structure without materializing it")
+    {
+        std::istringstream iss {
+            "[(\"a\", [1, 2]), (\"b\", [])] [<1, 'x', 2.5>]" };
+        iss >> strings::quotedrepr;
+        structure_recorder recorder;
+        input::visit<std::map<std::string, std::vector<int>>>(iss, recorder);
+        REQUIRE(!iss.fail());
+        REQUIRE(recorder.record.str() == "<<a <1 2 >><b <>>>");
+
+        structure_recorder tuple_recorder;
+        input::visit<std::vector<std::tuple<int, char, double>>>(
+            iss >> strings::literalrepr, tuple_recorder);
+        REQUIRE(!iss.fail());
+        REQUIRE(tuple_recorder.record.str() == "<<1 x 2.5 >>");
+    }
+
+    SECTION("visit stops when the visitor returns false, or at failure")
+    {
+        std::istringstream iss { "[[1, 2], [3]]" };
+        structure_recorder recorder;
+        recorder.stop_after = 2;
+        input::visit<std::vector<std::vector<int>>>(iss, recorder);
+        REQUIRE(!iss.fail());
+        REQUIRE(recorder.record.str() == "<<1 2 ");
+        REQUIRE(iss.peek() == ']');
+
+        std::istringstream malformed { "[[1, 2], [3}]" };
+        structure_recorder malformed_recorder;
+        input::visit<std::vector<std::vector<int>>>(malformed, malformed_recorder);
+        REQUIRE(malformed.fail());
+    }
+}
+
+TEST_CASE("Streaming with input::from_file/output::to_file",
+          "[input][output]")
+{
+    const std::string path { "container_stream_io_test_file.txt" };
+    std::map<std::string, std::vector<double>> msvd;
+    for (int i {}; i < 2000; ++i)
+        msvd.emplace("key \"" + std::to_string(i) + '"',
+                     std::vector<double> { i * 0.5, -i * 0.25 });
+
+    SECTION("round trips containers through a file")
+    {
+        REQUIRE(output::to_file(path, msvd));
+        std::ostringstream expected;
+        expected << msvd;
+        {
+            const buffers::mapped_file file { path };
+            REQUIRE(file.is_open());
+            REQUIRE(std::string(file.data(), file.size()) == expected.str());
+#if defined(CONTAINER_STREAM_IO_POSIX_MMAP) || defined(CONTAINER_STREAM_IO_WIN32_MMAP)
+            REQUIRE(file.is_mapped());
+#else
+            REQUIRE(!file.is_mapped());
+#endif
+        }
+        std::map<std::string, std::vector<double>> parsed;
+        REQUIRE(input::from_file(path, parsed));
+        REQUIRE(parsed == msvd);
+    }
+
+    SECTION("reads empty files")
+    {
+        REQUIRE(output::to_file(path, std::vector<int> {}));
+        std::ofstream { path, std::ios_base::trunc };
+        const buffers::mapped_file file { path };
+        REQUIRE(file.is_open());
+        REQUIRE(file.size() == 0);
+        std::vector<int> parsed { 1 };
+        REQUIRE(!input::from_file(path, parsed));
+        REQUIRE(parsed == std::vector<int> { 1 });
+    }
+
+    SECTION("fails on files that cannot be opened or parsed")
+    {
+        std::vector<int> parsed { 1 };
+        REQUIRE(!input::from_file("no/such/dir/file.txt", parsed));
+        REQUIRE(!output::to_file("no/such/dir/file.txt", parsed));
+        REQUIRE(!buffers::mapped_file { "no/such/dir/file.txt" }.is_open());
+
+        REQUIRE(output::to_file(path, msvd));
+        REQUIRE(!input::from_file(path, parsed));
+        REQUIRE(parsed == std::vector<int> { 1 });
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Streaming with output::to_string/to_buffer/serialized_size and "
+          "input::from_string", "[input][output]")
+{
+    const std::map<std::string, std::vector<double>> msvd {
+        { "a\t\"b\"", { 1.5, -2.0 } }, { "", {} } };
+    std::ostringstream expected;
+    expected << msvd;
+
+    SECTION("serialized_size measures the serialization without printing it")
+    {
+        REQUIRE(output::serialized_size(msvd) == expected.str().size());
+        REQUIRE(output::serialized_size(std::vector<int> {}) == 2);
+
+        std::ostringstream quoted;
+        quoted << strings::quotedrepr << msvd;
+        quoted.clear();
+        const output::default_formatter<decltype(msvd), std::ostream> formatter {
+            format_state::capture(quoted) };
+        REQUIRE(output::serialized_size(msvd, formatter) == quoted.str().size());
+    }
+
+    SECTION("to_string matches to_stream output")
+    {
+        REQUIRE(output::to_string(msvd) == expected.str());
+
+        // grown past its first allocation
+        const std::vector<int> vi (5000, 7);
+        std::ostringstream oss;
+        oss << vi;
+        REQUIRE(output::to_string(vi) == oss.str());
+        REQUIRE(output::to_string(std::vector<int> {}) == "[]");
+    }
+
+    SECTION("to_buffer writes into caller buffers, cutting off at their size")
+    {
+        std::vector<char> buffer (expected.str().size() + 4, '#');
+        REQUIRE(output::to_buffer(msvd, buffer.data(), buffer.size()) ==
+                expected.str().size());
+        REQUIRE(std::string(buffer.data(), expected.str().size()) == expected.str());
+        REQUIRE(buffer.back() == '#');
+
+        char small[4] {};
+        REQUIRE(output::to_buffer(msvd, small, sizeof(small)) ==
+                expected.str().size());
+        REQUIRE(std::string(small, sizeof(small)) == expected.str().substr(0, 4));
+    }
+
+    SECTION("from_string parses without an istringstream")
+    {
+        std::map<std::string, std::vector<double>> parsed;
+        REQUIRE(input::from_string(expected.str(), parsed));
+        REQUIRE(parsed == msvd);
+
+        std::vector<int> vi { 0 };
+        REQUIRE(!input::from_string("[1, x]", 6, vi));
+        REQUIRE(vi == std::vector<int> { 0 });
+#if (__cplusplus >= 201703L)
+        REQUIRE(input::from_string(std::string_view { "[1, 2]" }, vi));
+        REQUIRE(vi == std::vector<int> { 1, 2 });
+
+        // temporary chars are not viewed, so views fail rather than dangle
+        std::vector<std::string_view> vsv;
+        REQUIRE(!input::from_string(std::string { "[\"a\", \"b\"]" }, vsv));
+        REQUIRE(vsv.empty());
+        const std::string kept { "[\"a\", \"b\"]" };
+        REQUIRE(input::from_string(kept, vsv));
+        REQUIRE(vsv == std::vector<std::string_view> { "a", "b" });
+        REQUIRE(vsv[0].data() > kept.data());
+#endif
+    }
+}
+
+TEST_CASE("Counting serialization events with instrumentation policies",
+          "[input][output]")
+{
+    std::vector<instrumentation::counters> exported;
+    instrumentation::set_sink([&exported](const instrumentation::counters& c) {
+        exported.push_back(c);
+    });
+
+    SECTION("counting_policy exports the counters of top-level scopes")
+    {
+        using instrumentation::counting_policy;
+        using output_scope = instrumentation::output_scope<
+            std::ostringstream, counting_policy>;
+        using input_scope = instrumentation::input_scope<
+            std::istringstream, counting_policy>;
+
+        std::ostringstream oss;
+        oss << "abc";
+        {
+            const output_scope outer { oss };
+            counting_policy::count_elements(2);
+            {
+                const output_scope inner { oss };
+                counting_policy::count_elements(3);
+                counting_policy::count_string(true);
+                counting_policy::count_string(false);
+                counting_policy::count_string(false);
+            }
+            REQUIRE(exported.empty());
+            oss << "[1, 2]";
+        }
+        REQUIRE(exported.size() == 1);
+        REQUIRE(exported[0].dir == instrumentation::direction::output);
+        REQUIRE(exported[0].bytes == 6);
+        REQUIRE(exported[0].elements[0] == 2);
+        REQUIRE(exported[0].elements[1] == 3);
+        REQUIRE(exported[0].escaped_strings == 1);
+        REQUIRE(exported[0].unescaped_strings == 2);
+
+        std::istringstream iss;
+        {
+            const input_scope scope { iss };
+            counting_policy::count_hex_escape();
+            counting_policy::count_failed_probe();
+        }
+        REQUIRE(exported.size() == 2);
+        REQUIRE(exported[1].dir == instrumentation::direction::input);
+        REQUIRE(exported[1].bytes == 0);
+        REQUIRE(exported[1].elements[0] == 0);
+        REQUIRE(exported[1].hex_escapes_decoded == 1);
+        REQUIRE(exported[1].failed_token_probes == 1);
+    }
+
+    const std::map<std::string, std::vector<int>> msvi {
+        { std::string { "a\x01" }, { 1, 2, 3 } }, { "b", {} } };
+
+#ifdef CONTAINER_STREAM_IO_INSTRUMENTATION
+    SECTION("to_stream and from_stream hooks count with counting_policy")
+    {
+        const std::map<std::string, std::vector<int>> escaped {
+            { std::string { "a\x01", 2 }, { 1, 2, 3 } }, { "b", {} } };
+        std::ostringstream oss;
+        oss << escaped;
+        REQUIRE(exported.size() == 1);
+        REQUIRE(exported[0].bytes == oss.str().size());
+        // map, its pairs, and the vectors of the pairs
+        REQUIRE(exported[0].elements[0] == 2);
+        REQUIRE(exported[0].elements[1] == 4);
+        REQUIRE(exported[0].elements[2] == 3);
+        REQUIRE(exported[0].escaped_strings == 1);
+        REQUIRE(exported[0].unescaped_strings == 1);
+
+        std::map<std::string, std::vector<int>> parsed;
+        std::istringstream iss { oss.str() };
+        iss >> parsed;
+        REQUIRE(parsed == msvi);
+        REQUIRE(exported.size() == 2);
+        REQUIRE(exported[1].dir == instrumentation::direction::input);
+        REQUIRE(exported[1].elements[0] == 2);
+        REQUIRE(exported[1].elements[1] == 4);
+        REQUIRE(exported[1].elements[2] == 3);
+        REQUIRE(exported[1].hex_escapes_decoded == 1);
+        REQUIRE(exported[1].failed_token_probes == 0);
+
+        std::vector<int> vi;
+        std::istringstream malformed { "[1; 2]" };
+        malformed >> vi;
+        REQUIRE(malformed.fail());
+        REQUIRE(exported.size() == 3);
+        REQUIRE(exported[2].failed_token_probes == 1);
+    }
+
+    SECTION("parallel streaming exports once, on the calling thread")
+    {
+        using vvi_type = std::vector<std::vector<int>>;
+        const std::vector<int> vi (100000, 7);
+        std::ostringstream flat_oss;
+        output::to_stream_parallel(
+            flat_oss, vi,
+            output::default_formatter<std::vector<int>, std::ostringstream>{}, 4);
+        REQUIRE(exported.size() == 1);
+        REQUIRE(exported[0].bytes == flat_oss.str().size());
+        REQUIRE(exported[0].elements[0] == vi.size());
+
+        const vvi_type vvi (5000, { 1, 2, 3 });
+        std::ostringstream oss;
+        output::to_stream_parallel(
+            oss, vvi, output::default_formatter<vvi_type, std::ostringstream>{}, 4);
+        REQUIRE(exported.size() == 2);
+        REQUIRE(exported[1].bytes == oss.str().size());
+        REQUIRE(exported[1].elements[0] == 5000);
+        REQUIRE(exported[1].elements[1] == 15000);
+
+        vvi_type parsed;
+        std::istringstream iss { oss.str() };
+        input::from_stream_parallel(
+            iss, parsed, input::default_formatter<vvi_type, std::istringstream>{}, 4);
+        REQUIRE(parsed == vvi);
+        REQUIRE(exported.size() == 3);
+        REQUIRE(exported[2].dir == instrumentation::direction::input);
+        REQUIRE(exported[2].elements[0] == 5000);
+        REQUIRE(exported[2].elements[1] == 15000);
+
+        // falls back on from_stream, which counts anew
+        chunked_stringbuf buf { oss.str(), 4096 };
+        std::istream is { &buf };
+        input::from_stream_parallel(
+            is, parsed, input::default_formatter<vvi_type, std::istream>{}, 4);
+        REQUIRE(parsed == vvi);
+        REQUIRE(exported.size() == 4);
+        REQUIRE(exported[3].elements[0] == 5000);
+        REQUIRE(exported[3].elements[1] == 15000);
+    }
+
+    SECTION("incremental and lazy parsing export once per serialization")
+    {
+        using vvi_type = std::vector<std::vector<int>>;
+        const std::string serialization { "[[1, 2], [3]]" };
+
+        input::push_parser<vvi_type> parser;
+        for (const char c : serialization)
+            parser.feed(&c, 1);
+        REQUIRE(parser.container() == vvi_type { { 1, 2 }, { 3 } });
+        REQUIRE(exported.size() == 1);
+        REQUIRE(exported[0].dir == instrumentation::direction::input);
+        REQUIRE(exported[0].elements[0] == 2);
+        REQUIRE(exported[0].elements[1] == 3);
+
+        std::istringstream iss { serialization };
+        std::size_t count {};
+        for (const std::vector<int>& element : input::elements<vvi_type>(iss))
+        {
+            count += element.size();
+            // exported once iteration ends
+            REQUIRE(exported.size() == 1);
+        }
+        REQUIRE(count == 3);
+        REQUIRE(exported.size() == 2);
+        REQUIRE(exported[1].elements[0] == 2);
+        REQUIRE(exported[1].elements[1] == 3);
+
+        iss.clear();
+        iss.str(serialization);
+        structure_recorder recorder;
+        input::visit<vvi_type>(iss, recorder);
+        REQUIRE(!iss.fail());
+        REQUIRE(exported.size() == 3);
+        REQUIRE(exported[2].elements[0] == 2);
+        REQUIRE(exported[2].elements[1] == 3);
+    }
+#else
+    SECTION("hooks compile away with null_policy")
+    {
+        REQUIRE(!instrumentation::policy::enabled);
+        std::ostringstream oss;
+        oss << msvi;
+        REQUIRE(exported.empty());
+    }
+#endif  // CONTAINER_STREAM_IO_INSTRUMENTATION
+
+    instrumentation::set_sink(nullptr);
+}
+
+/**
+ * @brief recursive element type, nesting as deep as its serialization
+ */
+struct tree_node
+{
+    std::vector<tree_node> children;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const tree_node& node)
+{
+    return ostream << node.children;
+}
+
+std::istream& operator>>(std::istream& istream, tree_node& node)
+{
+    return istream >> node.children;
+}
+
+/**
+ * @brief element printing the nesting depth counted in its stream
+ */
+struct depth_probe
+{};
+
+std::ostream& operator<<(std::ostream& ostream, const depth_probe&)
+{
+    return ostream << ostream.iword(nesting::detail::get_depth_i());
+}
+
+TEST_CASE("Limiting nesting depth with nesting::maxdepth", "[input][output]")
+{
+    const auto nested = [](const std::size_t depth) {
+        return std::string(depth, '[') + std::string(depth, ']');
+    };
+
+    SECTION("parsing fails past the limit, which counts the outermost as 1")
+    {
+        tree_node root;
+        std::istringstream iss { nested(3) };
+        iss >> nesting::maxdepth(3) >> root;
+        REQUIRE(!iss.fail());
+        REQUIRE(root.children.size() == 1);
+        REQUIRE(root.children[0].children.size() == 1);
+        REQUIRE(root.children[0].children[0].children.empty());
+
+        iss.clear();
+        iss.str(nested(4));
+        iss >> root;
+        REQUIRE(iss.fail());
+
+        // depth is counted again from the top
+        iss.clear();
+        iss.str(nested(2));
+        iss >> root;
+        REQUIRE(!iss.fail());
+    }
+
+    SECTION("untrusted input fails fast instead of exhausting the stack")
+    {
+        tree_node root;
+        std::istringstream iss { nested(1000000) };
+        iss >> nesting::maxdepth(64) >> root;
+        REQUIRE(iss.fail());
+        REQUIRE(root.children.empty());
+    }
+
+    SECTION("printing fails past the limit, and 0 sets no limit")
+    {
+        const std::vector<std::vector<std::vector<int>>> vvvi { { { 1 } } };
+        std::ostringstream oss;
+        oss << nesting::maxdepth(2) << vvvi;
+        REQUIRE(oss.fail());
+
+        oss.clear();
+        oss.str("");
+        oss << nesting::maxdepth(0) << vvvi;
+        REQUIRE(!oss.fail());
+        REQUIRE(oss.str() == "[[[1]]]");
+    }
+
+    SECTION("depth is carried through nested containers, and counted in the "
+            "stream for elements of other types")
+    {
+        const std::vector<std::vector<std::vector<int>>> vvvi { { { 1 } } };
+        std::ostringstream oss;
+        oss << binary::binaryrepr << nesting::maxdepth(2) << vvvi;
+        REQUIRE(oss.fail());
+
+        oss.clear();
+        oss.str("");
+        oss << binary::textrepr << nesting::maxdepth(0);
+        const std::map<int, std::vector<depth_probe>> mivp {
+            { 1, { depth_probe {} } } };
+        oss << mivp << std::vector<std::vector<depth_probe>> { { {} } };
+        REQUIRE(oss.str() == "[(1, [3])][[2]]");
+        REQUIRE(oss.iword(nesting::detail::get_depth_i()) == 0);
+
+        std::vector<std::vector<tree_node>> vvt;
+        std::istringstream iss { "[[[[]]]]" };
+        iss >> nesting::maxdepth(3) >> vvt;
+        REQUIRE(iss.fail());
+
+        iss.clear();
+        iss.str("[[[[]]]]");
+        iss >> nesting::maxdepth(4) >> vvt;
+        REQUIRE(!iss.fail());
+        REQUIRE(vvt[0][0].children.size() == 1);
+        REQUIRE(iss.iword(nesting::detail::get_depth_i()) == 0);
+    }
+
+    SECTION("parallel streaming counts the outermost container")
+    {
+        using vvi_type = std::vector<std::vector<int>>;
+        const vvi_type vvi (5000, { 1, 2, 3 });
+        std::ostringstream oss;
+        oss << nesting::maxdepth(1);
+        output::to_stream_parallel(
+            oss, vvi, output::default_formatter<vvi_type, std::ostringstream>{}, 4);
+        REQUIRE(oss.fail());
+
+        oss.clear();
+        oss.str("");
+        oss << nesting::maxdepth(2);
+        output::to_stream_parallel(
+            oss, vvi, output::default_formatter<vvi_type, std::ostringstream>{}, 4);
+        REQUIRE(!oss.fail());
+
+        vvi_type parsed;
+        std::istringstream iss { oss.str() };
+        iss >> nesting::maxdepth(1);
+        input::from_stream_parallel(
+            iss, parsed, input::default_formatter<vvi_type, std::istringstream>{}, 4);
+        REQUIRE(iss.fail());
+        REQUIRE(parsed.empty());
+
+        iss.clear();
+        iss.seekg(0);
+        iss >> nesting::maxdepth(2);
+        input::from_stream_parallel(
+            iss, parsed, input::default_formatter<vvi_type, std::istringstream>{}, 4);
+        REQUIRE(!iss.fail());
+        REQUIRE(parsed == vvi);
+    }
+
+    SECTION("lazy and incremental parsing count the outermost container")
+    {
+        std::istringstream format_source;
+        format_source >> nesting::maxdepth(1);
+        input::push_parser<std::vector<std::vector<int>>> parser { format_source };
+        const std::string serialization { "[[1], [2]]" };
+        REQUIRE(parser.feed(serialization.data(), serialization.size()) ==
+                input::push_parser<std::vector<std::vector<int>>>::status::error);
+
+        std::istringstream iss { serialization };
+        iss >> nesting::maxdepth(1);
+        std::size_t count {};
+        for (const std::vector<int>& element :
+                 input::elements<std::vector<std::vector<int>>>(iss))
+            count += element.size();
+        REQUIRE(count == 0);
+        REQUIRE(iss.fail());
+
+        iss.clear();
+        iss.str(serialization);
+        structure_recorder recorder;
+        input::visit<std::vector<std::vector<int>>>(iss, recorder);
+        REQUIRE(iss.fail());
+        REQUIRE(recorder.record.str() == "<");
+
+        iss.clear();
+        iss.str(serialization);
+        structure_recorder unlimited_recorder;
+        input::visit<std::vector<std::vector<int>>>(
+            iss >> nesting::maxdepth(2), unlimited_recorder);
+        REQUIRE(!iss.fail());
+        REQUIRE(unlimited_recorder.record.str() == "<<1 ><2 >>");
+    }
+}
+
+/**
+ * @brief parses serialization through streambufs of chunk_size chars into
+ *   a std::vector, whose numeric elements are parsed in bulk, and a
+ *   std::deque, whose elements are parsed one at a time, requiring the same
+ *   elements and stream state
+ */
+template <typename ElementType>
+static void check_parse_numbers(const std::string& serialization,
+                                const std::size_t chunk_size,
+                                const bool c_locale)
+{
+    chunked_stringbuf vector_buf { serialization, chunk_size };
+    chunked_stringbuf deque_buf { serialization, chunk_size };
+    std::istream vector_is { &vector_buf };
+    std::istream deque_is { &deque_buf };
+    if (c_locale)
+    {
+        vector_is >> numeric::clocalerepr;
+        deque_is >> numeric::clocalerepr;
+    }
+    std::vector<ElementType> v;
+    std::deque<ElementType> d;
+    vector_is >> v;
+    deque_is >> d;
+    INFO(serialization);
+    REQUIRE(vector_is.rdstate() == deque_is.rdstate());
+    REQUIRE(v.size() == d.size());
+    REQUIRE(std::equal(v.begin(), v.end(), d.begin()));
+}
+
+template <typename ElementType>
+static void check_parse_numbers(const std::vector<std::string>& serializations)
+{
+    for (const std::string& serialization : serializations)
+    {
+        for (const std::size_t chunk_size : { 1, 3, 7, 4096 })
+        {
+            check_parse_numbers<ElementType>(serialization, chunk_size, false);
+            check_parse_numbers<ElementType>(serialization, chunk_size, true);
+        }
+    }
+}
+
+TEST_CASE("Parsing numeric elements of contiguous containers in bulk",
+          "[input]")
+{
+    SECTION("find_non_digit finds the end of digit runs")
+    {
+        using strings::detail::simd::find_non_digit;
+        // longer than a vector of chars, to cover vector and scalar paths
+        for (std::size_t length { 0 }; length < 40; ++length)
+        {
+            const std::string digits (length, '7');
+            REQUIRE(find_non_digit(digits.data(), digits.data() + length) ==
+                    digits.data() + length);
+            for (std::size_t offset { 0 }; offset < length; ++offset)
+            {
+                for (const char c : { '/', ':', ' ', '-', '\x80' })
+                {
+                    std::string str (digits);
+                    str[offset] = c;
+                    REQUIRE(find_non_digit(str.data(), str.data() + length) ==
+                            str.data() + offset);
+                }
+            }
+        }
+    }
+
+    SECTION("decode_digits decodes up to 19 digits")
+    {
+        using numeric::detail::decode_digits;
+        const std::string digits { "1234567890123456789" };
+        uint64_t expected {};
+        for (std::size_t length { 0 }; length <= digits.size(); ++length)
+        {
+            REQUIRE(decode_digits(digits.data(), length) == expected);
+            if (length < digits.size())
+                expected = expected * 10 + uint64_t(digits[length] - '0');
+        }
+        REQUIRE(decode_digits("18446744073709551615", 19) ==
+                1844674407370955161ULL);
+    }
+
+    SECTION("integers parse as element by element")
+    {
+        check_parse_numbers<int>({
+            "[1, -2, 3]", "[ 1 ,2,\n3 ]", "[1,2,3]", "[0, -0, 007]",
+            "[2147483647, -2147483648]", "[2147483648]", "[-2147483649]",
+            "[12345678901234567890]", "[+1, 2]", "[1, 2x]", "[1.5, 2]",
+            "[1e3]", "[0x10]", "[1; 2]", "[1,, 2]", "[-, 1]", "[1, 2",
+            "[1, 2 ", "[1 2]", "[]", "[1, ]" });
+        check_parse_numbers<unsigned>({
+            "[0, 4294967295]", "[4294967296]", "[-1, 2]" });
+        check_parse_numbers<short>({
+            "[32767, -32768]", "[32768]", "[-32769]" });
+        check_parse_numbers<long long>({
+            "[9223372036854775807, -9223372036854775808]",
+            "[9223372036854775808]", "[-9223372036854775809]" });
+        check_parse_numbers<unsigned long long>({
+            "[18446744073709551615]", "[18446744073709551616]" });
+    }
+
+#ifdef CONTAINER_STREAM_IO_CHARCONV
+    SECTION("floating point numbers parse as element by element")
+    {
+        check_parse_numbers<double>({
+            "[1.5, -2.25e-3, 3E+5, 0.1]", "[-0.0, 0]", "[1e308, 1e309]",
+            "[1e-400, 4.9e-324]", "[.5]", "[1.]", "[1e]", "[inf, 2]",
+            "[+1.5]", "[0x1p3]", "[1.5f]" });
+        check_parse_numbers<float>({
+            "[1.5, 3.4028235e38, 3.5e38]", "[0.1, 1e-50]" });
+    }
+#endif  // CONTAINER_STREAM_IO_CHARCONV
+
+    SECTION("across windows, as element by element")
+    {
+        std::ostringstream oss;
+        oss << '[';
+        uint32_t x { 12345 };
+        for (int i { 0 }; i < 5000; ++i)
+        {
+            x = x * 1103515245 + 12345;
+            oss << (i == 0 ? "" : ", ") << (static_cast<int32_t>(x) >> (x % 24));
+        }
+        oss << ']';
+        for (const std::size_t chunk_size : { 5, 64, 1000, 100000 })
+            check_parse_numbers<int32_t>(oss.str(), chunk_size, false);
+    }
+
+    SECTION("only in bulk where numbers parse as in the C locale")
+    {
+        std::istringstream iss { "[10, ff]" };
+        std::vector<int> vi;
+        iss >> std::hex >> vi;
+        REQUIRE(!iss.fail());
+        REQUIRE(vi == std::vector<int> { 16, 255 });
+    }
+
+    SECTION("into arrays, of exactly their size")
+    {
+        std::array<int, 3> ai {};
+        std::istringstream iss { "[1, 2, 3]" };
+        iss >> ai;
+        REQUIRE(!iss.fail());
+        REQUIRE(ai == std::array<int, 3> { { 1, 2, 3 } });
+
+        int ca[3] {};
+        for (const std::string serialization : { "[1, 2]", "[1, 2, 3, 4]" })
+        {
+            std::istringstream short_or_long { serialization };
+            short_or_long >> ca;
+            REQUIRE(short_or_long.fail());
+        }
+        chunked_stringbuf buf { "[4,5 , 6]", 3 };
+        std::istream is { &buf };
+        is >> ca;
+        REQUIRE(!is.fail());
+        REQUIRE(ca[0] == 4);
+        REQUIRE(ca[1] == 5);
+        REQUIRE(ca[2] == 6);
+    }
+}
+
+#ifdef CONTAINER_STREAM_IO_CHARCONV
+TEST_CASE("Streaming numbers with numeric::clocalerepr", "[input][output]")
+{
+    const std::vector<double> vd {
+        0.1, 1.0 / 3, -0.0, 1e300, 5e-324, -123456789.125 };
+
+    SECTION("round trips floating point values exactly")
+    {
+        std::stringstream ss;
+        ss << numeric::clocalerepr << vd;
+        REQUIRE(ss.str() == "[0.1, 0.3333333333333333, -0, 1e+300, 5e-324, "
+                "-123456789.125]");
+        std::vector<double> parsed;
+        ss >> numeric::clocalerepr >> parsed;
+        REQUIRE(!ss.fail());
+        REQUIRE(parsed == vd);
+        REQUIRE(std::signbit(parsed[2]));
+    }
+
+    SECTION("round trips integer values of all widths")
+    {
+        const std::map<std::uint64_t, std::int64_t> mi {
+            { 0, std::numeric_limits<std::int64_t>::min() },
+            { std::numeric_limits<std::uint64_t>::max(), -1 } };
+        std::stringstream ss;
+        ss << numeric::clocalerepr << mi;
+        REQUIRE(ss.str() == "[(0, -9223372036854775808), "
+                "(18446744073709551615, -1)]");
+        std::map<std::uint64_t, std::int64_t> parsed;
+        ss >> numeric::clocalerepr >> parsed;
+        REQUIRE(!ss.fail());
+        REQUIRE(parsed == mi);
+    }
+
+    SECTION("ignores stream locale and number format flags")
+    {
+        std::ostringstream oss;
+        oss << numeric::clocalerepr << std::fixed << std::setprecision(2)
+            << std::showpos << std::vector<float> { 0.125f, -2.f };
+        REQUIRE(oss.str() == "[0.125, -2]");
+
+        oss.str("");
+        oss << numeric::localerepr << std::vector<float> { 0.125f };
+        REQUIRE(oss.str() == "[+0.12]");
+    }
+
+    SECTION("keeps chars and bools streamed as before")
+    {
+        std::ostringstream oss;
+        oss << numeric::clocalerepr << std::boolalpha
+            << std::tuple<bool, char, unsigned char> { true, 'a', 'b' };
+        REQUIRE(oss.str() == "<true, 'a', b>");
+    }
+
+    SECTION("streams with wide chars")
+    {
+        std::wstringstream wss;
+        wss << numeric::clocalerepr << std::vector<double> { 1.5, -2 };
+        REQUIRE(wss.str() == L"[1.5, -2]");
+        std::vector<double> parsed;
+        wss >> numeric::clocalerepr >> parsed;
+        REQUIRE(!wss.fail());
+        REQUIRE(parsed == std::vector<double> { 1.5, -2 });
+    }
+
+    SECTION("parses numbers split between streambuf refills")
+    {
+        std::ostringstream oss;
+        oss << numeric::clocalerepr << vd;
+        for (std::size_t chunk_size { 1 }; chunk_size < 8; ++chunk_size)
+        {
+            chunked_stringbuf buf { oss.str(), chunk_size };
+            std::istream is { &buf };
+            std::vector<double> parsed;
+            is >> numeric::clocalerepr >> parsed;
+            REQUIRE(!is.fail());
+            REQUIRE(parsed == vd);
+        }
+    }
+
+    SECTION("fails on malformed or out of range numbers")
+    {
+        for (const std::string serialization :
+                 { "[1, +2]", "[1, x]", "[1, ]", "[40000]", "[1.5]", "[1e]" })
+        {
+            std::istringstream iss { serialization };
+            std::vector<std::int16_t> parsed { 7 };
+            iss >> numeric::clocalerepr >> parsed;
+            REQUIRE(iss.fail());
+            REQUIRE(parsed == std::vector<std::int16_t> { 7 });
+        }
+    }
+
+    SECTION("is captured in format state")
+    {
+        std::ostringstream oss;
+        REQUIRE(!format_state::capture(oss).c_locale_numbers);
+        oss << numeric::clocalerepr;
+        REQUIRE(format_state::capture(oss).c_locale_numbers);
+    }
+}
+#endif  // CONTAINER_STREAM_IO_CHARCONV
+
+// sets strings::quotedrepr on the stream it is streamed with
+struct repr_switch
+{};
+
+std::ostream& operator<<(std::ostream& os, const repr_switch& /*rs*/)
+{
+    return os << strings::quotedrepr << 's';
+}
+
+std::istream& operator>>(std::istream& is, repr_switch& /*rs*/)
+{
+    char c {};
+    if (is >> strings::quotedrepr >> c && c != 's')
+        is.setstate(std::ios_base::failbit);
+    return is;
+}
+
+TEST_CASE("Streaming with format state captured by default formatters",
+          "[input][output]")
+{
+    const std::vector<std::vector<std::string>> vvs { { "a\tb" }, {} };
+
+    SECTION("reads format state from the stream")
+    {
+        std::ostringstream oss;
+        REQUIRE(format_state::capture(oss).repr ==
+                strings::detail::repr_type::literal);
+        REQUIRE(!format_state::capture(oss).count_hints);
+        oss << strings::quotedrepr << decorator::counthint;
+        REQUIRE(format_state::capture(oss).repr ==
+                strings::detail::repr_type::quoted);
+        REQUIRE(format_state::capture(oss).count_hints);
+    }
+
+    SECTION("uses format state passed to the formatter for nested containers")
+    {
+        format_state state;
+        state.repr = strings::detail::repr_type::quoted;
+        state.count_hints = true;
+        using output_formatter_type =
+            output::default_formatter<decltype(vvs), std::ostream>;
+        std::ostringstream oss;
+        output::to_stream(oss, vvs, output_formatter_type { state });
+        REQUIRE(oss.str() == "[#2: [#1: \"a\tb\"], []]");
+
+        using input_formatter_type =
+            input::default_formatter<std::vector<std::vector<std::string>>,
+                                     std::istream>;
+        std::istringstream iss { oss.str() };
+        std::vector<std::vector<std::string>> parsed;
+        input::from_stream(iss, parsed, input_formatter_type { state });
+        REQUIRE(!iss.fail());
+        REQUIRE(parsed == vvs);
+    }
+
+    SECTION("reads format state once per top-level call")
+    {
+        const std::vector<std::pair<repr_switch, std::vector<std::string>>> vpv {
+            { {}, { "a\tb" } }, { {}, { "a\tb" } } };
+        std::ostringstream oss;
+        oss << vpv;
+        REQUIRE(oss.str() == "[(s, [\"a\\tb\"]), (s, [\"a\\tb\"])]");
+        oss.str("");
+        oss << vvs;
+        REQUIRE(oss.str() == "[[\"a\tb\"], []]");
+
+        std::istringstream iss { "[(s, [\"a\\tb\"]), (s, [\"a\\tb\"])]" };
+        std::vector<std::pair<repr_switch, std::vector<std::string>>> parsed;
+        iss >> parsed;
+        REQUIRE(!iss.fail());
+        REQUIRE(parsed.size() == 2);
+        REQUIRE(parsed[1].second == std::vector<std::string> { "a\tb" });
+    }
+}
+
+enum class binary_test_enum : std::uint16_t { first = 1, second = 0x1234 };
+
+struct binary_test_raw
+{
+    std::int32_t x;
+    float y;
+};
+
+template <typename ContainerType>
+ContainerType binary_round_trip(const ContainerType& container)
+{
+    std::stringstream ss;
+    output::to_stream(ss, container,
+                      output::binary_formatter<ContainerType, std::ostream>{});
+    ContainerType parsed {};
+    input::from_stream(ss, parsed,
+                       input::binary_formatter<ContainerType, std::istream>{});
+    REQUIRE(!ss.fail());
+    REQUIRE(ss.peek() == std::char_traits<char>::eof());
+    return parsed;
+}
+
+TEST_CASE("Streaming with binary::binaryrepr/binary formatters",
+          "[input][output][binary]")
+{
+    SECTION("round trips containers of values, strings and containers")
+    {
+        std::vector<double> vd;
+        for (int i {}; i < 20000; ++i)
+            vd.push_back(i * 0.125 - 7);
+        REQUIRE(binary_round_trip(vd) == vd);
+        REQUIRE(binary_round_trip(std::vector<double> {}).empty());
+
+        const std::array<std::int64_t, 3> ai { -1, 0, 1LL << 40 };
+        REQUIRE(binary_round_trip(ai) == ai);
+
+        const std::map<std::string, std::vector<int>> msvi {
+            { "", {} }, { "a", { 1 } }, { std::string(100000, 'b'), { 2, 3 } } };
+        REQUIRE(binary_round_trip(msvi) == msvi);
+
+        const std::pair<int, std::string> pis { -5, "five" };
+        REQUIRE(binary_round_trip(pis) == pis);
+        const std::tuple<char, bool, std::list<short>> tcbl {
+            'c', true, { 1, -1 } };
+        REQUIRE(binary_round_trip(tcbl) == tcbl);
+
+        const std::forward_list<std::set<unsigned>> flsu { { 1, 2 }, {}, { 3 } };
+        REQUIRE(binary_round_trip(flsu) == flsu);
+
+        const std::vector<bool> vb { true, false, true };
+        REQUIRE(binary_round_trip(vb) == vb);
+
+        const std::deque<binary_test_enum> de {
+            binary_test_enum::first, binary_test_enum::second };
+        REQUIRE((binary_round_trip(de) == de));
+
+        const std::vector<binary_test_raw> vr { { 1, 0.5f }, { -2, 4.f } };
+        const std::vector<binary_test_raw> parsed { binary_round_trip(vr) };
+        REQUIRE(parsed.size() == 2);
+        REQUIRE((parsed[1].x == -2 && parsed[1].y == 4.f));
+    }
+
+    SECTION("round trips C arrays")
+    {
+        const int ai[3] { 7, 8, 9 };
+        std::stringstream ss;
+        output::to_stream(ss, ai,
+                          output::binary_formatter<int[3], std::ostream>{});
+        int parsed[3] {};
+        input::from_stream(ss, parsed,
+                           input::binary_formatter<int[3], std::istream>{});
+        REQUIRE(!ss.fail());
+        REQUIRE(std::equal(std::begin(ai), std::end(ai), std::begin(parsed)));
+    }
+
+    SECTION("encodes counts and values as fixed width little-endian")
+    {
+        std::ostringstream oss;
+        oss << binary::binaryrepr << std::vector<std::uint16_t> { 0x0102 }
+            << std::string("ab");
+        REQUIRE(oss.str() == std::string(
+                    "\x01\0\0\0\0\0\0\0\x02\x01" "ab", 12));
+        oss << binary::textrepr;
+        oss.str("");
+        oss << std::vector<int> { 1 };
+        REQUIRE(oss.str() == "[1]");
+    }
+
+    SECTION("writes C strings as strings, and fails on other pointers")
+    {
+        const std::vector<const char*> vcs { "hello", "world" };
+        std::stringstream ss;
+        ss << binary::binaryrepr << vcs;
+        REQUIRE(!ss.fail());
+        std::ostringstream expected;
+        expected << binary::binaryrepr
+                 << std::vector<std::string> { "hello", "world" };
+        REQUIRE(ss.str() == expected.str());
+        std::vector<std::string> parsed;
+        ss >> binary::binaryrepr >> parsed;
+        REQUIRE(!ss.fail());
+        REQUIRE(parsed == std::vector<std::string> { "hello", "world" });
+
+        std::ostringstream null_oss;
+        null_oss << binary::binaryrepr << std::vector<const char*> { nullptr };
+        REQUIRE(null_oss.fail());
+
+        int i {};
+        const std::vector<int*> vpi { &i };
+        std::ostringstream oss;
+        oss << binary::binaryrepr << vpi;
+        REQUIRE(oss.fail());
+        REQUIRE(!binary::detail::is_raw<int*>::value);
+        REQUIRE(!binary::detail::is_raw<int binary_test_raw::*>::value);
+
+        std::istringstream iss { expected.str() };
+        std::vector<const char*> parsed_vcs;
+        input::from_stream(
+            iss, parsed_vcs,
+            input::binary_formatter<std::vector<const char*>, std::istream>{});
+        REQUIRE(iss.fail());
+    }
+
+    SECTION("selects the formatter with stream operators")
+    {
+        const std::unordered_map<int, std::vector<std::string>> umivs {
+            { 1, { "one", "\"uno\"" } }, { 2, {} } };
+        std::stringstream ss;
+        ss << binary::binaryrepr << umivs;
+        std::unordered_map<int, std::vector<std::string>> parsed;
+        ss >> binary::binaryrepr >> parsed;
+        REQUIRE(!ss.fail());
+        REQUIRE(parsed == umivs);
+
+        // wide streams always use text
+        std::wostringstream woss;
+        woss << binary::binaryrepr << std::vector<int> { 1, 2 };
+        REQUIRE(woss.str() == L"[1, 2]");
+    }
+
+    SECTION("leaves text output of empty containers unchanged")
+    {
+        std::ostringstream oss;
+        oss << decorator::counthint << std::vector<std::vector<int>> { {}, { 1 } };
+        REQUIRE(oss.str() == "[#2: [], [#1: 1]]");
+    }
+
+    SECTION("fails on truncated or corrupt input")
+    {
+        const std::vector<std::string> vs { "first", "second" };
+        std::ostringstream oss;
+        oss << binary::binaryrepr << vs;
+        const std::string serialization { oss.str() };
+        for (std::size_t size {}; size < serialization.size(); ++size)
+        {
+            std::istringstream iss { serialization.substr(0, size) };
+            std::vector<std::string> parsed { "unchanged" };
+            iss >> binary::binaryrepr >> parsed;
+            REQUIRE(iss.fail());
+            REQUIRE(parsed == std::vector<std::string> { "unchanged" });
+        }
+
+        // counts beyond the stream contents are not allocated up front
+        std::istringstream iss { std::string("\xff\xff\xff\xff\xff\xff\xff\x0f"
+                                             "\0\0\0\0", 12) };
+        std::vector<double> vd;
+        iss >> binary::binaryrepr >> vd;
+        REQUIRE(iss.fail());
+        REQUIRE(vd.empty());
+
+        std::istringstream bad_bool { std::string("\x01\0\0\0\0\0\0\0\x02", 9) };
+        std::vector<bool> vb;
+        bad_bool >> binary::binaryrepr >> vb;
+        REQUIRE(bad_bool.fail());
+
+        std::array<int, 2> ai {};
+        std::istringstream bad_size { std::string("\x03\0\0\0\0\0\0\0", 8) };
+        bad_size >> binary::binaryrepr >> ai;
+        REQUIRE(bad_size.fail());
+    }
+
+    SECTION("streams binary through files")
+    {
+        const std::string path { "container_stream_io_test_file.bin" };
+        std::map<int, std::vector<double>> mivd;
+        for (int i {}; i < 1000; ++i)
+            mivd.emplace(i, std::vector<double>(i % 7, i * 0.5));
+        using map_type = decltype(mivd);
+        REQUIRE(output::to_file(
+                    path, mivd, output::binary_formatter<map_type, std::ostream>{}));
+        map_type parsed;
+        REQUIRE(input::from_file(
+                    path, parsed, input::binary_formatter<map_type, std::istream>{}));
+        REQUIRE(parsed == mivd);
+        std::remove(path.c_str());
+    }
+}
+
+#if (__cplusplus >= 201703L)
+TEST_CASE("Parsing std::basic_string_view elements with strings::viewarena",
+          "[input][strings]")
+{
+    const std::string serialization {
+        "[(\"plain\", 1), (\"esc\\\"aped\", 2), (\"\", 3)]" };
+    const std::vector<std::pair<std::string_view, int>> expected {
+        { "plain", 1 }, { "esc\"aped", 2 }, { "", 3 } };
+    const char* const first { serialization.data() };
+    const char* const last { first + serialization.size() };
+    const auto views_source = [&](const std::string_view sv) {
+        return sv.data() >= first && sv.data() + sv.size() <= last;
+    };
+
+    SECTION("views unescaped strings in stable sources, storing the rest")
+    {
+        buffers::span_streambuf<char> buf { first, last };
+        std::istream is { &buf };
+        strings::view_arena<char> arena;
+        std::vector<std::pair<std::string_view, int>> vpsvi;
+        is >> strings::viewarena(arena) >> vpsvi;
+        REQUIRE(!is.fail());
+        REQUIRE(vpsvi == expected);
+        REQUIRE(views_source(vpsvi[0].first));
+        REQUIRE(!views_source(vpsvi[1].first));
+    }
+
+    SECTION("stores all strings when the source is not stable")
+    {
+        strings::view_arena<char> arena;
+        std::vector<std::pair<std::string_view, int>> vpsvi;
+        {
+            std::istringstream iss { serialization };
+            iss >> strings::viewarena(arena) >> vpsvi;
+            REQUIRE(!iss.fail());
+        }
+        REQUIRE(vpsvi == expected);
+
+        buffers::span_streambuf<char> buf { first, last, false };
+        std::istream is { &buf };
+        is >> strings::viewarena(arena) >> vpsvi;
+        REQUIRE(vpsvi == expected);
+        REQUIRE(!views_source(vpsvi[0].first));
+    }
+
+    SECTION("fails without an arena unless strings can be viewed")
+    {
+        buffers::span_streambuf<char> buf { first, last };
+        std::istream is { &buf };
+        std::vector<std::pair<std::string_view, int>> vpsvi;
+        is >> vpsvi;
+        REQUIRE(is.fail());
+        REQUIRE(vpsvi.empty());
+
+        const std::string plain { "{\"a\", \"b\"}" };
+        buffers::span_streambuf<char> plain_buf {
+            plain.data(), plain.data() + plain.size() };
+        std::istream plain_is { &plain_buf };
+        std::set<std::string_view> ssv;
+        plain_is >> ssv;
+        REQUIRE(!plain_is.fail());
+        REQUIRE(ssv == std::set<std::string_view> { "a", "b" });
+    }
+
+    SECTION("decodes other char types and representations into the arena")
+    {
+        strings::view_arena<char16_t> arena;
+        std::istringstream iss { "[u\"a\\x0062\", u\"\"]" };
+        std::vector<std::u16string_view> vu16sv;
+        iss >> strings::viewarena(arena) >> vu16sv;
+        REQUIRE(!iss.fail());
+        REQUIRE(vu16sv == std::vector<std::u16string_view> { u"ab", u"" });
+
+        std::string_view sv;
+        std::istringstream quoted_iss { "'q\\'d'" };
+        strings::view_arena<char> char_arena;
+        quoted_iss >> strings::viewarena(char_arena)
+                   >> strings::quoted(sv, '\'');
+        REQUIRE(sv == "q'd");
+    }
+
+    SECTION("views strings parsed in parallel from stable sources")
+    {
+        std::vector<std::string> vs (10000);
+        for (std::size_t i {}; i < vs.size(); ++i)
+            vs[i] = (i % 2 ? "odd \"" : "even ") + std::to_string(i);
+        std::ostringstream oss;
+        oss << vs;
+        const std::string big { oss.str() };
+        buffers::span_streambuf<char> buf { big.data(), big.data() + big.size() };
+        std::istream is { &buf };
+        strings::view_arena<char> arena;
+        is >> strings::viewarena(arena);
+        std::vector<std::string_view> vsv;
+        REQUIRE(input::extract_container_parallel(
+                    is, vsv, input::default_formatter<std::vector<std::string_view>,
+                                                      std::istream>{}, 4));
+        REQUIRE(std::equal(vs.begin(), vs.end(), vsv.begin(), vsv.end()));
+        REQUIRE(vsv[0].data() > big.data());
+        REQUIRE(vsv[0].data() < big.data() + big.size());
+    }
+
+    SECTION("views strings of files only while they are open")
+    {
+        const std::string path { "container_stream_io_views_file.txt" };
+        const std::vector<std::string> vs { "plain", "strings" };
+        REQUIRE(output::to_file(path, vs));
+
+        // file closed on return, so views would dangle
+        std::vector<std::string_view> vsv;
+        REQUIRE(!input::from_file(path, vsv));
+        REQUIRE(vsv.empty());
+
+        {
+            const buffers::mapped_file file { path };
+            REQUIRE(input::from_file(file, vsv));
+            std::ostringstream oss;
+            oss << vsv;
+            REQUIRE(oss.str() == "[\"plain\", \"strings\"]");
+            REQUIRE(vsv[0].data() >= file.data());
+            REQUIRE(vsv[1].data() < file.data() + file.size());
+        }
+        std::remove(path.c_str());
+    }
+}
+
+#endif  // C++17
 TEST_CASE("Exploring edge cases for nested containers",
           "[output][input]")
 {